@@ -0,0 +1,118 @@
+// Microbenchmark cho frontend: sinh một module MeowScript lớn (nhiều hàm, class, vòng lặp, object...)
+// rồi đo thời gian lexer, parser, giải phóng AST và lượng RSS mà cây AST chiếm, cùng thời gian
+// parse kéo token trực tiếp từ Lexer (không dựng vector token).
+// Build: cmake -DMEOW_BUILD_BENCHMARKS=ON, chạy bin/meow-parse-bench [số hàm]
+
+#include "common/ast.hpp"
+#include "common/source_file.hpp"
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// VmRSS hiện tại của tiến trình, theo KB
+long residentKilobytes() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    return 0;
+}
+
+std::string syntheticModule(int functions) {
+    std::ostringstream os;
+    for (int i = 0; i < functions; ++i) {
+        os << "fn work" << i << "(a, b, ...rest) {\n"
+           << "    let total = a * " << i << " + b - (a % 7);\n"
+           << "    let items = [a, b, " << i << ", \"item" << i << "\", true, null];\n"
+           << "    let info = { name: \"work" << i << "\", size: len(items), nested: { depth: " << i % 5 << " } };\n"
+           << "    for (let j = 0; j < len(items); ++j) {\n"
+           << "        if (j % 2 == 0 && total > 10 || !b) {\n"
+           << "            total += j;\n"
+           << "        } else {\n"
+           << "            total = total - items[0] ?? 0;\n"
+           << "        }\n"
+           << "    }\n"
+           << "    while (total > 1000) { total = total / 2; }\n"
+           << "    return info.size > 3 ? `work%{total}` : total;\n"
+           << "}\n";
+        if (i % 10 == 0) {
+            os << "class Shape" << i << " {\n"
+               << "    fn init(w, h) { this.w = w; this.h = h; }\n"
+               << "    fn area() { return this.w * this.h; }\n"
+               << "}\n";
+        }
+    }
+    return os.str();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int functions = argc > 1 ? std::stoi(argv[1]) : 20000;
+    constexpr int rounds = 5;
+
+    std::string source = syntheticModule(functions);
+    auto srcFile = std::make_shared<SourceFile>(source, "[parse-bench]");
+
+    double lexMs = 1e300;
+    double parseMs = 1e300;
+    double freeMs = 1e300;
+    double streamMs = 1e300;
+    size_t tokenBytes = 0;
+    long astKilobytes = 0;
+    size_t arenaBytes = 0;
+
+    for (int round = 0; round < rounds; ++round) {
+        auto start = Clock::now();
+        Lexer lexer(srcFile);
+        std::vector<Token> tokens = lexer.tokenize();
+        lexMs = std::min(lexMs, millisecondsSince(start));
+        tokenBytes = tokens.capacity() * sizeof(Token);
+
+        long before = residentKilobytes();
+        start = Clock::now();
+        Parser parser(tokens);
+        std::unique_ptr<Program> program = parser.parseProgram();
+        parseMs = std::min(parseMs, millisecondsSince(start));
+        astKilobytes = std::max(astKilobytes, residentKilobytes() - before);
+        arenaBytes = program->arena.reservedBytes();
+
+        start = Clock::now();
+        program.reset();
+        freeMs = std::min(freeMs, millisecondsSince(start));
+        tokens = {};
+
+        start = Clock::now();
+        Parser streaming(srcFile);
+        program = streaming.parseProgram();
+        streamMs = std::min(streamMs, millisecondsSince(start));
+        program.reset();
+    }
+
+    std::cout << "module: " << functions << " hàm, " << source.size() / 1024 << " KB mã nguồn\n"
+              << "lexer = " << lexMs << " ms (" << source.size() / (1024.0 * 1024.0) / (lexMs / 1000.0) << " MB/s), parser = "
+              << parseMs << " ms, giải phóng AST = " << freeMs << " ms\n"
+              << "RSS tăng thêm khi parse = " << astKilobytes / 1024.0 << " MB, arena AST = "
+              << arenaBytes / (1024.0 * 1024.0) << " MB\n"
+              << "lexer + parser kéo token = " << streamMs << " ms, không cần vector token "
+              << tokenBytes / (1024.0 * 1024.0) << " MB\n";
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Microbenchmark cho các backend: chạy từng script trong benchmarks/scripts (vòng lặp theo khuôn
+// tests/for_loop.meow, và đệ quy) trên tree-walker, tree-walker --jit, closure và VM rồi in thời gian.
+// Build: cmake -DMEOW_BUILD_BENCHMARKS=ON, chạy bin/meow-script-bench [thư mục script]
+
+#include "diagnostics/diagnostic.hpp"
+#include "module/module_manager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+double runScript(const std::string& path, std::vector<std::string> flags) {
+    std::string program = "meow-script-bench";
+    std::string script = path;
+    std::vector<char*> argv = {program.data()};
+    for (auto& flag : flags) {
+        argv.push_back(flag.data());
+    }
+    argv.push_back(script.data());
+
+    ModuleManager manager(static_cast<int>(argv.size()), argv.data());
+    auto start = std::chrono::steady_clock::now();
+    try {
+        manager.load("", path);
+    } catch (const Diagnostic& e) {
+        std::cerr << e.str() << "\n";
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    fs::path directory = argc > 1 ? fs::path(argv[1]) : fs::path(MEOW_BENCH_SCRIPTS);
+
+    std::vector<fs::path> scripts;
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        if (entry.path().extension() == ".meow") {
+            scripts.push_back(entry.path());
+        }
+    }
+    std::sort(scripts.begin(), scripts.end());
+
+    for (const auto& script : scripts) {
+        std::string path = script.string();
+        double treeMs = runScript(path, {"--backend=tree"});
+        double jitMs = runScript(path, {"--backend=tree", "--jit"});
+        double closureMs = runScript(path, {"--backend=closure"});
+        double vmMs = runScript(path, {"--backend=vm"});
+        std::cout << script.filename().string() << ": tree-walker = " << treeMs << " ms"
+                  << ", jit = " << jitMs << " ms"
+                  << ", closure = " << closureMs << " ms"
+                  << ", vm = " << vmMs << " ms\n";
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Microbenchmark so sánh chi phí sao chép và dispatch của Value
+// với cách biểu diễn cũ (mọi kiểu heap đều là std::shared_ptr).
+// Build: cmake -DMEOW_BUILD_BENCHMARKS=ON, chạy bin/meow-value-bench
+
+#include "runtime/value.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <variant>
+#include <vector>
+
+namespace {
+
+// Bố cục cũ: cùng số alternative và cùng thứ tự, nhưng con trỏ là shared_ptr (16 byte + control block)
+struct LegacyString { std::string str; };
+struct LegacyArray { std::vector<int> elements; };
+struct LegacyObject {};
+struct LegacyFunction {};
+struct LegacyClass {};
+struct LegacyInstance {};
+struct LegacyBoundMethod {};
+
+using LegacyValue = std::variant<
+    Null, Int, Real, Bool,
+    std::shared_ptr<LegacyString>, std::shared_ptr<LegacyArray>, std::shared_ptr<LegacyObject>,
+    std::shared_ptr<LegacyFunction>, std::shared_ptr<LegacyClass>, std::shared_ptr<LegacyInstance>,
+    std::shared_ptr<LegacyBoundMethod>
+>;
+
+constexpr size_t valueCount = 1 << 16;
+constexpr int rounds = 200;
+
+template <typename Fn>
+double measureMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Trộn số nguyên, số thực và mảng như một stack VM điển hình
+template <typename V, typename MakeArray>
+std::vector<V> makeValues(MakeArray&& makeArray) {
+    std::vector<V> values;
+    values.reserve(valueCount);
+    auto sharedArray = makeArray();
+    for (size_t i = 0; i < valueCount; ++i) {
+        switch (i % 3) {
+            case 0: values.emplace_back(static_cast<Int>(i)); break;
+            case 1: values.emplace_back(static_cast<Real>(i) * 0.5); break;
+            default: values.emplace_back(sharedArray); break;
+        }
+    }
+    return values;
+}
+
+template <typename V>
+double benchCopy(const std::vector<V>& values) {
+    size_t sink = 0;
+    double ms = measureMs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            std::vector<V> copy = values;
+            sink += copy.size();
+        }
+    });
+    if (sink == 0) std::cout << "";
+    return ms;
+}
+
+template <typename V, typename Base>
+double benchDispatch(const std::vector<V>& values) {
+    Real total = 0;
+    double ms = measureMs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& value : values) {
+                total += std::visit([](const auto& arg) -> Real {
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (std::is_same_v<T, Int> || std::is_same_v<T, Real>) {
+                        return static_cast<Real>(arg);
+                    } else {
+                        return 1.0;
+                    }
+                }, static_cast<const Base&>(value));
+            }
+        }
+    });
+    if (total < 0) std::cout << total;
+    return ms;
+}
+
+void report(const char* name, size_t size, double copyMs, double dispatchMs) {
+    std::cout << name << ": sizeof = " << size << " byte"
+              << ", sao chép = " << copyMs << " ms"
+              << ", dispatch = " << dispatchMs << " ms\n";
+}
+
+}
+
+int main() {
+    auto legacyValues = makeValues<LegacyValue>([] { return std::make_shared<LegacyArray>(); });
+    auto values = makeValues<Value>([] { return makeRef<ArrayData>(); });
+
+    std::cout << valueCount << " giá trị x " << rounds << " vòng\n";
+    report("shared_ptr (cũ)", sizeof(LegacyValue), benchCopy(legacyValues), benchDispatch<LegacyValue, LegacyValue>(legacyValues));
+    report("Ref (mới)      ", sizeof(Value), benchCopy(values), benchDispatch<Value, BaseValue>(values));
+    return 0;
+}
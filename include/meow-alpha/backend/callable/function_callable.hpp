@@ -11,7 +11,12 @@ public:
     std::shared_ptr<Environment> closure;
 
     MeowScriptFunction(FunctionLiteral* decl, std::shared_ptr<Environment> cl);
-    Value call(Interpreter* engine, const std::vector<Value>& args) override;
+    Value call(Interpreter* engine, Arguments args) override;
+
+    // Môi trường cho một lần gọi với tham số đã đủ theo arity; self khác nullptr thì gắn làm 'this'.
+    // Bản nhận MutableArguments chuyển thẳng các giá trị vào slot thay vì sao chép.
+    std::shared_ptr<Environment> makeFrame(Arguments args, const Value* self = nullptr);
+    std::shared_ptr<Environment> makeFrame(MutableArguments args, const Value* self = nullptr);
 
     Arity arity() const override;
 
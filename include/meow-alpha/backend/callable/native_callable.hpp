@@ -11,7 +11,7 @@ public:
 
     NativeCallable(std::shared_ptr<NativeFunction> data);
 
-    Value call(Interpreter* engine, const std::vector<Value>& args) override;
+    Value call(Interpreter* engine, Arguments args) override;
 
     Arity arity() const override;
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "runtime/function_arity.hpp"
+#include "runtime/ref.hpp"
+#include "runtime/native_fn.hpp"
 #include <vector>
 #include <memory>
 
@@ -9,12 +11,12 @@ class Value;
 class Environment;
 struct Arity;
 
-class Callable {
+class Callable: public RefCounted {
 public:
 
     virtual ~Callable() = default;
 
-    virtual Value call(Interpreter* engine, const std::vector<Value>& args) = 0;
+    virtual Value call(Interpreter* engine, Arguments args) = 0;
 
     virtual Arity arity() const = 0;
 
@@ -23,4 +25,4 @@ public:
     }
 };
 
-using Function = std::shared_ptr<Callable>;
\ No newline at end of file
+using Function = Ref<Callable>;
\ No newline at end of file
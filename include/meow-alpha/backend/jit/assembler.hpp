@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bộ sinh mã x86-64 tối thiểu cho LoopJit. Không mã hoá toán hạng tổng quát mà chỉ có đúng những lệnh
+// JIT cần, với thanh ghi cố định: rax/rcx cho Int, xmm0/xmm1 cho Real, rbx trỏ vào frame (mảng ô 8 byte
+// chứa các biến). Ô thứ i nằm ở [rbx + 8*i].
+
+// Mã điều kiện của Jcc/SETcc (4 bit thấp của opcode)
+enum class Condition : uint8_t {
+    Below = 0x2,
+    AboveEqual = 0x3,
+    Equal = 0x4,
+    NotEqual = 0x5,
+    BelowEqual = 0x6,
+    Above = 0x7,
+    Parity = 0xA,
+    NoParity = 0xB,
+    Less = 0xC,
+    GreaterEqual = 0xD,
+    LessEqual = 0xE,
+    Greater = 0xF,
+};
+
+inline Condition negate(Condition condition) {
+    return static_cast<Condition>(static_cast<uint8_t>(condition) ^ 1);
+}
+
+// Đích nhảy. Nhảy tới Label chưa bind thì ghi lại chỗ cần vá, bind xong mới điền rel32
+struct Label {
+    std::ptrdiff_t position = -1;
+    std::vector<size_t> fixups;
+};
+
+// Vùng nhớ mmap chứa mã máy đã sinh, chỉ đọc + thực thi. Hàm nhận con trỏ frame, trả về mã thoát
+class NativeCode {
+public:
+    using Entry = int64_t (*)(int64_t* frame);
+
+    ~NativeCode();
+    NativeCode(const NativeCode&) = delete;
+    NativeCode& operator=(const NativeCode&) = delete;
+
+    // nullptr nếu không cấp phát được trang thực thi
+    static std::unique_ptr<NativeCode> install(const std::vector<uint8_t>& bytes);
+
+    int64_t operator()(int64_t* frame) const {
+        return entry(frame);
+    }
+
+private:
+    NativeCode(void* memory, size_t size): memory(memory), size(size), entry(reinterpret_cast<Entry>(memory)) {}
+
+    void* memory;
+    size_t size;
+    Entry entry;
+};
+
+class Assembler {
+public:
+    const std::vector<uint8_t>& bytes() const {
+        return code;
+    }
+
+    void bind(Label& label);
+    void jmp(Label& label);
+    void jcc(Condition condition, Label& label);
+
+    // push rbp; mov rbp, rsp; push rbx; mov rbx, rdi
+    void prologue();
+    // mov rbx, [rbp-8]; mov rsp, rbp; pop rbp; ret (dọn luôn những gì còn đẩy trên stack)
+    void epilogue();
+
+    // Int
+    void movRaxImm(int64_t value);
+    void movRcxImm(int64_t value);
+    void movRaxSlot(int slot);
+    void movRcxSlot(int slot);
+    void movSlotRax(int slot);
+    void movRcxRax();
+    void movRaxRdx();
+    void pushRax();
+    void popRax();
+    void addRaxRcx();
+    void subRaxRcx();
+    void imulRaxRcx();
+    void andRaxRcx();
+    void orRaxRcx();
+    void xorRaxRcx();
+    // shl/sar rax, cl: số bit dịch lấy theo 6 bit thấp, như phép dịch của C++ biên dịch ra trên x86-64
+    void shlRaxCl();
+    void sarRaxCl();
+    void negRax();
+    void notRax();
+    // cqo; idiv rcx: thương ở rax, dư ở rdx
+    void idivRcx();
+    void incSlot(int slot);
+    void decSlot(int slot);
+    void cmpRaxRcx();
+    void cmpRcxImm8(int8_t value);
+    void testRaxRax();
+    void testRcxRcx();
+    // setcc al; movzx eax, al
+    void setRax(Condition condition);
+    // setcc cl
+    void setCl(Condition condition);
+    void andAlCl();
+    void orAlCl();
+    void xorRaxImm8(int8_t value);
+
+    // Real
+    void movsdXmm0Slot(int slot);
+    void movsdXmm1Slot(int slot);
+    void movsdSlotXmm0(int slot);
+    void movqXmm0Rax();
+    void movqXmm1Rcx();
+    void movqRaxXmm0();
+    void movapdXmm1Xmm0();
+    void cvtsi2sdXmm0Rax();
+    void cvtsi2sdXmm1Rcx();
+    void cvtsi2sdXmm1Rax();
+    void addsd();
+    void subsd();
+    void mulsd();
+    void divsd();
+    // ucomisd xmm0, xmm1
+    void ucomisdXmm0Xmm1();
+    // ucomisd xmm1, xmm0
+    void ucomisdXmm1Xmm0();
+    // xorpd xmm2, xmm2; ucomisd xmm1, xmm2
+    void ucomisdXmm1Zero();
+    // xorpd xmm1, xmm1; ucomisd xmm0, xmm1
+    void ucomisdXmm0Zero();
+    // Đảo bit dấu của xmm0 (qua rax)
+    void negXmm0();
+
+private:
+    std::vector<uint8_t> code;
+
+    void emit(std::initializer_list<uint8_t> bytes);
+    void emit32(int32_t value);
+    void emit64(int64_t value);
+    void emitSlot(int slot);
+    void emitRel32(Label& label);
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define MEOW_JIT_SUPPORTED 1
+#else
+#define MEOW_JIT_SUPPORTED 0
+#endif
+
+struct Statement;
+class Environment;
+
+// JIT cho vòng lặp số (--jit, chỉ tree walker trên x86-64 Linux).
+// Vòng for/while chạy đủ hotIterations lần trong một lần vào thì TreeWalker giao phần còn lại cho run().
+// Vòng lặp dịch được khi chỉ đọc/ghi các biến đang là Int hoặc Real bằng + - * / % & | ^ << >>, so sánh,
+// &&, ||, !, ++/--, if/else, break/continue, không khai báo biến và không gọi hàm.
+// Mã máy được chuyên biệt theo kiểu của các biến lúc dịch; lần vào sau kiểu khác đi (trượt guard),
+// hoặc gặp phép chia cho 0 giữa chừng, thì trả lại đúng trạng thái đầu vòng lặp hiện tại cho tree walker.
+// Trượt quá maxDeopts lần thì vòng lặp đó chỉ chạy thông dịch. MEOW_JIT=0 tắt hẳn JIT.
+class LoopJit {
+public:
+    static constexpr uint32_t hotIterations = 32;
+    static constexpr uint8_t maxDeopts = 4;
+
+    LoopJit();
+    ~LoopJit();
+
+    // JIT có chạy được ở đây không: đúng kiến trúc và không bị tắt bằng MEOW_JIT=0
+    static bool isAvailable();
+
+    // Chạy tiếp vòng lặp từ đầu lượt hiện tại (trước điều kiện) bằng mã máy.
+    // true nếu vòng lặp đã kết thúc, false nếu tree walker phải chạy tiếp từ chính chỗ đó
+    bool run(Statement* loop, Environment* env);
+
+private:
+    struct CompiledLoop;
+
+    static std::unique_ptr<CompiledLoop> compile(Statement* loop, Environment* env);
+
+    std::unordered_map<Statement*, std::unique_ptr<CompiledLoop>> loops;
+};
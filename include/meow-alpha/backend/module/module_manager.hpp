@@ -2,12 +2,22 @@
 
 #include "native_lib/standard_lib.hpp"
 #include "runtime/value.hpp"
+#include "common/source_file.hpp"
+#include "vm/chunk.hpp"
+#include "optimizer/optimizer.hpp"
 #include <string>
 #include <unordered_map>
 
 class Interpreter;
+class VirtualMachine;
 struct Program;
 
+enum class Backend {
+    TreeWalker,
+    Bytecode,
+    Closure,
+};
+
 struct ParsedModule {
     std::unique_ptr<Program> ast;
     Value exports;
@@ -16,12 +26,28 @@ struct ParsedModule {
 class ModuleManager {
     std::unordered_map<std::string, std::unique_ptr<NativeLibrary>> nativeModules;
     std::vector<std::string> argv;
+
+    ChunkCache chunkCache;
+    // Instance giữ con trỏ tới engine đã tạo ra nó, nên VM của module phải sống cùng ModuleManager
+    std::vector<std::unique_ptr<VirtualMachine>> machines;
+
+    void run(ParsedModule& module, const SrcFilePtr& srcFile, bool isModuleContext);
+    // Optimizer rồi Resolver, chạy trên cây vừa parse xong
+    void prepare(Program* program, const std::string& moduleName);
 public:
     ModuleManager();
     ModuleManager(int argc, char* argv[]);
+    ~ModuleManager();
+
+    Backend backend = Backend::TreeWalker;
+    OptimizationLevel optimizationLevel = OptimizationLevel::O0;
+    // --opt-stats: in số node mỗi pass đã biến đổi, cho từng module
+    bool printsOptimizerStats = false;
+    // --jit: tree walker dịch các vòng lặp số nóng ra mã máy (xem LoopJit)
+    bool enablesJit = false;
 
     std::unordered_map<std::string, ParsedModule> moduleCache;
 
     Value load(const std::string& importerPath, const std::string& importPath);
     Value loadFromSource(const std::string& moduleKey, const std::string& sourceCode);
-};
\ No newline at end of file
+};
\ No newline at end of file
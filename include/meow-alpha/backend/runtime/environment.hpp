@@ -2,8 +2,12 @@
 
 #include "runtime/value.hpp"
 #include "diagnostics/diagnostic.hpp"
+#include "common/scope_layout.hpp"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <stdexcept>
 #include <iostream>
 
@@ -12,27 +16,76 @@ class Value;
 struct Variable {
     Value value;
     bool isConstant;
+    // Slot đã chạy qua lệnh khai báo hay chưa, biến lưu theo tên luôn là true
+    bool isDefined = true;
 };
 
+// Biến có địa chỉ từ Resolver nằm trong mảng slots liền nhau, kích thước lấy từ ScopeLayout.
+// Bảng variables chỉ còn dùng cho môi trường gốc và những tên không biết trước (import *).
 class Environment {
 private:
+    std::vector<Variable> slots;
+    const ScopeLayout* layout = nullptr;
     std::unordered_map<std::string, Variable> variables;
     std::shared_ptr<Environment> outer;
+    // 0 khi chưa ai hỏi tới identity()
+    uint64_t id = 0;
+
+    Variable* findLocal(const std::string& name) {
+        if (layout != nullptr) {
+            int slot = layout->slotOf(name);
+            if (slot >= 0) {
+                return slots[slot].isDefined ? &slots[slot] : nullptr;
+            }
+        }
+
+        auto it = variables.find(name);
+        return it != variables.end() ? &it->second : nullptr;
+    }
+
+    const Variable* findLocal(const std::string& name) const {
+        return const_cast<Environment*>(this)->findLocal(name);
+    }
+
 public:
+    static void assignVariable(Variable& variable, const std::string& name, const Value& value) {
+        if (variable.isConstant) {
+            throw std::runtime_error("Không thể gán cho biến '" + name +  "' vì nó là hằng số!");
+        }
+        variable.value = value;
+    }
+
     Environment(std::shared_ptr<Environment> parent): outer(std::move(parent)) {}
 
+    Environment(std::shared_ptr<Environment> parent, const ScopeLayout* scopeLayout): outer(std::move(parent)) {
+        if (scopeLayout != nullptr && scopeLayout->size() > 0) {
+            layout = scopeLayout;
+            slots.assign(scopeLayout->size(), Variable{Value(Null{}), false, false});
+        }
+    }
+
     void define(const std::string& name, const Value& value, bool isConstant = false) {
+        if (layout != nullptr) {
+            int slot = layout->slotOf(name);
+            if (slot >= 0) {
+                defineAt(slot, value, isConstant);
+                return;
+            }
+        }
         variables[name] = {value, isConstant};
     }
 
-    void assign(const std::string& name, const Value& value) {
-        auto it = variables.find(name);
+    void defineAt(int slot, const Value& value, bool isConstant = false) {
+        slots[slot] = {value, isConstant, true};
+    }
 
-        if (it != variables.end()) {
-            if (it->second.isConstant) {
-                throw std::runtime_error("Không thể gán cho biến '" + name +  "' vì nó là hằng số!");
-            }
-            it->second.value = value;
+    void defineAt(int slot, Value&& value, bool isConstant = false) {
+        slots[slot] = {std::move(value), isConstant, true};
+    }
+
+    void assign(const std::string& name, const Value& value) {
+        if (Variable* variable = findLocal(name)) {
+            assignVariable(*variable, name, value);
             return;
         }
 
@@ -44,11 +97,67 @@ public:
         variables[name] = {value, false};
     }
 
-    Value find(const std::string& name) const {
-        auto it = variables.find(name);
+    // Slot chưa được khai báo lúc chạy thì làm như bản tìm theo tên: tiếp tục ở môi trường ngoài
+    void assignAt(int slot, const Value& value) {
+        Variable& variable = slots[slot];
 
-        if (it != variables.end()) {
-            return it->second.value;
+        if (variable.isDefined) {
+            assignVariable(variable, layout->names[slot], value);
+            return;
+        }
+
+        if (outer) {
+            outer->assign(layout->names[slot], value);
+            return;
+        }
+
+        variable = {value, false, true};
+    }
+
+    // Biến mà assign(name) sẽ ghi vào, nullptr nếu chưa được khai báo ở đâu cả
+    Variable* lookup(const std::string& name) {
+        if (Variable* variable = findLocal(name)) {
+            return variable;
+        }
+        return outer ? outer->lookup(name) : nullptr;
+    }
+
+    // Như lookup nhưng theo slot, giống cách assignAt xử lý slot chưa được khai báo
+    Variable* lookupAt(int slot) {
+        Variable& variable = slots[slot];
+        if (variable.isDefined) {
+            return &variable;
+        }
+        return outer ? outer->lookup(layout->names[slot]) : nullptr;
+    }
+
+    // Biến nằm ngay trong môi trường này, không tìm ra môi trường ngoài
+    Variable* lookupOwn(const std::string& name) {
+        return findLocal(name);
+    }
+
+    // Số định danh không lặp lại trong suốt chương trình, kể cả khi một Environment mới được cấp đúng
+    // địa chỉ của một Environment đã giải phóng. Quickening của Identifier dùng nó làm guard.
+    uint64_t identity() {
+        static std::atomic<uint64_t> lastId{0};
+        if (id == 0) {
+            id = lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+        return id;
+    }
+
+    // Đi lên đúng depth môi trường theo địa chỉ từ vựng của Resolver
+    Environment* ancestor(int depth) {
+        Environment* environment = this;
+        while (depth-- > 0 && environment->outer) {
+            environment = environment->outer.get();
+        }
+        return environment;
+    }
+
+    Value find(const std::string& name) const {
+        if (const Variable* variable = findLocal(name)) {
+            return variable->value;
         }
 
         if (outer) {
@@ -58,11 +167,23 @@ public:
         return Value(Null{});
     }
 
-    void setConst(const std::string& name) {
-        auto it = variables.find(name);
+    Value findAt(int slot) const {
+        const Variable& variable = slots[slot];
+
+        if (variable.isDefined) {
+            return variable.value;
+        }
+
+        if (outer) {
+            return outer->find(layout->names[slot]);
+        }
+
+        return Value(Null{});
+    }
 
-        if (it != variables.end()) {
-            it->second.isConstant = true;
+    void setConst(const std::string& name) {
+        if (Variable* variable = findLocal(name)) {
+            variable->isConstant = true;
             return;
         }
 
@@ -73,10 +194,8 @@ public:
     }
 
     void unsetConst(const std::string& name) {
-        auto it = variables.find(name);
-
-        if (it != variables.end()) {
-            it->second.isConstant = false;
+        if (Variable* variable = findLocal(name)) {
+            variable->isConstant = false;
             return;
         }
 
@@ -93,10 +212,16 @@ public:
             allVars = outer->getAllVariables();
         }
         
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].isDefined) {
+                allVars[layout->names[i]] = slots[i];
+            }
+        }
+
         for (const auto& pair : variables) {
             allVars[pair.first] = pair.second;
         }
         
         return allVars;
     }
-};
\ No newline at end of file
+};
\ No newline at end of file
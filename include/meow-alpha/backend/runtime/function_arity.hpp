@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 struct Arity {
     int required = 0;
     int optional = 0;
@@ -14,4 +16,18 @@ struct Arity {
     static Arity atLeast(int min) { 
         return {min, 0, true}; 
     }
+
+    bool accepts(int count) const {
+        if (isVariadic) {
+            return count >= required;
+        }
+        return count >= required && count <= required + optional;
+    }
+
+    // Arity nhìn từ phía người gọi khi tham số đầu tiên (receiver) đã được gắn sẵn
+    Arity withoutReceiver() const {
+        Arity bound = *this;
+        bound.required = std::max(0, required - 1);
+        return bound;
+    }
 };
\ No newline at end of file
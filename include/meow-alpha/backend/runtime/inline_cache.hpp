@@ -0,0 +1,55 @@
+#pragma once
+
+#include "runtime/value.hpp"
+#include <cstdint>
+#include <vector>
+
+// Inline cache cho một vị trí truy cập thuộc tính trong code (node PropertyAccess hoặc một lệnh bytecode).
+// Mỗi entry ghi lại kiểu receiver đã gặp và kết quả tra cứu tương ứng. Shape chỉ thuộc về một class,
+// nên so shape của instance là đủ để biết cả class lẫn vị trí của trường.
+class PropertyCache {
+public:
+    // Gặp quá số kiểu receiver này thì coi là megamorphic và thôi không cache nữa
+    static constexpr size_t maxEntries = 4;
+
+    enum class Kind : uint8_t {
+        Field,          // trường nằm ở slot của shape
+        Method,         // shape không có trường này, tên trỏ tới phương thức của class
+        Transition,     // gán trường mới: shape -> target, giá trị thêm vào cuối slots
+        Static,         // trường tĩnh của class
+    };
+
+    struct Entry {
+        Kind kind;
+        int slot = -1;
+        // Method: lookupVersion() của class, Static: version của class
+        uint32_t version = 0;
+        ShapeRef shape;
+        ShapeRef target;
+        Class klass;
+        // Method: phương thức, Static: giá trị trường tĩnh
+        Value value;
+    };
+
+    // Tương đương instance->get(key)
+    Value get(MeowScriptInstance* instance, const String& key);
+    // Tương đương instance->getField(key)
+    Value getField(MeowScriptInstance* instance, const String& key);
+    // Tương đương instance->setField(key, value)
+    void setField(MeowScriptInstance* instance, const String& key, const Value& value);
+    // Tương đương instance->fieldSlot(key)
+    Value* fieldSlot(MeowScriptInstance* instance, const String& key);
+    // Tương đương klass->get(key)
+    Value get(MeowScriptClass* klass, const String& key);
+
+    // Phương thức mà receiver.key(...) sẽ gọi, để gọi thẳng mà không dựng bound method.
+    // Với instance là phương thức của class (this = receiver), với mảng/chuỗi/object là hàm thư viện
+    // nhận receiver làm tham số đầu. Trả về nullptr nếu phải đi đường thường (trường, __getitem__, ...).
+    Function findMethod(const Value& receiver, const String& key);
+
+private:
+    std::vector<Entry> entries;
+    bool isMegamorphic = false;
+
+    void record(Entry entry);
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "runtime/value.hpp"
+#include <string>
+
+// Trả về atom duy nhất cho nội dung str; gọi lại với cùng nội dung sẽ nhận đúng con trỏ đó.
+// Atom sống tới hết chương trình, dùng cho literal, tên thuộc tính và tên biến trong bytecode.
+String intern(const std::string& str);
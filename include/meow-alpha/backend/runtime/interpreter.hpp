@@ -2,6 +2,8 @@
 
 #include "runtime/environment.hpp"
 #include "runtime/value.hpp"
+#include "runtime/value_stack.hpp"
+#include <initializer_list>
 #include <vector>
 #include <string>
 
@@ -14,11 +16,28 @@ public:
     virtual ~Interpreter() = default;
     bool isInsideProtocolCall = false;
 
-    virtual Value call(const Value& callee, const std::vector<Value>& args) = 0;
-    virtual void execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) = 0;
+    virtual Value call(const Value& callee, Arguments args) = 0;
+    Value call(const Value& callee, std::initializer_list<Value> args) {
+        return call(callee, Arguments(args.begin(), args.size()));
+    }
+    // Chạy thân hàm trong môi trường cho trước, trả về giá trị của lệnh return (Null nếu không có)
+    virtual Value execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) = 0;
     virtual Value exec(ASTNode* node, std::shared_ptr<Environment> local) = 0;
     virtual void throwRuntimeErr(const Token& token, const std::string& message) = 0;
     virtual std::shared_ptr<Environment> getCurrEnv() const = 0;
     virtual std::shared_ptr<Environment> getGlobalEnv() const = 0;
     virtual std::vector<std::string> getArgv() const = 0;
-}; 
\ No newline at end of file
+
+protected:
+    // Tham số của các lời gọi hàm đang chạy
+    ValueStack valueStack;
+
+    // Chuỗi thông báo lỗi chỉ được dựng khi số tham số thật sự không khớp
+    static void checkArity(const Arity& arity, const Value& callee, Arguments args) {
+        if (!arity.accepts(static_cast<int>(args.size()))) {
+            throwArityError(arity, callee, args);
+        }
+    }
+    [[noreturn]] static void throwArityError(const Arity& arity, const Value& callee, Arguments args);
+    [[noreturn]] static void throwNotCallable(const Value& callee, Arguments args);
+}; 
\ No newline at end of file
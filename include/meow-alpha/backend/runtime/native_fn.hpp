@@ -3,12 +3,17 @@
 #include "runtime/function_arity.hpp"
 #include <string>
 #include <functional>
+#include <span>
 #include <variant>
 
 class Interpreter;
 class Value;
 
-using Arguments = const std::vector<Value>&;
+// Tham số của một lời gọi: chỉ là view vào đoạn giá trị nơi gọi đang giữ (thường nằm trên ValueStack
+// của interpreter), hàm được gọi không được giữ lại span sau khi trả về
+using Arguments = std::span<const Value>;
+// Như Arguments nhưng hàm được gọi được phép chuyển các giá trị ra khỏi đó
+using MutableArguments = std::span<Value>;
 
 using NativeFnSimple = std::function<Value(Arguments args)>;
 using NativeFnAdvanced = std::function<Value(Interpreter* engine, Arguments args)>;
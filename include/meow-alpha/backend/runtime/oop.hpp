@@ -7,43 +7,109 @@
 #include "interface/iterable.hpp"
 #include "interface/stringifiable.hpp"
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 
 struct ObjectData;
+struct StringData;
 class Value;
-using Object = std::shared_ptr<ObjectData>;
+using Object = Ref<ObjectData>;
+using String = Ref<StringData>;
 
 class MeowScriptClass;
 class MeowScriptInstance;
 class MeowScriptBoundMethod;
 
-using Class = std::shared_ptr<MeowScriptClass>;
-using Instance = std::shared_ptr<MeowScriptInstance>;
-using BoundMethod = std::shared_ptr<MeowScriptBoundMethod>;
+using Class = Ref<MeowScriptClass>;
+using Instance = Ref<MeowScriptInstance>;
+using BoundMethod = Ref<MeowScriptBoundMethod>;
 
-class MeowScriptClass : public Callable, public Stringifiable, public Indexable, public std::enable_shared_from_this<MeowScriptClass> {
+class Shape;
+using ShapeRef = Ref<Shape>;
+
+// Hidden class của instance: danh sách tên trường theo thứ tự được gán lần đầu.
+// Các instance cùng class gán cùng các trường theo cùng thứ tự sẽ dùng chung một Shape
+// và chỉ lưu giá trị trong mảng slot, không cần bảng băm riêng cho từng instance.
+class Shape : public RefCounted {
+public:
+    // Quá giới hạn này instance chuyển sang dictionary mode
+    static constexpr size_t maxSlots = 32;
+
+    // keys[i] là tên trường ở slot i, luôn là chuỗi đã intern
+    std::vector<String> keys;
+    // Shape con khi thêm một trường mới, key là atom của tên trường
+    std::unordered_map<const StringData*, ShapeRef> transitions;
+
+    int slotOf(const StringData* key) const;
+    ShapeRef withKey(const String& key);
+};
+
+// Các phương thức đặc biệt mà runtime tự gọi, tra theo chỉ số slot thay vì theo tên
+enum class Protocol : uint8_t {
+    GetItem,        // __getitem__
+    SetItem,        // __setitem__
+    Str,            // __str__
+    Call,           // __call__
+    Iterator,       // __iterator__
+    Next,           // __next__
+    Int,            // __int__
+    Real,           // __real__
+    Bool,           // __bool__
+    Array,          // __array__
+    Object,         // __object__
+
+    _TOTAL_PROTOCOLS
+};
+
+class MeowScriptClass : public Callable, public Stringifiable, public Indexable {
 public:
     std::string name;
     Class superclass;
     std::unordered_map<std::string, Function> methods;
     std::unordered_map<std::string, Value> static_fields;
 
+    // Shape gốc (chưa có trường nào) của mọi instance thuộc class này
+    ShapeRef rootShape = makeRef<Shape>();
+    // Số trường lớn nhất từng thấy ở một instance, dùng để cấp phát trước mảng slot
+    size_t slotHint = 0;
+    // Tăng mỗi khi methods hoặc static_fields thay đổi, inline cache dùng nó làm guard
+    uint32_t version = 0;
+
     MeowScriptClass(std::string name, Class super) : name(std::move(name)), superclass(std::move(super)) {}
     ~MeowScriptClass() override = default;
 
-    Value call(Interpreter* engine, const std::vector<Value>& args) override;
+    Value call(Interpreter* engine, Arguments args) override;
     
     Arity arity() const override;
 
     Function findMethod(const std::string& methodName) const;
 
+    void defineMethod(const std::string& methodName, Function method);
+    void defineStatic(const std::string& fieldName, const Value& value);
+
+    // Tổng version của class và các class cha, đổi khi bảng phương thức ở bất kỳ đâu trên chuỗi kế thừa đổi
+    uint32_t lookupVersion() const;
+
+    // Phương thức đặc biệt (đã tính kế thừa), nullptr nếu class không định nghĩa
+    const Function& protocol(Protocol slot) const;
+
     Value get(const Value& key) override;
     void set(const Value& key, const Value& value) override;
     
     std::string toString() const override;
+
+private:
+    // Bảng phương thức đã gộp sẵn các class cha và các slot protocol,
+    // dựng lại ở lần tra cứu đầu tiên sau khi lookupVersion() đổi
+    mutable std::unordered_map<std::string, Function> flatMethods;
+    mutable std::array<Function, static_cast<size_t>(Protocol::_TOTAL_PROTOCOLS)> protocolSlots;
+    mutable uint32_t flatVersion = UINT32_MAX;
+
+    void ensureFlattened() const;
 };
 
 class InstanceIterator : public Iterator {
@@ -61,21 +127,42 @@ public:
     Value next() override;
 };
 
-class MeowScriptInstance : public Indexable, public Iterable, public Callable, public Stringifiable, public std::enable_shared_from_this<MeowScriptInstance> {
+// Trường của instance nằm ở một trong hai chế độ:
+// - shape != nullptr: giá trị nằm trong slots theo thứ tự của shape
+// - shape == nullptr (dictionary mode): giá trị nằm trong fields, dùng khi key không phải chuỗi,
+//   quá nhiều trường, hoặc khi code lấy __fields__ ra để thao tác trực tiếp
+class MeowScriptInstance : public Callable, public Indexable, public Iterable, public Stringifiable {
 public:
     Class klass; 
 
-    Object fields = std::make_shared<ObjectData>();
+    ShapeRef shape;
+    std::vector<Value> slots;
+    Object fields;
 
     Interpreter* engine;
 
-    MeowScriptInstance(Class k, Interpreter* e) : klass(std::move(k)), engine(std::move(e)) {}
+    MeowScriptInstance(Class k, Interpreter* e);
+    ~MeowScriptInstance() override;
+
+    Value getField(const Value& key);
+    void setField(const Value& key, const Value& value);
+    // Ô đang lưu trường key để ghi thẳng vào, nullptr nếu instance chưa có trường này
+    Value* fieldSlot(const String& key);
+
+    // Chuyển sang dictionary mode và trả về ObjectData đang giữ các trường (thay đổi trên nó phản ánh vào instance)
+    Object fieldsObject();
+    // Bản sao các trường, không đổi chế độ của instance
+    Object copyFields() const;
+    // Dùng obj làm nơi lưu trường (dictionary mode)
+    void adoptFields(Object obj);
+    // Hàm name của objectLib gắn với các trường của instance, như ObjectData::get trả về
+    Value objectLibFunction(const std::string& name, const Function& unboundFunction);
 
     Value get(const Value& key) override;
     
     void set(const Value& key, const Value& value) override;
 
-    Value call(Interpreter* engine, const std::vector<Value>& args) override;
+    Value call(Interpreter* engine, Arguments args) override;
 
     Arity arity() const override;
 
@@ -91,7 +178,10 @@ public:
 
     MeowScriptBoundMethod(Instance inst, Function func) : instance(std::move(inst)), function(std::move(func)) {}
 
-    Value call(Interpreter* engine, const std::vector<Value>& args) override;
+    Value call(Interpreter* engine, Arguments args) override;
+
+    // Gọi function với this = instance mà không cần dựng bound method
+    static Value invoke(Interpreter* engine, const Instance& instance, const Function& function, Arguments args);
 
     Arity arity() const override;
 
@@ -100,4 +190,4 @@ public:
     void set(const Value& key, const Value& value) override;
 
     std::string toString() const override;
-};
\ No newline at end of file
+};
\ No newline at end of file
@@ -3,27 +3,26 @@
 #include "runtime/value.hpp"
 #include "common/token.hpp"
 #include "runtime/overload.hpp"
+#include <array>
+#include <cstdint>
+#include <iterator>
 #include <string>
+#include <type_traits>
 #include <variant>
 
+// Thứ tự trùng với thứ tự các alternative của BaseValue, nên kiểu của một Value chính là Value::index()
 enum class ValueType {
-    Null, Int, Real, Bool, String, Array, Object, Function, Instance, Class, BoundMethod, Total
+    Null, Int, Real, Bool, String, Array, Object, Function, Class, Instance, BoundMethod, Total
 };
 
+static_assert(std::variant_size_v<BaseValue> == static_cast<size_t>(ValueType::Total));
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(ValueType::String), BaseValue>, String>);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(ValueType::Class), BaseValue>, Class>);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(ValueType::Instance), BaseValue>, Instance>);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(ValueType::BoundMethod), BaseValue>, BoundMethod>);
+
 inline ValueType get_value_type(const Value& value) noexcept {
-    return std::visit(overloaded{
-        [](Null) { return ValueType::Null; },
-        [](Int) { return ValueType::Int; },
-        [](Real) { return ValueType::Real; },
-        [](Bool) { return ValueType::Bool; },
-        [](const String&) { return ValueType::String; },
-        [](const Array&) { return ValueType::Array; },
-        [](const Object&) { return ValueType::Object; },
-        [](const Function&) { return ValueType::Function; },
-        [](const Instance&) { return ValueType::Instance; },
-        [](const Class&) { return ValueType::Class; },
-        [](const BoundMethod&) { return ValueType::BoundMethod; }
-    }, static_cast<const BaseValue&>(value));
+    return static_cast<ValueType>(value.index());
 }
 
 using BinaryOpFunction = Value (*)(const Value&, const Value&);
@@ -39,26 +38,124 @@ constexpr size_t NUM_VALUE_TYPES = static_cast<size_t>(ValueType::Total);
     return static_cast<size_t>(value_type);
 }
 
+// Chỉ những toán tử này mới có hàng trong bảng, các token còn lại không tốn chỗ
+inline constexpr TokenType BINARY_OPERATORS[] = {
+    TokenType::OP_PLUS, TokenType::OP_MINUS, TokenType::OP_MULTIPLY, TokenType::OP_DIVIDE,
+    TokenType::OP_MODULO, TokenType::OP_EXPONENT,
+    TokenType::OP_EQ, TokenType::OP_NEQ, TokenType::OP_LT, TokenType::OP_GT, TokenType::OP_LE, TokenType::OP_GE,
+    TokenType::OP_BIT_AND, TokenType::OP_BIT_OR, TokenType::OP_BIT_XOR, TokenType::OP_LSHIFT, TokenType::OP_RSHIFT,
+};
+inline constexpr TokenType UNARY_OPERATORS[] = {
+    TokenType::OP_MINUS, TokenType::OP_LOGICAL_NOT, TokenType::OP_BIT_NOT,
+};
+
+constexpr uint8_t NO_OPERATOR_ROW = UINT8_MAX;
+
+// Đường tắt cho Int×Int và Real×Real với các toán tử hay gặp: tính ngay tại chỗ thay vì gọi qua bảng.
+// Trả về false nếu không thuộc các trường hợp này, hoặc là chia/modulo cho 0 (để bảng xử lý);
+// khi đó dùng OperatorDispatcher::find. Kết quả phải giống hệt hàm tương ứng trong bảng.
+inline bool intBinary(TokenType op, Int a, Int b, Value& result) noexcept {
+    switch (op) {
+        case TokenType::OP_PLUS:     result = a + b; return true;
+        case TokenType::OP_MINUS:    result = a - b; return true;
+        case TokenType::OP_MULTIPLY: result = a * b; return true;
+        case TokenType::OP_DIVIDE:
+            if (b == 0) {
+                return false;
+            }
+            result = static_cast<Real>(a) / static_cast<Real>(b);
+            return true;
+        case TokenType::OP_MODULO:
+            if (b == 0) {
+                return false;
+            }
+            result = a % b;
+            return true;
+        case TokenType::OP_EQ:       result = a == b; return true;
+        case TokenType::OP_NEQ:      result = a != b; return true;
+        case TokenType::OP_LT:       result = a < b; return true;
+        case TokenType::OP_GT:       result = a > b; return true;
+        case TokenType::OP_LE:       result = a <= b; return true;
+        case TokenType::OP_GE:       result = a >= b; return true;
+        case TokenType::OP_BIT_AND:  result = a & b; return true;
+        case TokenType::OP_BIT_OR:   result = a | b; return true;
+        case TokenType::OP_BIT_XOR:  result = a ^ b; return true;
+        case TokenType::OP_LSHIFT:   result = a << b; return true;
+        case TokenType::OP_RSHIFT:   result = a >> b; return true;
+        default: return false;
+    }
+}
+
+inline bool realBinary(TokenType op, Real a, Real b, Value& result) noexcept {
+    switch (op) {
+        case TokenType::OP_PLUS:     result = a + b; return true;
+        case TokenType::OP_MINUS:    result = a - b; return true;
+        case TokenType::OP_MULTIPLY: result = a * b; return true;
+        case TokenType::OP_DIVIDE:   result = a / b; return true;
+        case TokenType::OP_EQ:       result = a == b; return true;
+        case TokenType::OP_NEQ:      result = a != b; return true;
+        case TokenType::OP_LT:       result = a < b; return true;
+        case TokenType::OP_GT:       result = a > b; return true;
+        case TokenType::OP_LE:       result = a <= b; return true;
+        case TokenType::OP_GE:       result = a >= b; return true;
+        default: return false;
+    }
+}
+
+// Chọn intBinary hoặc realBinary theo kiểu hai vế
+inline bool fastBinary(TokenType op, const Value& left, const Value& right, Value& result) noexcept {
+    if (left.index() != right.index()) {
+        return false;
+    }
+    if (auto a = std::get_if<Int>(&left)) {
+        return intBinary(op, *a, *std::get_if<Int>(&right), result);
+    }
+    if (auto a = std::get_if<Real>(&left)) {
+        return realBinary(op, *a, *std::get_if<Real>(&right), result);
+    }
+    return false;
+}
+
+// TokenType -> số thứ tự hàng của toán tử trong bảng, NO_OPERATOR_ROW nếu không có
+template <size_t N>
+constexpr std::array<uint8_t, NUM_TOKEN_TYPES> makeOperatorRows(const TokenType (&operators)[N]) {
+    std::array<uint8_t, NUM_TOKEN_TYPES> rows{};
+    rows.fill(NO_OPERATOR_ROW);
+    for (size_t i = 0; i < N; ++i) {
+        rows[+operators[i]] = static_cast<uint8_t>(i);
+    }
+    return rows;
+}
+
+// Bảng toán tử được dựng lúc biên dịch và chỉ có một bản dùng chung (OperatorDispatcher::shared)
+// cho mọi TreeWalker và VirtualMachine.
 class OperatorDispatcher {
 private:
-    BinaryOpFunction binary_dispatch_table_[NUM_TOKEN_TYPES][NUM_VALUE_TYPES][NUM_VALUE_TYPES];
-    UnaryOpFunction unary_dispatch_table_[NUM_TOKEN_TYPES][NUM_VALUE_TYPES];
+    static constexpr auto binaryRows = makeOperatorRows(BINARY_OPERATORS);
+    static constexpr auto unaryRows = makeOperatorRows(UNARY_OPERATORS);
+
+    BinaryOpFunction binary_dispatch_table_[std::size(BINARY_OPERATORS)][NUM_VALUE_TYPES][NUM_VALUE_TYPES] = {};
+    UnaryOpFunction unary_dispatch_table_[std::size(UNARY_OPERATORS)][NUM_VALUE_TYPES] = {};
+
+    constexpr OperatorDispatcher() noexcept;
 
 public:
-    OperatorDispatcher() noexcept;
-    [[nodiscard]] inline const BinaryOpFunction* find(TokenType op, const Value& left, const Value& right) const noexcept {
-        auto left_type = get_value_type(left);
-        auto right_type = get_value_type(right);
-        
-        const BinaryOpFunction* function =
-            &binary_dispatch_table_[+op][+left_type][+right_type];
-        return function;
-    }
+    static const OperatorDispatcher shared;
 
-    [[nodiscard]] inline const UnaryOpFunction* find(TokenType op, const Value& right) const noexcept {
-        auto right_type = get_value_type(right);
+    // nullptr nếu toán tử không áp dụng được cho cặp kiểu này
+    [[nodiscard]] inline BinaryOpFunction find(TokenType op, const Value& left, const Value& right) const noexcept {
+        uint8_t row = binaryRows[+op];
+        if (row == NO_OPERATOR_ROW) {
+            return nullptr;
+        }
+        return binary_dispatch_table_[row][left.index()][right.index()];
+    }
 
-        const UnaryOpFunction* function = &unary_dispatch_table_[+op][+right_type];
-        return function;
+    [[nodiscard]] inline UnaryOpFunction find(TokenType op, const Value& right) const noexcept {
+        uint8_t row = unaryRows[+op];
+        if (row == NO_OPERATOR_ROW) {
+            return nullptr;
+        }
+        return unary_dispatch_table_[row][right.index()];
     }
 };
\ No newline at end of file
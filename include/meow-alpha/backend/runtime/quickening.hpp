@@ -0,0 +1,118 @@
+#pragma once
+
+#include "runtime/operator_dispatcher.hpp"
+#include <cstdint>
+#include <type_traits>
+
+struct Variable;
+
+// Quickening cho tree walker: nút AST tự chuyên biệt hoá theo những gì quan sát được lúc chạy.
+// Ở dạng generic, visit của nút báo điều vừa thấy qua observe(); thấy cùng một điều warmup lần liên tiếp
+// thì nút chuyển sang dạng chuyên biệt đó. Dạng chuyên biệt kiểm tra guard trước khi đi đường tắt,
+// trượt guard thì gọi deoptimize() và đi đường generic như chưa từng chuyên biệt hoá. Bị huỷ quá
+// maxDeopts lần thì nút ở lại dạng generic luôn, tránh đổi qua đổi lại mãi ở những chỗ không ổn định.
+// Form{} là dạng generic; observe() không ghi gì khi điều quan sát được trùng với lần trước.
+template <typename Form>
+struct Quickening {
+    static constexpr uint8_t warmup = 2;
+    static constexpr uint8_t maxDeopts = 4;
+
+    Form form{};
+
+    void observe(const Form& observed) {
+        if (observed == pending) {
+            if (hits < warmup && observed != Form{} && ++hits == warmup && deopts < maxDeopts) {
+                form = observed;
+            }
+            return;
+        }
+        pending = observed;
+        hits = 1;
+    }
+
+    void deoptimize() {
+        form = Form{};
+        pending = Form{};
+        hits = 0;
+        ++deopts;
+    }
+
+private:
+    Form pending{};
+    uint8_t hits = 0;
+    uint8_t deopts = 0;
+};
+
+// Dạng chuyên biệt của BinaryExpression: một hàm riêng cho từng cặp (toán tử, kiểu hai vế), tính
+// thẳng phép toán đó. Trả về false nếu hai vế không cùng kiểu đã chuyên biệt (hoặc là chia/modulo
+// Int cho 0), khi đó dùng TreeWalker::binary.
+using BinaryKernel = bool (*)(const Value& left, const Value& right, Value& result) noexcept;
+
+template <typename T, TokenType Op>
+bool binaryKernel(const Value& left, const Value& right, Value& result) noexcept {
+    auto a = std::get_if<T>(&left);
+    auto b = std::get_if<T>(&right);
+    if (a == nullptr || b == nullptr) {
+        return false;
+    }
+    if constexpr (std::is_same_v<T, Int>) {
+        return intBinary(Op, *a, *b, result);
+    } else {
+        return realBinary(Op, *a, *b, result);
+    }
+}
+
+// Kernel cho op với hai vế cùng kiểu T, nullptr nếu fastBinary không có đường tắt cho cặp này
+template <typename T>
+BinaryKernel findBinaryKernel(TokenType op) noexcept {
+    using enum TokenType;
+    constexpr bool isInt = std::is_same_v<T, Int>;
+
+    switch (op) {
+        case OP_PLUS:     return binaryKernel<T, OP_PLUS>;
+        case OP_MINUS:    return binaryKernel<T, OP_MINUS>;
+        case OP_MULTIPLY: return binaryKernel<T, OP_MULTIPLY>;
+        case OP_DIVIDE:   return binaryKernel<T, OP_DIVIDE>;
+        case OP_EQ:       return binaryKernel<T, OP_EQ>;
+        case OP_NEQ:      return binaryKernel<T, OP_NEQ>;
+        case OP_LT:       return binaryKernel<T, OP_LT>;
+        case OP_GT:       return binaryKernel<T, OP_GT>;
+        case OP_LE:       return binaryKernel<T, OP_LE>;
+        case OP_GE:       return binaryKernel<T, OP_GE>;
+        case OP_MODULO:   return isInt ? binaryKernel<T, OP_MODULO> : nullptr;
+        case OP_BIT_AND:  return isInt ? binaryKernel<T, OP_BIT_AND> : nullptr;
+        case OP_BIT_OR:   return isInt ? binaryKernel<T, OP_BIT_OR> : nullptr;
+        case OP_BIT_XOR:  return isInt ? binaryKernel<T, OP_BIT_XOR> : nullptr;
+        case OP_LSHIFT:   return isInt ? binaryKernel<T, OP_LSHIFT> : nullptr;
+        case OP_RSHIFT:   return isInt ? binaryKernel<T, OP_RSHIFT> : nullptr;
+        default:          return nullptr;
+    }
+}
+
+inline BinaryKernel findBinaryKernel(TokenType op, const Value& left, const Value& right) noexcept {
+    if (left.index() != right.index()) {
+        return nullptr;
+    }
+    if (std::holds_alternative<Int>(left)) {
+        return findBinaryKernel<Int>(op);
+    }
+    if (std::holds_alternative<Real>(left)) {
+        return findBinaryKernel<Real>(op);
+    }
+    return nullptr;
+}
+
+// Dạng chuyên biệt của IndexExpression
+enum class IndexQuickening : uint8_t {
+    Generic,
+    ArrayElement,   // mảng với chỉ số Int nằm trong giới hạn
+};
+
+// Dạng chuyên biệt của Identifier tìm theo tên (slot = -1): biến đã tìm thấy ngay trong môi trường
+// bắt đầu tìm, nhận ra môi trường đó qua Environment::identity()
+struct ResolvedVariable {
+    uint64_t environment = 0;
+    Variable* variable = nullptr;
+
+    bool operator==(const ResolvedVariable&) const = default;
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Gốc của mọi object trên heap mà Value trỏ tới (mảng, object, chuỗi, callable...).
+// Bộ đếm tham chiếu nằm ngay trong object nên Ref chỉ là một con trỏ 8 byte,
+// không cần control block riêng như std::shared_ptr.
+// Mỗi interpreter chạy trên một luồng nên mặc định bộ đếm là số nguyên thường;
+// build với MEOW_ATOMIC_REFCOUNT nếu cần chia sẻ giá trị giữa các luồng.
+class RefCounted {
+private:
+#ifdef MEOW_ATOMIC_REFCOUNT
+    mutable std::atomic<uint32_t> refCount{0};
+#else
+    mutable uint32_t refCount = 0;
+#endif
+
+public:
+    RefCounted() = default;
+    // Sao chép nội dung object không sao chép số tham chiếu của nó
+    RefCounted(const RefCounted&): refCount(0) {}
+    RefCounted& operator=(const RefCounted&) {
+        return *this;
+    }
+    virtual ~RefCounted() = default;
+
+#ifdef MEOW_ATOMIC_REFCOUNT
+    void retain() const noexcept {
+        refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() const noexcept {
+        if (refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    uint32_t useCount() const noexcept {
+        return refCount.load(std::memory_order_relaxed);
+    }
+#else
+    void retain() const noexcept {
+        ++refCount;
+    }
+
+    void release() const noexcept {
+        if (--refCount == 0) {
+            delete this;
+        }
+    }
+
+    uint32_t useCount() const noexcept {
+        return refCount;
+    }
+#endif
+};
+
+// Con trỏ có đếm tham chiếu kiểu intrusive, giao diện giống std::shared_ptr
+// (get, ->, *, so sánh với nullptr) để code cũ dùng Array, Object, Function... vẫn chạy.
+// Lưu con trỏ tới RefCounted nên sao chép và hủy không cần T là kiểu hoàn chỉnh;
+// RefCounted phải là lớp cơ sở đầu tiên để phép ép kiểu về T không phải dịch con trỏ.
+template <typename T>
+class Ref {
+private:
+    RefCounted* object = nullptr;
+
+    template <typename U>
+    friend class Ref;
+
+public:
+    using element_type = T;
+
+    Ref() noexcept = default;
+    Ref(std::nullptr_t) noexcept {}
+
+    explicit Ref(T* pointer) noexcept: object(pointer) {
+        if (object != nullptr) {
+            object->retain();
+        }
+    }
+
+    Ref(const Ref& other) noexcept: object(other.object) {
+        if (object != nullptr) {
+            object->retain();
+        }
+    }
+
+    Ref(Ref&& other) noexcept: object(std::exchange(other.object, nullptr)) {}
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    Ref(const Ref<U>& other) noexcept: Ref(other.get()) {}
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    Ref(Ref<U>&& other) noexcept: object(std::exchange(other.object, nullptr)) {}
+
+    ~Ref() {
+        if (object != nullptr) {
+            object->release();
+        }
+    }
+
+    Ref& operator=(const Ref& other) noexcept {
+        Ref(other).swap(*this);
+        return *this;
+    }
+
+    Ref& operator=(Ref&& other) noexcept {
+        Ref(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    Ref& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    void swap(Ref& other) noexcept {
+        std::swap(object, other.object);
+    }
+
+    void reset() noexcept {
+        Ref().swap(*this);
+    }
+
+    T* get() const noexcept {
+        return static_cast<T*>(object);
+    }
+
+    T* operator->() const noexcept {
+        return get();
+    }
+
+    T& operator*() const noexcept {
+        return *get();
+    }
+
+    explicit operator bool() const noexcept {
+        return object != nullptr;
+    }
+
+    uint32_t use_count() const noexcept {
+        return object != nullptr ? object->useCount() : 0;
+    }
+
+    template <typename U>
+    bool operator==(const Ref<U>& other) const noexcept {
+        return object == other.object;
+    }
+
+    bool operator==(std::nullptr_t) const noexcept {
+        return object == nullptr;
+    }
+};
+
+template <typename T, typename... Args>
+Ref<T> makeRef(Args&&... args) {
+    return Ref<T>(new T(std::forward<Args>(args)...));
+}
+
+template <typename T>
+struct std::hash<Ref<T>> {
+    size_t operator()(const Ref<T>& ref) const noexcept {
+        return std::hash<const void*>()(ref.get());
+    }
+};
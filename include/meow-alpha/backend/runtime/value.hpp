@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runtime/overload.hpp"
+#include "runtime/ref.hpp"
 #include "runtime/function_arity.hpp"
 #include "runtime/oop.hpp"
 #include "interface/indexable.hpp"
@@ -39,18 +40,18 @@ using Int = int64_t;
 using Real = double;
 using Bool = bool;
 using Str = std::string;
-using Array = std::shared_ptr<ArrayData>;
-using Object = std::shared_ptr<ObjectData>;
-using String = std::shared_ptr<StringData>;
-using Function = std::shared_ptr<Callable>;
+using Array = Ref<ArrayData>;
+using Object = Ref<ObjectData>;
+using String = Ref<StringData>;
+using Function = Ref<Callable>;
 
 using BaseValue = std::variant<Null, Int, Real, Bool, String, Array, Object, Function, Class, Instance, BoundMethod>;
 
 class Value : public BaseValue {
 public:
     Value() = default;
-    Value(const char* s) : BaseValue(std::make_shared<StringData>(s)) {}
-    Value(const std::string& s) : BaseValue(std::make_shared<StringData>(s)) {}
+    Value(const char* s) : BaseValue(makeRef<StringData>(s)) {}
+    Value(const std::string& s) : BaseValue(makeRef<StringData>(s)) {}
     template<typename T>
         requires (!std::is_same_v<std::decay_t<T>, Value> && !std::is_convertible_v<T, std::string>)
     Value(T&& t) : BaseValue(std::forward<T>(t)) {}
@@ -59,7 +60,7 @@ public:
 std::ostream& operator<<(std::ostream& os, const Value& v);
 Str toString(const Value& v);
 
-struct ArrayData: public Indexable, public Iterable, public Stringifiable, public std::enable_shared_from_this<ArrayData> {
+struct ArrayData: public RefCounted, public Indexable, public Iterable, public Stringifiable {
     std::vector<Value> elements;
 
     Value get(const Value& key) override;
@@ -104,7 +105,7 @@ struct std::hash<HashKey> {
     size_t operator()(const HashKey& key) const;
 };
 
-struct ObjectData: public Indexable, public Iterable, public Stringifiable, public std::enable_shared_from_this<ObjectData> {
+struct ObjectData: public RefCounted, public Indexable, public Iterable, public Stringifiable {
     std::unordered_map<HashKey, Value> pairs;
 
     Value get(const Value& key) override;
@@ -124,18 +125,45 @@ public:
     Value next() override;
 };
 
-struct StringData : public Indexable, public Iterable, public Stringifiable, public std::enable_shared_from_this<StringData> {
+// Chuỗi là bất biến nên hash chỉ cần tính một lần rồi giữ lại.
+// isInterned: chuỗi nằm trong bảng intern (xem runtime/intern.hpp), mỗi nội dung chỉ có đúng một atom.
+struct StringData : public RefCounted, public Indexable, public Iterable, public Stringifiable {
     std::string str;
+    bool isInterned = false;
+    mutable bool isHashed = false;
+    mutable size_t hashCode = 0;
 
     StringData(std::string val): str(std::move(val)) {}
     StringData(int count, char ch) : str(count, ch) {}
 
+    size_t hash() const {
+        if (!isHashed) {
+            hashCode = std::hash<Str>{}(str);
+            isHashed = true;
+        }
+        return hashCode;
+    }
+
     Value get(const Value& key) override;
     void set(const Value& key, const Value& value) override;
     std::unique_ptr<Iterator> makeIterator() override;
     std::string toString() const override;
 };
 
+// Hai atom khác con trỏ chắc chắn khác nội dung, nên chỉ phải so từng ký tự khi có chuỗi chưa intern
+inline bool stringEquals(const StringData* lhs, const StringData* rhs) {
+    if (lhs == rhs) {
+        return true;
+    }
+    if (lhs->isInterned && rhs->isInterned) {
+        return false;
+    }
+    if (lhs->isHashed && rhs->isHashed && lhs->hashCode != rhs->hashCode) {
+        return false;
+    }
+    return lhs->str == rhs->str;
+}
+
 class StringIterator : public Iterator {
 private:
     StringData* strData;
@@ -146,6 +174,10 @@ public:
     Value next() override;
 };
 
+// Hàm thư viện (chưa gắn receiver) mà receiver.name sẽ trả về dưới dạng bound function,
+// nullptr nếu receiver không phải mảng/chuỗi/object hoặc tên đó là dữ liệu chứ không phải phương thức
+Function findNativeMethod(const Value& receiver, const String& name);
+
 inline bool isTruthy(const Value& value) {
     return !std::holds_alternative<Null>(value) && (!std::holds_alternative<Bool>(value) || std::get<Bool>(value));
 }
@@ -161,4 +193,4 @@ auto visit(Visitor&& vis, const Value& val1, const Value& val2) {
         static_cast<const BaseValue&>(val1),
         static_cast<const BaseValue&>(val2)
     );
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "runtime/value.hpp"
+#include "runtime/native_fn.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Ngăn xếp giá trị của interpreter, nơi đặt tham số cho các lời gọi hàm.
+// Mỗi lời gọi lấy một đoạn liền nhau qua Frame rồi truyền cho hàm được gọi dưới dạng span.
+// Bộ nhớ chia thành các khối không bao giờ bị dời chỗ, nên span của lời gọi bên ngoài
+// vẫn hợp lệ khi lời gọi lồng bên trong đẩy thêm giá trị.
+class ValueStack {
+public:
+    static constexpr size_t blockSize = 1024;
+
+    // Đoạn tham số của một lời gọi, trả lại cho ngăn xếp khi ra khỏi scope (kể cả khi có exception)
+    class Frame {
+    private:
+        ValueStack& owner;
+        size_t savedBlock;
+        size_t savedTop;
+        Value* base;
+        size_t count = 0;
+
+    public:
+        // capacity là số giá trị tối đa sẽ push vào frame này
+        Frame(ValueStack& stack, size_t capacity);
+        ~Frame();
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        void push(Value value) {
+            base[count++] = std::move(value);
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        MutableArguments arguments() const {
+            return MutableArguments(base, count);
+        }
+    };
+
+private:
+    struct Block {
+        std::unique_ptr<Value[]> values;
+        size_t capacity;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0;
+    size_t top = 0;
+
+    Value* allocate(size_t count);
+};
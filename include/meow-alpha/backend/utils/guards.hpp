@@ -6,8 +6,16 @@
 
 class EnvGuard {
 public:
-    EnvGuard(std::shared_ptr<Environment>& envToManage): managedEnv(envToManage), originalEnv(envToManage) {
-        managedEnv = std::make_shared<Environment>(originalEnv);
+    EnvGuard(std::shared_ptr<Environment>& envToManage, const ScopeLayout* layout = nullptr): managedEnv(envToManage), originalEnv(envToManage) {
+        if (layout != nullptr && layout->isElided) {
+            return;
+        }
+        managedEnv = std::make_shared<Environment>(originalEnv, layout);
+    }
+
+    // Chạy trong một môi trường đã dựng sẵn (catch, thân hàm)
+    EnvGuard(std::shared_ptr<Environment>& envToManage, std::shared_ptr<Environment> replacement): managedEnv(envToManage), originalEnv(envToManage) {
+        managedEnv = std::move(replacement);
     }
 
     ~EnvGuard() {
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "visitor/visitor.hpp"
+#include "vm/chunk.hpp"
+#include "common/ast_arena.hpp"
+#include "common/token.hpp"
+#include <memory>
+#include <vector>
+
+struct LexicalAddress;
+
+// Biên dịch AST thành bytecode cho VirtualMachine.
+// Mỗi visit sinh lệnh vào chunk hiện tại; giá trị trả về của visit không dùng tới.
+// Biểu thức để lại đúng một giá trị trên ngăn xếp, câu lệnh không để lại gì.
+class BytecodeCompiler: Visitor {
+private:
+    // Những thứ cần dọn dẹp khi break/continue nhảy ra khỏi vòng lặp
+    enum class Unwind { Scope, Try, Catch, Iterator };
+
+    struct LoopContext {
+        bool isSwitch;
+        size_t unwindDepth;
+        std::vector<size_t> breakJumps;
+        std::vector<size_t> continueJumps;
+    };
+
+    std::unique_ptr<Chunk> chunk;
+    std::vector<Unwind> unwindStack;
+    std::vector<LoopContext> loops;
+    ASTNode* currentNode = nullptr;
+    // Phép gán ngoài cùng đang được biên dịch: lỗi của mọi lệnh bên trong được báo tại vị trí của nó
+    ASTNode* errorSite = nullptr;
+
+    size_t emit(OpCode op, uint32_t a = 0, uint16_t b = 0);
+    size_t emitJump(OpCode op);
+    void patchJump(size_t at);
+    void patchJump(size_t at, size_t target);
+    void emitUnwind(size_t depth);
+
+    uint32_t addConstant(Value value);
+    uint32_t addName(const std::string& name);
+    uint32_t addChild(ASTNode* node);
+    uint16_t addPropertyCache();
+    uint32_t addLayout(const ScopeLayout* layout);
+
+    // Chọn lệnh theo slot hoặc theo tên tùy địa chỉ Resolver đã tính
+    void emitLoad(const std::string& name, const LexicalAddress& address);
+    void emitStore(const std::string& name, const LexicalAddress& address);
+    void emitDefine(Identifier* name, bool isConstant = false);
+    void emitUpdate(Identifier* name, uint16_t flags);
+
+    void compile(ASTNode* node);
+    // Scope được Resolver đánh dấu isElided không sinh PUSH_SCOPE/POP_SCOPE
+    void beginScope(const ScopeLayout& layout);
+    void endScope(const ScopeLayout& layout);
+
+    void compileStatements(const std::vector<AstPtr<Statement>>& statements);
+    void compileArguments(const std::vector<AstPtr<Expression>>& elements, bool& hasSpread);
+    void compileAssignment(AssignmentExpression* node);
+
+    void beginLoop(bool isSwitch = false);
+    void endLoop(size_t breakTarget, size_t continueTarget);
+
+public:
+    std::unique_ptr<Chunk> compileProgram(Program* program);
+    std::unique_ptr<Chunk> compileBody(ASTNode* body);
+    std::unique_ptr<Chunk> compileBlock(BlockStatement* block);
+
+    Value visit(Program* node) override;
+
+    Value visit(IntegerLiteral* node) override;
+    Value visit(RealLiteral* node) override;
+    Value visit(StringLiteral* node) override;
+    Value visit(BooleanLiteral* node) override;
+    Value visit(NullLiteral* node) override;
+    Value visit(ArrayLiteral* node) override;
+    Value visit(ObjectLiteral* node) override;
+    Value visit(FunctionLiteral* node) override;
+    Value visit(TemplateLiteral* node) override;
+
+    Value visit(Identifier* node) override;
+    Value visit(BinaryExpression* node) override;
+    Value visit(UnaryExpression* node) override;
+    Value visit(CallExpression* node) override;
+    Value visit(IndexExpression* node) override;
+    Value visit(AssignmentExpression* node) override;
+    Value visit(TernaryExpression* node) override;
+    Value visit(PropertyAccess* node) override;
+    Value visit(PropertyAssignment* node) override;
+    Value visit(ThisExpression* node) override;
+    Value visit(SuperExpression* node) override;
+    Value visit(NewExpression* node) override;
+    Value visit(PrefixUpdateExpression* node) override;
+    Value visit(PostfixUpdateExpression* node) override;
+    Value visit(SpreadExpression* node) override;
+
+    Value visit(LetStatement* node) override;
+    Value visit(ReturnStatement* node) override;
+    Value visit(BreakStatement* node) override;
+    Value visit(ContinueStatement* node) override;
+    Value visit(ThrowStatement* node) override;
+    Value visit(IfStatement* node) override;
+    Value visit(WhileStatement* node) override;
+    Value visit(ForStatement* node) override;
+    Value visit(ForInStatement* node) override;
+    Value visit(BlockStatement* node) override;
+    Value visit(ClassStatement* node) override;
+    Value visit(ImportStatement* node) override;
+    Value visit(ExportStatement* node) override;
+    Value visit(TryStatement* node) override;
+    Value visit(ExpressionStatement* node) override;
+    Value visit(LogStatement* node) override;
+    Value visit(SwitchCase* node) override;
+    Value visit(SwitchStatement* node) override;
+    Value visit(DoWhileStatement* node) override;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "visitor/tree_walker.hpp"
+#include <functional>
+#include <unordered_map>
+
+// Backend closure (--backend=closure): mỗi thân hàm được duyệt một lần để dựng thành cây closure C++,
+// các lần gọi sau chỉ chạy closure. Loại node, toán tử và các closure con đã được chọn xong lúc dựng,
+// nên lúc chạy không còn accept/visit hay dynamic_cast.
+//
+// Đây vẫn là một TreeWalker: môi trường, completion, lời gọi hàm, lỗi và thông báo lỗi dùng chung code
+// với TreeWalker, nên MeowScriptFunction, NativeCallable và thư viện native chạy y như cũ.
+// Những node hiếm gặp (class, import, try, switch, ...) không được dịch mà giao lại cho TreeWalker.
+class ClosureCompiler : public TreeWalker {
+public:
+    using StmtCode = std::function<void()>;
+
+    using TreeWalker::TreeWalker;
+
+    // Chạy cả chương trình, tương đương TreeWalker::visit(Program*)
+    Value run(Program* program);
+
+    void runBody(ASTNode* body) override;
+
+private:
+    // Thân hàm đã dịch, theo node thân hàm
+    std::unordered_map<ASTNode*, StmtCode> bodies;
+
+    const StmtCode& body(Statement* statement);
+
+    ExprCode compile(Expression* expression);
+    StmtCode compile(Statement* statement);
+    std::vector<StmtCode> compile(const std::vector<StmtPtr>& statements);
+
+    ExprCode compileIdentifier(Identifier* node);
+    ExprCode compileBinary(BinaryExpression* node);
+    ExprCode compileCall(CallExpression* node);
+    template <typename IntOp>
+    ExprCode compileIntBinary(BinaryExpression* node, IntOp op);
+
+    StmtCode compileBlock(BlockStatement* node);
+    StmtCode compileIf(IfStatement* node);
+    StmtCode compileWhile(WhileStatement* node);
+    StmtCode compileFor(ForStatement* node);
+    StmtCode compileForIn(ForInStatement* node);
+    StmtCode compileDoWhile(DoWhileStatement* node);
+
+    // Node không được dịch: để TreeWalker duyệt như bình thường
+    ExprCode fallback(Expression* expression);
+    StmtCode fallback(Statement* statement);
+};
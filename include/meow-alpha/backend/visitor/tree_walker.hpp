@@ -8,29 +8,114 @@
 #include "native_lib/standard_lib.hpp"
 #include "module/module_manager.hpp"
 #include "diagnostics/meow_exceptions.hpp"
+#include "jit/loop_jit.hpp"
 #include <stdexcept>
+#include <functional>
 #include <optional>
 
 Value interpret(Program* program);
 
+// Vế trái của phép gán và ++/--: chỉ ghi lại chỗ lưu trữ, TreeWalker đọc/ghi trực tiếp
+// vào biến, phần tử hoặc trường qua con trỏ chứ không qua callback
 struct LValue {
-    Value currentValue;
-    std::function<void(const Value&)> setter;
+    enum class Kind : uint8_t {
+        Variable,       // biến đã khai báo, variable trỏ thẳng vào nó
+        Undeclared,     // chưa có biến nào tên này, gán sẽ tạo mới qua environment
+        Element,        // container[key]
+        Field,          // trường của instance, đi qua inline cache của PropertyAccess
+    };
+
+    Kind kind;
+    Variable* variable = nullptr;
+    Environment* environment = nullptr;
+    Identifier* identifier = nullptr;
+    Value container;
+    Value key;
+    PropertyAccess* access = nullptr;
+
+    explicit LValue(Kind kind): kind(kind) {}
+};
+
+// return/break/continue không ném exception mà để lại một completion record,
+// được truyền ngược lên qua block, vòng lặp, switch tới nơi tiêu thụ nó
+enum class CompletionType {
+    Normal,
+    Return,
+    Break,
+    Continue,
+    TailCall,   // như Return, nhưng giá trị trả về là kết quả của lời gọi đang chờ trong TreeWalker::tailCall
+};
+
+struct Completion {
+    CompletionType type = CompletionType::Normal;
+    Value value;
 };
 
-class TreeWalker: Visitor, Interpreter {
-private:
+// Lời gọi ở vị trí đuôi đã tính xong callee và tham số, chờ exec chạy thân hàm trong frame mới
+struct TailCall {
+    CallExpression* site = nullptr;
+    ASTNode* body = nullptr;
+    std::shared_ptr<Environment> frame;
+};
+
+// Cách tính một biểu thức con: TreeWalker duyệt node, ClosureCompiler chạy closure đã dựng sẵn
+using ExprCode = std::function<Value()>;
+
+class TreeWalker: Visitor, protected Interpreter {
+protected:
     std::shared_ptr<Environment> env;
     std::shared_ptr<Environment> globalEnv;
     std::optional<Value> currentlyCaughtException;
+    Completion completion;
+    TailCall tailCall;
 
     ModuleManager* moduleManager;
     SrcFilePtr currSrcFile;
     Value* currModuleExports;
 
     LValue resolveLValue(ASTNode* node);
+    Variable* lookupVariable(Identifier* node, Environment* target);
+    const Value* variableStorage(Expression* expression);
+    Value readLValue(const LValue& target);
+    void writeLValue(const LValue& target, const Value& value);
+    Value* lvalueStorage(const LValue& target);
+    Value updateLValue(ASTNode* operand, TokenType op, const Token& token, bool returnsOld);
+    void evaluateArguments(CallExpression* node, std::vector<Value>& args);
+    // Phần của từng loại node chạy sau khi các biểu thức con đã được tính, dùng chung với ClosureCompiler
+    Value unary(UnaryExpression* node, const Value& operand);
+    Value binary(BinaryExpression* node, const Value& left, const Value& right);
+    Value element(IndexExpression* node, const Value& left, const Value& index);
+    // Template để lời gọi evaluateValue không phải qua std::function; bản cho ExprCode được
+    // instantiate sẵn trong expression.cpp cho ClosureCompiler
+    template <typename EvaluateValue>
+    Value assign(AssignmentExpression* node, const EvaluateValue& evaluateValue);
+    Value finishCall(CallExpression* node, const Value& callee, const Value& receiver, const Function& method, MutableArguments args);
+    bool prepareTailCall(CallExpression* node, const Value& callee, const Value& receiver, const Function& method, MutableArguments args);
+    void runTailCall();
+    void rethrowAtCallSite(CallExpression* node);
+    // Chạy thân hàm trong env hiện tại: TreeWalker duyệt cây, ClosureCompiler chạy closure đã dịch
+    virtual void runBody(ASTNode* body);
+    Value getProperty(PropertyAccess* node, const Value& object);
+    Value callMethod(PropertyAccess* node, const Value& receiver, const Function& method, MutableArguments args);
+    Value callFrame(const Value& callee, MutableArguments args);
+    void defineIdentifier(Identifier* name, const Value& value, bool isConstant = false);
+
+    inline bool isAbrupt() const {
+        return completion.type != CompletionType::Normal;
+    }
+    bool exitsLoop();
+    Value takeReturnValue();
+
+    const OperatorDispatcher* opDispatcher = &OperatorDispatcher::shared;
 
-    std::unique_ptr<OperatorDispatcher> opDispatcher;
+    // Chỉ có khi chạy với --jit
+    std::unique_ptr<LoopJit> jit;
+
+    // Đếm lượt của một lần vào vòng lặp; vừa đủ nóng thì giao phần còn lại cho LoopJit.
+    // true nếu mã máy đã chạy xong cả vòng lặp
+    inline bool finishesNatively(Statement* loop, uint32_t& iterations) {
+        return jit != nullptr && ++iterations == LoopJit::hotIterations && jit->run(loop, env.get());
+    }
 
     std::vector<std::string> argv;
 public:
@@ -47,12 +132,12 @@ public:
 
     Value visit(Program* node) override;
 
-    Value call(const Value &callee, const std::vector<Value>& args) override;
+    Value call(const Value &callee, Arguments args) override;
     inline void throwRuntimeErr(const Token& token, const std::string& message) override {
         throw Diagnostic::RuntimeErr(message, token);
     };
 
-    void execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) override;
+    Value execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) override;
 
     inline std::shared_ptr<Environment> getCurrEnv() const override {
         return this->env;
@@ -67,6 +152,8 @@ public:
     }
 
     void loadLibrary(std::unique_ptr<NativeLibrary> library);
+    // Bật LoopJit nếu nền tảng hỗ trợ và không bị tắt bằng MEOW_JIT=0
+    void enableJit();
     void initCommon();
 
     inline void setCaughtException(const Value& v) { 
@@ -123,4 +210,4 @@ public:
     Value visit(SwitchCase* node) override;
     Value visit(SwitchStatement* node) override;
     Value visit(DoWhileStatement* node) override;
-};
\ No newline at end of file
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "runtime/value.hpp"
+#include "runtime/inline_cache.hpp"
+#include "common/scope_layout.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct ASTNode;
+
+enum class OpCode : uint8_t {
+    // Hằng số và ngăn xếp
+    PUSH_CONST,         // a = chỉ số hằng
+    PUSH_NULL,
+    PUSH_TRUE,
+    PUSH_FALSE,
+    POP,
+    DUP,
+    DUP2,
+
+    // Biến (tra theo tên)
+    LOAD_NAME,          // a = chỉ số tên, b = độ sâu + 1 (0: tìm qua cả chuỗi scope)
+    STORE_NAME,         // a = chỉ số tên, b như LOAD_NAME, giữ giá trị trên đỉnh ngăn xếp
+    DEFINE_NAME,        // a = chỉ số tên, b = 1 nếu là hằng
+    LOAD_THIS,          // b như LOAD_NAME
+    LOAD_SLOT,          // a = slot, b = độ sâu môi trường
+    STORE_SLOT,         // a = slot, b = độ sâu môi trường, giữ giá trị trên đỉnh ngăn xếp
+    DEFINE_SLOT,        // a = slot, b = 1 nếu là hằng
+
+    // Phạm vi
+    PUSH_SCOPE,         // a = chỉ số bố cục trong layouts
+    POP_SCOPE,
+
+    // Toán tử
+    BINARY,             // b = TokenType
+    UNARY,              // b = TokenType
+    COMPOUND,           // b = TokenType của phép toán gốc (+= -> +)
+    CASE_EQ,
+
+    // Rẽ nhánh
+    JUMP,               // a = đích
+    JUMP_IF_FALSE,      // a = đích, pop điều kiện
+    JUMP_IF_TRUE,       // a = đích, pop điều kiện
+    JUMP_IF_FALSE_KEEP, // a = đích, giữ giá trị nếu nhảy
+    JUMP_IF_TRUE_KEEP,  // a = đích, giữ giá trị nếu nhảy
+    JUMP_IF_NOT_NULL_KEEP,
+
+    // Gọi hàm
+    CALL,               // a = số tham số
+    CALL_ARRAY,         // tham số đã gom sẵn trong một mảng (có spread)
+    GET_METHOD,         // a = chỉ số tên, b = chỉ số inline cache; đẩy [phương thức, receiver]
+                        // hoặc [giá trị thuộc tính, null] nếu không gọi thẳng được
+    CALL_METHOD,        // a = chỉ số tên, b = số tham số; gọi cặp do GET_METHOD để lại
+    RETURN,
+
+    // Cấu trúc dữ liệu
+    MAKE_ARRAY,         // a = số phần tử
+    ARRAY_APPEND,
+    ARRAY_SPREAD,
+    MAKE_OBJECT,        // a = số cặp key/value
+    MAKE_TEMPLATE,      // a = số phần
+    CLOSURE,            // a = chỉ số FunctionLiteral
+
+    // Truy cập
+    GET_INDEX,
+    SET_INDEX,
+    GET_PROP,           // a = chỉ số tên, b = chỉ số inline cache
+    GET_FIELD,          // a = chỉ số tên, b như GET_PROP, đọc giá trị hiện tại cho phép gán kép
+    SET_PROP,           // a = chỉ số tên, b như GET_PROP
+    UPDATE_NAME,        // a = chỉ số tên, b = cờ UpdateFlag | (độ sâu + 1) << UPDATE_DEPTH_SHIFT
+    UPDATE_SLOT,        // a = slot, b = cờ UpdateFlag | độ sâu << UPDATE_DEPTH_SHIFT
+    UPDATE_INDEX,       // b = cờ UpdateFlag
+    UPDATE_PROP,        // a = chỉ số tên, b = cờ UpdateFlag
+    SUPER,              // a = chỉ số node
+
+    // Vòng lặp for-in
+    GET_ITER,
+    FOR_ITER,           // a = đích khi hết phần tử
+    END_ITER,
+
+    // Ngoại lệ
+    TRY_BEGIN,          // a = đích của khối catch
+    TRY_END,
+    SET_CAUGHT,
+    CLEAR_CAUGHT,
+    THROW,
+    RETHROW,
+    THROW_BREAK,
+    THROW_CONTINUE,
+
+    // Class và module
+    CLASS,              // a = chỉ số node, b = 1 nếu có class cha
+    METHOD,             // a = chỉ số FunctionLiteral, b = chỉ số tên
+    SET_STATIC,         // a = chỉ số tên
+    IMPORT,             // a = chỉ số node
+    EXPORT_CHECK,
+    EXPORT_NAME,        // a = chỉ số tên
+
+    LOG,
+    RAISE,              // a = chỉ số hằng chứa thông báo lỗi
+    HALT,
+
+    _TOTAL_OPCODES
+};
+
+enum UpdateFlag : uint16_t {
+    UPDATE_DECREMENT = 1 << 0,
+    UPDATE_POSTFIX = 1 << 1,
+};
+
+constexpr int UPDATE_DEPTH_SHIFT = 2;
+
+// Giá trị b của GET_PROP/GET_FIELD/SET_PROP khi chunk đã hết chỗ cho inline cache
+constexpr uint16_t NO_PROPERTY_CACHE = UINT16_MAX;
+
+struct Instruction {
+    OpCode op;
+    uint16_t b = 0;
+    uint32_t a = 0;
+};
+
+static_assert(sizeof(Instruction) == 8, "Instruction phải gọn trong 8 byte");
+
+struct Chunk {
+    std::vector<Instruction> code;
+    // node tương ứng với từng lệnh, chỉ dùng để báo lỗi
+    std::vector<ASTNode*> nodes;
+    // node mà TreeWalker cuối cùng gắn vị trí vào lỗi runtime của từng lệnh: phép gán ngoài cùng
+    // bao quanh lệnh, nếu không có thì chính node của lời gọi/truy cập phần tử/thuộc tính;
+    // nullptr nếu lỗi cứ thế lan ra
+    std::vector<ASTNode*> errorSites;
+
+    std::vector<Value> constants;
+    std::vector<std::string> names;
+    // Giá trị chuỗi dựng sẵn của names, dùng làm key khi truy cập thuộc tính
+    std::vector<Value> nameValues;
+    std::vector<ASTNode*> children;
+    // Bố cục slot cho PUSH_SCOPE, trỏ vào node AST tạo scope
+    std::vector<const ScopeLayout*> layouts;
+    // Inline cache của các lệnh truy cập thuộc tính, được cập nhật trong lúc chạy
+    mutable std::vector<PropertyCache> propertyCaches;
+
+    std::unordered_map<std::string, uint32_t> nameIndex;
+};
+
+// Bộ nhớ đệm bytecode theo node AST: thân hàm chỉ được biên dịch một lần.
+// Được chia sẻ giữa các VM của cùng một ModuleManager vì hàm có thể được
+// gọi từ module khác với module đã định nghĩa nó.
+struct ChunkCache {
+    std::unordered_map<const ASTNode*, std::unique_ptr<Chunk>> bodies;
+    std::unordered_map<const ASTNode*, std::unique_ptr<Chunk>> blocks;
+};
+
+std::string_view opCodeName(OpCode op);
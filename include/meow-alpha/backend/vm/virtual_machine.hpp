@@ -0,0 +1,100 @@
+#pragma once
+
+#include "runtime/operator_dispatcher.hpp"
+#include "runtime/interpreter.hpp"
+#include "runtime/environment.hpp"
+#include "common/source_file.hpp"
+#include "native_lib/standard_lib.hpp"
+#include "module/module_manager.hpp"
+#include "vm/chunk.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct Program;
+struct ImportStatement;
+struct Identifier;
+class MeowScriptFunction;
+
+// Backend chạy bytecode do BytecodeCompiler sinh ra.
+// Dùng chung Environment, Value và các callable với TreeWalker nên hai backend
+// có thể gọi hàm và dùng object của nhau.
+class VirtualMachine: Interpreter {
+private:
+    struct Handler {
+        size_t target;
+        size_t stackSize;
+        size_t scopeDepth;
+        size_t iteratorDepth;
+    };
+
+    struct IteratorState {
+        Value collection;
+        std::unique_ptr<Iterator> iterator;
+    };
+
+    std::shared_ptr<Environment> env;
+    std::shared_ptr<Environment> globalEnv;
+    std::optional<Value> caughtException;
+
+    ModuleManager* moduleManager = nullptr;
+    SrcFilePtr currSrcFile;
+    Value* currModuleExports = nullptr;
+
+    const OperatorDispatcher* opDispatcher = &OperatorDispatcher::shared;
+
+    std::vector<std::string> argv;
+
+    ChunkCache* cache;
+    std::unique_ptr<ChunkCache> ownedCache;
+
+    std::vector<Value> stack;
+    std::vector<std::shared_ptr<Environment>> scopes;
+    std::vector<Handler> handlers;
+    std::vector<IteratorState> iterators;
+
+    Value run(const Chunk& chunk, std::shared_ptr<Environment> local, bool& returned);
+    Value invoke(MeowScriptFunction* function, std::shared_ptr<Environment> frame);
+    Value getProperty(const Value& object, const Value& key, PropertyCache* cache, const Token& token);
+    Value callMethod(const Value& receiver, const Function& method, MutableArguments args);
+    Value callFrame(const Value& callee, MutableArguments args);
+
+    const Chunk& bodyChunk(ASTNode* body);
+    const Chunk& blockChunk(BlockStatement* block);
+
+    void importModule(ImportStatement* node, const Value& pathValue);
+    void defineIdentifier(Identifier* name, const Value& value, bool isConstant = false);
+    void addToExports(const std::string& name, const Value& value);
+
+    void loadLibrary(std::unique_ptr<NativeLibrary> library);
+    void initCommon();
+
+public:
+    VirtualMachine();
+    VirtualMachine(ModuleManager* manager, SrcFilePtr sourceFile, Value* exp, const std::vector<std::string>& a, ChunkCache* sharedCache);
+
+    bool isModuleContext = false;
+
+    Value runProgram(Program* program);
+
+    Value call(const Value& callee, Arguments args) override;
+    Value execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) override;
+    Value exec(ASTNode* node, std::shared_ptr<Environment> local) override;
+
+    inline void throwRuntimeErr(const Token& token, const std::string& message) override {
+        throw Diagnostic::RuntimeErr(message, token);
+    }
+
+    inline std::shared_ptr<Environment> getCurrEnv() const override {
+        return this->env;
+    }
+
+    inline std::shared_ptr<Environment> getGlobalEnv() const override {
+        return this->globalEnv;
+    }
+
+    inline std::vector<std::string> getArgv() const override {
+        return this->argv;
+    }
+};
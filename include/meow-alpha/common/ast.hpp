@@ -1,6 +1,10 @@
 #pragma once
 
+#include "common/ast_arena.hpp"
 #include "common/token.hpp"
+#include "common/scope_layout.hpp"
+#include "runtime/inline_cache.hpp"
+#include "runtime/quickening.hpp"
 #include "visitor/visitor.hpp"
 #include <memory>
 #include <cstdint>
@@ -12,13 +16,22 @@ struct ASTNode;
 struct Expression;
 struct Statement;
 
-using ASTNodePtr = std::unique_ptr<ASTNode>;
-using ExprPtr = std::unique_ptr<Expression>;
-using StmtPtr = std::unique_ptr<Statement>;
+using ASTNodePtr = AstPtr<ASTNode>;
+using ExprPtr = AstPtr<Expression>;
+using StmtPtr = AstPtr<Statement>;
 
 struct Identifier;
 
-using IdenPtr = std::unique_ptr<Identifier>;
+using IdenPtr = AstPtr<Identifier>;
+
+// Địa chỉ từ vựng do Resolver tính: số Environment phải đi lên từ môi trường hiện tại
+// và chỉ số slot của biến trong môi trường đó.
+// depth = -1 nghĩa là chưa phân giải được, lúc chạy phải tìm theo tên qua cả chuỗi scope.
+// slot = -1 nghĩa là môi trường đó lưu theo tên (scope gốc, hoặc tên đến từ import *).
+struct LexicalAddress {
+    int depth = -1;
+    int slot = -1;
+};
 
 enum class NodeType {
     PROGRAM,
@@ -95,7 +108,10 @@ struct Statement : ASTNode {
 
 struct Identifier: Expression {
     std::string name;
-    Identifier(Token token): Expression(EXPR_IDENTIFIER, std::move(token)), name(this->token.lexeme) {}
+    LexicalAddress address;
+    // Dạng chuyên biệt mà tree walker đang dùng để đọc/ghi tên này khi slot = -1
+    Quickening<ResolvedVariable> quickening;
+    Identifier(Token token): Expression(EXPR_IDENTIFIER, std::move(token)), name(this->token.lexeme()) {}
 
     Value accept(Visitor* visitor) override {
         return visitor->visit(this);
@@ -106,6 +122,8 @@ struct BinaryExpression: Expression {
     ExprPtr left;
     TokenType op;
     ExprPtr right;
+    // Dạng chuyên biệt mà tree walker đang dùng cho nút này
+    Quickening<BinaryKernel> quickening;
 
     BinaryExpression(Token token, ExprPtr l, ExprPtr r): Expression(EXPR_BINARY, std::move(token)), left(std::move(l)), op(this->token.type), right(std::move(r)) {}
 
@@ -128,8 +146,17 @@ struct UnaryExpression: Expression {
 struct CallExpression: Expression {
     ExprPtr callee;
     std::vector<ExprPtr> args;
+    // Có tham số dạng ...x hay không, tính một lần lúc parse để lúc chạy biết trước số tham số
+    bool hasSpread = false;
+    // return f(...) trong thân hàm và không nằm trong try: Resolver đánh dấu để TreeWalker
+    // chạy hàm được gọi thay cho hàm hiện tại thay vì gọi lồng vào
+    bool isTailCall = false;
 
-    CallExpression(Token token, ExprPtr callee, std::vector<ExprPtr> args): Expression(EXPR_CALL, std::move(token)), callee(std::move(callee)), args(std::move(args)) {}
+    CallExpression(Token token, ExprPtr callee, std::vector<ExprPtr> args): Expression(EXPR_CALL, std::move(token)), callee(std::move(callee)), args(std::move(args)) {
+        for (const auto& arg : this->args) {
+            hasSpread = hasSpread || arg->type == EXPR_SPREAD;
+        }
+    }
 
     Value accept(Visitor* visitor) override {
         return visitor->visit(this);
@@ -139,6 +166,8 @@ struct CallExpression: Expression {
 struct IndexExpression: Expression {
     ExprPtr left;
     ExprPtr index;
+    // Dạng chuyên biệt mà tree walker đang dùng cho nút này
+    Quickening<IndexQuickening> quickening;
 
     IndexExpression(Token token, ExprPtr l, ExprPtr i): Expression(EXPR_INDEX, std::move(token)), left(std::move(l)), index(std::move(i)) {}
 
@@ -171,9 +200,13 @@ struct TernaryExpression: Expression {
 struct PropertyAccess: Expression {
     ExprPtr object;
     IdenPtr property;
+    // Tên thuộc tính đã intern sẵn lúc parse, dùng thẳng làm key khi tra cứu
+    String key;
+    // Inline cache của tree walker cho vị trí truy cập này
+    PropertyCache cache;
 
-    PropertyAccess(Token token, ExprPtr obj, IdenPtr prop)
-        : Expression(EXPR_PROPERTY_ACCESS, std::move(token)), object(std::move(obj)), property(std::move(prop)) {}
+    PropertyAccess(Token token, ExprPtr obj, IdenPtr prop, String k)
+        : Expression(EXPR_PROPERTY_ACCESS, std::move(token)), object(std::move(obj)), property(std::move(prop)), key(std::move(k)) {}
 
     Value accept(Visitor* visitor) override {
         return visitor->visit(this);
@@ -194,6 +227,8 @@ struct PropertyAssignment: Expression {
 };
 
 struct ThisExpression: Expression {
+    LexicalAddress address;
+
     ThisExpression(Token token): Expression(EXPR_THIS, std::move(token)) {}
 
     Value accept(Visitor* visitor) override {
@@ -275,7 +310,8 @@ struct RealLiteral: Expression {
 
 struct StringLiteral: Expression {
     std::string value;
-    StringLiteral(Token token): Expression(EXPR_LITERAL_STRING, std::move(token)), value(this->token.lexeme) {}
+    String atom;
+    StringLiteral(Token token, String a): Expression(EXPR_LITERAL_STRING, std::move(token)), value(this->token.lexeme()), atom(std::move(a)) {}
 
     Value accept(Visitor* visitor) override {
         return visitor->visit(this);
@@ -324,6 +360,7 @@ struct FunctionLiteral : Expression {
     std::vector<IdenPtr> parameters;
     StmtPtr body;
     IdenPtr restParam;
+    ScopeLayout scope;
 
     FunctionLiteral(Token token, std::vector<IdenPtr> p, StmtPtr b, IdenPtr r = nullptr): Expression(EXPR_LITERAL_FUNCTION, std::move(token)), parameters(std::move(p)), body(std::move(b)), restParam(std::move(r)) {}
 
@@ -394,6 +431,7 @@ struct IfStatement: Statement {
     ExprPtr condition;
     StmtPtr thenBranch;
     StmtPtr elseBranch;
+    ScopeLayout scope;
 
     IfStatement(Token token, ExprPtr c, StmtPtr t, StmtPtr e = nullptr): Statement(STMT_IF, std::move(token)), condition(std::move(c)), thenBranch(std::move(t)), elseBranch(std::move(e)) {}
 
@@ -405,6 +443,7 @@ struct IfStatement: Statement {
 struct WhileStatement: Statement {
     ExprPtr condition;
     StmtPtr body;
+    ScopeLayout scope;
 
     WhileStatement(Token token, ExprPtr c, StmtPtr b): Statement(STMT_WHILE, std::move(token)), condition(std::move(c)), body(std::move(b)) {}
 
@@ -418,6 +457,7 @@ struct ForStatement: Statement {
     ExprPtr condition;
     ExprPtr update;
     StmtPtr body;
+    ScopeLayout scope;
 
     ForStatement(Token token, StmtPtr i, ExprPtr c, ExprPtr u, StmtPtr b): Statement(STMT_FOR, std::move(token)), init(std::move(i)), condition(std::move(c)), update(std::move(u)), body(std::move(b)) {}
 
@@ -430,6 +470,7 @@ struct ForInStatement: Statement {
     IdenPtr variable;
     ExprPtr collection;
     StmtPtr body;
+    ScopeLayout scope;
 
     ForInStatement(Token token, IdenPtr var, ExprPtr collect, StmtPtr stmt): Statement(STMT_FOR_IN, std::move(token)), variable(std::move(var)), collection(std::move(collect)), body(std::move(stmt)) {}
 
@@ -440,6 +481,7 @@ struct ForInStatement: Statement {
 
 struct BlockStatement : Statement {
     std::vector<StmtPtr> statements;
+    ScopeLayout scope;
 
     BlockStatement(Token token) : Statement(STMT_BLOCK, std::move(token)) {}
     BlockStatement(Token token, std::vector<StmtPtr> s): Statement(STMT_BLOCK, std::move(token)), statements(std::move(s)) {}
@@ -498,6 +540,7 @@ struct TryStatement: Statement {
     StmtPtr tryBlock;
     IdenPtr catchVariable;
     StmtPtr catchBlock;
+    ScopeLayout catchScope;
 
     TryStatement(Token token, StmtPtr tb, IdenPtr cv, StmtPtr cb)
         : Statement(STMT_TRY, std::move(token)), tryBlock(std::move(tb)), catchVariable(std::move(cv)), catchBlock(std::move(cb)) {}
@@ -520,9 +563,9 @@ struct SwitchCase: ASTNode {
 
 struct SwitchStatement: Statement {
     ExprPtr value;
-    std::vector<std::unique_ptr<SwitchCase>> cases;
+    std::vector<AstPtr<SwitchCase>> cases;
 
-    SwitchStatement(Token token, ExprPtr val, std::vector<std::unique_ptr<SwitchCase>> c): Statement(STMT_SWITCH, std::move(token)), value(std::move(val)), cases(std::move(c)) {}
+    SwitchStatement(Token token, ExprPtr val, std::vector<AstPtr<SwitchCase>> c): Statement(STMT_SWITCH, std::move(token)), value(std::move(val)), cases(std::move(c)) {}
 
     Value accept(Visitor* visitor) override {
         return visitor->visit(this);
@@ -559,12 +602,13 @@ struct LogStatement: Statement {
 };
 
 
+// arena đứng trước body nên bị huỷ sau cùng: destructor của mọi node chạy xong rồi bộ nhớ mới được trả
 struct Program: ASTNode {
+    AstArena arena;
     std::vector<StmtPtr> body;
-    Program(): ASTNode(PROGRAM, Token(TokenType::UNKNOWN, "[root]", "[unknown file]", 0, 0, nullptr)) {}
-    Program(std::vector<StmtPtr> stmts) : ASTNode(PROGRAM, Token(TokenType::UNKNOWN, "[root]", "[unknown file]", 0, 0, nullptr)), body(std::move(stmts)) {}
+    Program(): ASTNode(PROGRAM, Token(TokenType::UNKNOWN, 0, Token::noPosition, "[root]")) {}
 
     Value accept(Visitor* visitor) override {
         return visitor->visit(this);
     }
-};
\ No newline at end of file
+};
\ No newline at end of file
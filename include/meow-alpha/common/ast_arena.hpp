@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Node AST không được cấp phát riêng lẻ bằng new/delete mà cắt liên tiếp từ các khối lớn của AstArena
+// do Program sở hữu: parse nhanh hơn, các node gần nhau nằm sát nhau trong bộ nhớ, và cả cây được trả
+// về cho hệ thống một lần khi Program bị huỷ.
+// AstPtr vẫn là chủ sở hữu duy nhất của node như unique_ptr thường (thay node, move node giữa các cha
+// như cũ), chỉ khác ở chỗ xoá node thì gọi destructor chứ không giải phóng bộ nhớ: phần đó thuộc arena.
+struct AstDeleter {
+    template <typename T>
+    void operator()(T* node) const {
+        node->~T();
+    }
+};
+
+template <typename T>
+using AstPtr = std::unique_ptr<T, AstDeleter>;
+
+class AstArena {
+public:
+    AstArena() = default;
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    template <typename T, typename... Args>
+    AstPtr<T> make(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        return AstPtr<T>(new (memory) T(std::forward<Args>(args)...));
+    }
+
+    // Tổng số byte đã cấp từ hệ thống (để đo)
+    size_t reservedBytes() const {
+        return reserved;
+    }
+
+private:
+    static constexpr size_t blockSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* cursor = nullptr;
+    std::byte* limit = nullptr;
+    size_t reserved = 0;
+
+    void* allocate(size_t size, size_t alignment) {
+        std::byte* aligned = alignUp(cursor, alignment);
+        if (cursor == nullptr || aligned + size > limit) {
+            return allocateSlow(size, alignment);
+        }
+        cursor = aligned + size;
+        return aligned;
+    }
+
+    void* allocateSlow(size_t size, size_t alignment);
+
+    static std::byte* alignUp(std::byte* pointer, size_t alignment) {
+        auto address = reinterpret_cast<std::uintptr_t>(pointer);
+        return reinterpret_cast<std::byte*>((address + alignment - 1) & ~(alignment - 1));
+    }
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Bố cục slot của một scope do Resolver tính: tên của từng slot theo thứ tự khai báo.
+// Environment chỉ giữ con trỏ tới đây, bảng tên dùng cho thông báo lỗi, getAllVariables
+// và những chỗ còn tìm theo tên (import *, export, super...).
+struct ScopeLayout {
+    std::vector<std::string> names;
+    // Block, if, vòng lặp không khai báo gì: lúc chạy dùng luôn Environment bên ngoài
+    bool isElided = false;
+
+    size_t size() const {
+        return names.size();
+    }
+
+    int slotOf(const std::string& name) const {
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+};
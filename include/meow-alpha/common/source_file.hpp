@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <string>
 #include <vector>
 #include <fstream>
@@ -7,9 +10,20 @@
 #include <string_view>
 #include <memory>
 
+class SourceFile;
+
+using SrcFilePtr = std::shared_ptr<SourceFile>;
+
 class SourceFile {
     std::string filename, buffer;
     std::vector<size_t> offsets;
+    // Chữ của những token không trùng với đoạn nào trong buffer: chuỗi đã xử lý escape, số đã bỏ '_',
+    // literal do Optimizer sinh ra. Dùng deque để chữ đã cấp không bị dời chỗ khi thêm chữ mới
+    std::deque<std::string> spellings;
+    uint32_t id = unregistered;
+
+    static constexpr uint32_t unregistered = UINT32_MAX;
+    static std::vector<SrcFilePtr>& registry();
 
 public:
     SourceFile(const std::string& path);
@@ -21,6 +35,27 @@ public:
     const std::string& name() const;
 
     const std::string& getBuffer() const;
-};
 
-using SrcFilePtr = std::shared_ptr<SourceFile>;
\ No newline at end of file
+    // Dòng (từ 1) và cột (byte, từ 1) của vị trí offset trong buffer, tra theo bảng offsets
+    size_t lineOf(size_t offset) const;
+    size_t columnOf(size_t offset) const;
+
+    std::string_view slice(uint32_t offset, uint32_t length) const {
+        return std::string_view(buffer).substr(std::min<size_t>(offset, buffer.size()), length);
+    }
+
+    uint32_t addSpelling(std::string text);
+
+    std::string_view spelling(uint32_t index) const {
+        return spellings[index];
+    }
+
+    // Token chỉ giữ id của file. File được đăng ký một lần (lần sau trả lại id cũ) và sống tới hết chương
+    // trình, vì AST, chunk và Diagnostic vẫn có thể trỏ tới nó sau khi module đã chạy xong.
+    // Id 0 là file rỗng "[unknown file]" cho những token không gắn với mã nguồn nào
+    static uint32_t registerFile(const SrcFilePtr& file);
+
+    static SourceFile& byId(uint32_t id) {
+        return *registry()[id];
+    }
+};
@@ -1,13 +1,15 @@
 #pragma once
 
 #include "common/source_file.hpp"
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <array>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 
-enum class TokenType {
+enum class TokenType : uint8_t {
 
     KEYWORD_LET,
     KEYWORD_CONST,
@@ -123,35 +125,70 @@ enum class TokenType {
     _TOTAL_TOKENS,
 };
 
+// Token là bản ghi nhỏ, copy thoải mái: chỉ giữ id của SourceFile và vị trí trong buffer của nó.
+// Chữ của token (lexeme) thường là một đoạn ngay trong buffer; chữ không có sẵn trong mã nguồn
+// (chuỗi đã xử lý escape, literal do Optimizer sinh) nằm trong bảng spelling của SourceFile.
+// Dòng/cột chỉ được tính khi cần, tức là lúc in Diagnostic.
 struct Token {
+    // Token không ứng với vị trí nào trong mã nguồn: in ra dòng 0, cột 0
+    static constexpr uint32_t noPosition = UINT32_MAX;
+
     TokenType type;
-    std::string lexeme;
-    std::string filename;
-    size_t line;
-    size_t col;
-    SrcFilePtr srcFile;
-
-    Token (
-        TokenType type, 
-        const std::string& lex, 
-        const std::string& path, 
-        size_t line, size_t col, 
-        SrcFilePtr src
-    ): 
-        type(type), lexeme(lex), 
-        filename(path), 
-        line(line), col(col), 
-        srcFile(std::move(src)) 
-    {}
-
-    inline std::string getLine() const {
-        if (srcFile) {
-            return srcFile->line(line);
-        }
-        return {};
+    bool isSpelled = false;
+    uint32_t fileId;
+    uint32_t position;
+    // isSpelled: chỉ số trong bảng spelling, ngược lại: offset của chữ trong buffer
+    uint32_t text;
+    uint32_t length;
+
+    // Chữ của token là đoạn [textOffset, textOffset + length) của buffer
+    Token(TokenType type, uint32_t fileId, uint32_t position, uint32_t length, uint32_t textOffset):
+        type(type), fileId(fileId), position(position), text(textOffset), length(length) {}
+
+    Token(TokenType type, uint32_t fileId, uint32_t position, uint32_t length):
+        Token(type, fileId, position, length, position) {}
+
+    // Chữ của token không có sẵn trong buffer
+    Token(TokenType type, uint32_t fileId, uint32_t position, std::string spelling):
+        type(type), fileId(fileId), position(position) {
+        respell(std::move(spelling));
+    }
+
+    const SourceFile& source() const {
+        return SourceFile::byId(fileId);
+    }
+
+    std::string_view lexeme() const {
+        const SourceFile& file = source();
+        return isSpelled ? file.spelling(text) : file.slice(text, length);
+    }
+
+    // Đổi chữ của token, giữ nguyên vị trí
+    void respell(std::string spelling) {
+        length = static_cast<uint32_t>(spelling.size());
+        text = SourceFile::byId(fileId).addSpelling(std::move(spelling));
+        isSpelled = true;
+    }
+
+    const std::string& filename() const {
+        return source().name();
+    }
+
+    size_t line() const {
+        return position == noPosition ? 0 : source().lineOf(position);
+    }
+
+    size_t col() const {
+        return position == noPosition ? 0 : source().columnOf(position);
+    }
+
+    std::string getLine() const {
+        return source().line(line());
     }
 };
 
+static_assert(std::is_trivially_copyable_v<Token>);
+
 constexpr std::array<std::string_view, static_cast<size_t>(TokenType::_TOTAL_TOKENS)> tokenTypeNames = {
 
     "KEYWORD_LET", "KEYWORD_CONST", "KEYWORD_WHILE", "KEYWORD_FOR", "KEYWORD_IF", "KEYWORD_ELSE",
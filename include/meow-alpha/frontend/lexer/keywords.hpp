@@ -2,10 +2,13 @@
 
 #include "common/token.hpp"
 
-#include <unordered_map>
-#include <string>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
 
-const std::unordered_map<std::string, TokenType> keywords = {
+inline constexpr std::array<std::pair<std::string_view, TokenType>, 32> keywords = {{
     {"let",             TokenType::KEYWORD_LET},
     {"const",           TokenType::KEYWORD_CONST},
     {"while",           TokenType::KEYWORD_WHILE},
@@ -43,4 +46,70 @@ const std::unordered_map<std::string, TokenType> keywords = {
 
     {"true",            TokenType::BOOLEAN},
     {"false",           TokenType::BOOLEAN},
-};
\ No newline at end of file
+}};
+
+// Bảng băm hoàn hảo cho từ khoá, dựng lúc biên dịch: mỗi từ khoá một ô riêng theo (ký tự đầu, ký tự cuối,
+// độ dài), nên tra một từ chỉ cần tính một lần băm và so đúng một chuỗi.
+// Hệ số keywordSeed được dò ở compile time; thêm từ khoá mà không còn seed nào hợp lệ thì static_assert báo.
+inline constexpr size_t keywordSlotCount = 64;
+
+inline constexpr std::pair<size_t, size_t> keywordLengths = [] {
+    std::pair<size_t, size_t> lengths{keywords[0].first.size(), keywords[0].first.size()};
+    for (const auto& [word, type] : keywords) {
+        lengths.first = std::min(lengths.first, word.size());
+        lengths.second = std::max(lengths.second, word.size());
+    }
+    return lengths;
+}();
+
+constexpr size_t keywordSlotOf(std::string_view word, uint32_t seed) {
+    uint64_t key = static_cast<uint8_t>(word.front()) * 961u + static_cast<uint8_t>(word.back()) * 31u + word.size();
+    return key * seed % 65521u % keywordSlotCount;
+}
+
+constexpr uint32_t findKeywordSeed() {
+    for (uint32_t seed = 1; seed < 65521; ++seed) {
+        std::array<bool, keywordSlotCount> used{};
+        bool isPerfect = true;
+        for (const auto& [word, type] : keywords) {
+            size_t slot = keywordSlotOf(word, seed);
+            if (used[slot]) {
+                isPerfect = false;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (isPerfect) {
+            return seed;
+        }
+    }
+    return 0;
+}
+
+inline constexpr uint32_t keywordSeed = findKeywordSeed();
+static_assert(keywordSeed != 0, "Không tìm được hàm băm hoàn hảo cho danh sách từ khoá");
+
+inline constexpr std::array<std::pair<std::string_view, TokenType>, keywordSlotCount> keywordSlots = [] {
+    std::array<std::pair<std::string_view, TokenType>, keywordSlotCount> slots{};
+    for (auto& slot : slots) {
+        slot.second = TokenType::IDENTIFIER;
+    }
+    for (const auto& keyword : keywords) {
+        slots[keywordSlotOf(keyword.first, keywordSeed)] = keyword;
+    }
+    return slots;
+}();
+
+// Loại token của word: từ khoá tương ứng, hoặc IDENTIFIER nếu không phải từ khoá
+constexpr TokenType lookupKeyword(std::string_view word) {
+    if (word.size() < keywordLengths.first || word.size() > keywordLengths.second) {
+        return TokenType::IDENTIFIER;
+    }
+    const auto& [keyword, type] = keywordSlots[keywordSlotOf(word, keywordSeed)];
+    return keyword == word ? type : TokenType::IDENTIFIER;
+}
+
+static_assert(lookupKeyword("continue") == TokenType::KEYWORD_CONTINUE);
+static_assert(lookupKeyword("fn") == TokenType::KEYWORD_FUNCTION);
+static_assert(lookupKeyword("false") == TokenType::BOOLEAN);
+static_assert(lookupKeyword("lets") == TokenType::IDENTIFIER);
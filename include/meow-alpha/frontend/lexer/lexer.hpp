@@ -9,31 +9,39 @@ public:
     Lexer(SrcFilePtr sourceFile);
 
     std::vector<Token> tokenize();
+    // Token tiếp theo (để kéo từng token, xem TokenStream); hết mã nguồn thì trả END_OF_FILE
+    Token nextToken();
 
 private:
     SrcFilePtr srcFile; 
 
-    const std::string& src_, filename_;
+    const std::string& src_;
+    uint32_t file_id_;
     size_t pos_;
     unsigned char curr_char_;
-    size_t line_, col_;
-    size_t start_line_, start_col_;
+    size_t start_pos_;
     bool is_in_template_mode_ = false;
     bool is_in_expression_ = false;
 
     void advance() noexcept;
+    void advance_to(size_t pos) noexcept;
     unsigned char peek() const noexcept;
 
     void skip_whitespace() noexcept;
     void skip_line_comment() noexcept;
     void skip_block_comment() noexcept;
 
-    inline Token make_token(TokenType type, const std::string &lex) noexcept;
+    // Token có chữ là đoạn mã nguồn từ đầu token tới vị trí hiện tại
+    inline Token make_token(TokenType type) const noexcept;
+    // Token có chữ lex, vốn bắt đầu ở text_start trong mã nguồn. Chữ chỉ được chép ra
+    // khi khác với mã nguồn (có escape, có '_' trong số)
+    Token make_token(TokenType type, size_t text_start, std::string lex) const;
 
     Token next_token();
 
     Token identifier();
     Token number();
+    Token number_token(TokenType type) const;
     Token string_literal(unsigned char delimitier);
     Token punctuator();
     Token template_string();
@@ -2,9 +2,9 @@
 
 #include "common/token.hpp"
 #include <unordered_map>
-#include <string>
+#include <string_view>
 
-const std::unordered_map<std::string, TokenType> symbols = {
+const std::unordered_map<std::string_view, TokenType> symbols = {
     {"+",       TokenType::OP_PLUS},
     {"-",       TokenType::OP_MINUS},
     {"*",       TokenType::OP_MULTIPLY},
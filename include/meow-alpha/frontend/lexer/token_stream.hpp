@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common/token.hpp"
+#include "common/source_file.hpp"
+#include "lexer/lexer.hpp"
+#include <array>
+#include <optional>
+#include <vector>
+
+// Nguồn token cho Parser: kéo từng token từ Lexer khi cần, thay vì tokenize() cả file thành vector
+// rồi mới parse. Chỉ giữ một cửa sổ nhỏ quanh vị trí hiện tại trong vòng đệm (token vừa qua, token
+// hiện tại và một token nhìn trước), nên bộ nhớ không tăng theo kích thước file và Parser bắt đầu
+// ngay từ token đầu tiên.
+// Công cụ đã có sẵn std::vector<Token> (từ Lexer::tokenize()) vẫn đưa vào được qua constructor thứ hai.
+// Sau END_OF_FILE, stream đứng yên ở token END_OF_FILE.
+class TokenStream {
+public:
+    explicit TokenStream(SrcFilePtr sourceFile);
+    explicit TokenStream(const std::vector<Token>& tokens);
+
+    TokenStream(const TokenStream&) = delete;
+    TokenStream& operator=(const TokenStream&) = delete;
+
+    const Token& peek() const {
+        return ring[current & ringMask];
+    }
+
+    // Token ngay trước peek(); trước lần advance() đầu tiên là token UNKNOWN không có vị trí
+    const Token& previous() const {
+        return ring[(current - 1) & ringMask];
+    }
+
+    // Token ngay sau peek()
+    const Token& next() const {
+        return ring[(current + 1) & ringMask];
+    }
+
+    void advance();
+
+private:
+    // Đủ cho previous/peek/next, làm tròn lên luỹ thừa của 2
+    static constexpr size_t ringSize = 4;
+    static constexpr size_t ringMask = ringSize - 1;
+
+    std::optional<Lexer> lexer;
+    const std::vector<Token>* tokens = nullptr;
+    // Số token đã lấy từ nguồn (cũng là chỉ số của token tiếp theo trong vector)
+    size_t pulled = 0;
+    bool reachedEnd = false;
+
+    std::array<Token, ringSize> ring;
+    size_t current = 0;
+
+    Token pull();
+    void fill();
+};
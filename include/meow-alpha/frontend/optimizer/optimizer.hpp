@@ -0,0 +1,90 @@
+#pragma once
+
+#include "common/ast.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Mức tối ưu, chọn bằng -O0/-O1/-O2 trên dòng lệnh
+//  O0: chạy đúng cây Parser trả về
+//  O1: gộp hằng (ConstantFolding)
+//  O2: O1 + bỏ nhánh chết và code sau return/break/continue/throw (DeadCodeElimination)
+enum class OptimizationLevel {
+    O0,
+    O1,
+    O2,
+};
+
+// Số node mà một pass đã biến đổi
+struct PassStats {
+    std::string name;
+    size_t rewrites = 0;
+};
+
+// Duyệt toàn bộ cây theo thứ tự sau (con trước, cha sau) và cho pass con thay node tại chỗ.
+// Các pass chỉ biến đổi cây, không đụng tới LexicalAddress/ScopeLayout: Optimizer chạy trước Resolver.
+class AstPass {
+public:
+    explicit AstPass(std::string name) : stats{std::move(name)} {}
+    virtual ~AstPass() = default;
+
+    void run(Program* program);
+
+    const PassStats& statistics() const {
+        return stats;
+    }
+
+protected:
+    PassStats stats;
+    // Node mới do pass tạo ra cấp từ arena của Program đang tối ưu
+    AstArena* arena = nullptr;
+
+    // Gọi sau khi đã duyệt xong các con của node
+    virtual void rewrite(ExprPtr&) {}
+    virtual void rewrite(StmtPtr&) {}
+    // Gọi sau khi đã duyệt từng câu lệnh trong danh sách (thân block, program, case)
+    virtual void rewrite(std::vector<StmtPtr>&) {}
+
+private:
+    void walk(ExprPtr& expression);
+    void walk(StmtPtr& statement);
+    void walk(std::vector<StmtPtr>& statements);
+};
+
+// Thay các biểu thức chỉ gồm hằng bằng literal mang sẵn kết quả: BinaryExpression, UnaryExpression,
+// TemplateLiteral, cùng &&, ||, ?? và ?: có vế quyết định là hằng. Phép toán được tính bằng đúng
+// bảng của OperatorDispatcher nên kết quả giống hệt lúc chạy; phép nào báo lỗi thì giữ nguyên để
+// lỗi vẫn xảy ra lúc chạy, đúng chỗ. Chuỗi kết quả được intern như StringLiteral của Parser.
+class ConstantFolding : public AstPass {
+public:
+    ConstantFolding() : AstPass("constant-folding") {}
+
+protected:
+    void rewrite(ExprPtr& expression) override;
+};
+
+// Bỏ if/while có điều kiện là hằng (chỉ giữ nhánh được chạy) và các câu lệnh không bao giờ tới được
+// sau return/break/continue/throw trong cùng một danh sách. Khai báo (let, fn, class, import, export)
+// được giữ lại để cách phân giải tên của Resolver không đổi.
+class DeadCodeElimination : public AstPass {
+public:
+    DeadCodeElimination() : AstPass("dead-code") {}
+
+protected:
+    void rewrite(StmtPtr& statement) override;
+    void rewrite(std::vector<StmtPtr>& statements) override;
+};
+
+// Chạy các pass ứng với mức tối ưu, giữa Parser::parseProgram và Resolver
+class Optimizer {
+private:
+    std::vector<std::unique_ptr<AstPass>> passes;
+
+public:
+    explicit Optimizer(OptimizationLevel level);
+
+    void optimize(Program* program);
+
+    std::vector<PassStats> statistics() const;
+};
@@ -2,6 +2,7 @@
 
 #include "common/ast.hpp"
 #include "diagnostics/diagnostic.hpp"
+#include "lexer/token_stream.hpp"
 #include "parser/parse_rule.hpp"
 #include <format>
 #include <vector>
@@ -23,13 +24,22 @@ namespace std {
 
 class Parser {
 public:
+    // Parse trong lúc lex: token được kéo dần từ Lexer của sourceFile
+    Parser(SrcFilePtr sourceFile);
+    // Parse danh sách token có sẵn (từ Lexer::tokenize())
     Parser(const std::vector<Token> &tokens);
     std::unique_ptr<Program> parseProgram();
 
 private:
-    const std::vector<Token> &tokens;
-    size_t current;
+    TokenStream tokens;
     std::unordered_map<TokenType, ParseRule> rules;
+    // Arena của Program đang được parse, mọi node đều cấp từ đây
+    AstArena* arena = nullptr;
+
+    template <typename T, typename... Args>
+    AstPtr<T> make(Args&&... args) {
+        return arena->make<T>(std::forward<Args>(args)...);
+    }
 
     static ExprPtr literal(Parser *parser);
     static ExprPtr arrayLiteral(Parser* parser);
@@ -60,13 +70,14 @@ private:
     void initRules();
 
     bool isAtEnd() const;
-    const Token& peek() const;
-    const Token& previous() const;
-    const Token& next() const;
-    const Token& advance();
+    // Trả về bản sao: vòng đệm của TokenStream sẽ ghi đè token cũ khi parse tiếp
+    Token peek() const;
+    Token previous() const;
+    Token next() const;
+    Token advance();
     bool check(TokenType type) const;
     bool match(std::initializer_list<TokenType> types);
-    const Token& consume(TokenType type, const std::string &errMsg);
+    Token consume(TokenType type, const std::string &errMsg);
     void synchronize();
 
     StmtPtr statement();
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "common/ast_arena.hpp"
+#include "visitor/visitor.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct LexicalAddress;
+struct ScopeLayout;
+
+// Pass phân tích ngữ nghĩa chạy sau Parser::parseProgram.
+// Dựng cây scope giống hệt cách TreeWalker/VM tạo Environment lúc chạy
+// (Program, hàm, block, if, while, for, for-in, catch) rồi ghi LexicalAddress
+// vào từng Identifier và ThisExpression. Tên được khai báo trong mỗi scope được
+// ghi vào ScopeLayout của node tạo scope đó để Environment cấp đúng số slot.
+// Scope không khai báo gì được đánh dấu isElided và không tính vào độ sâu.
+//
+// Tham chiếu được phân giải theo trạng thái cuối cùng của mỗi scope: biến được
+// khai báo ở bất kỳ đâu trong scope đều thấy được, vì hàm lồng bên trong có thể
+// chạy sau khi khai báo đó đã được thực thi. Lúc chạy vẫn tìm theo tên bắt đầu
+// từ môi trường ở độ sâu đó, nên nếu biến chưa được khai báo thì kết quả vẫn
+// giống hệt việc đi dọc cả chuỗi scope.
+class Resolver: Visitor {
+private:
+    struct Scope {
+        Scope* parent;
+        // nullptr với scope gốc: môi trường gốc lưu theo tên, slot luôn là -1
+        ScopeLayout* layout;
+        std::unordered_map<std::string, int> slots;
+        // import * khai báo những tên không biết trước
+        bool isDynamic = false;
+        // Block, if, vòng lặp: được bỏ Environment nếu không khai báo gì.
+        // Scope của hàm, catch và scope gốc luôn có Environment riêng.
+        bool isElidable = false;
+
+        Scope(Scope* parent, ScopeLayout* layout): parent(parent), layout(layout) {}
+    };
+
+    struct Reference {
+        Scope* scope;
+        const std::string* name;
+        LexicalAddress* address;
+    };
+
+    std::vector<std::unique_ptr<Scope>> scopes;
+    Scope* current = nullptr;
+    // Đang ở trong thân hàm, và số khối try bao quanh tính từ hàm gần nhất
+    bool isInFunction = false;
+    int tryDepth = 0;
+    std::vector<Reference> references;
+
+    void beginScope(ScopeLayout* layout, bool isElidable = false);
+    void endScope();
+
+    void resolve(ASTNode* node);
+    void resolveStatements(const std::vector<AstPtr<Statement>>& statements);
+    void resolveFunction(FunctionLiteral* function, bool isMethod);
+
+    void declare(Identifier* name);
+    void declare(const std::string& name, LexicalAddress* address);
+    void reference(const std::string& name, LexicalAddress* address);
+    void bindReferences();
+
+public:
+    void resolve(Program* program);
+
+    Value visit(Program* node) override;
+
+    Value visit(IntegerLiteral* node) override;
+    Value visit(RealLiteral* node) override;
+    Value visit(StringLiteral* node) override;
+    Value visit(BooleanLiteral* node) override;
+    Value visit(NullLiteral* node) override;
+    Value visit(ArrayLiteral* node) override;
+    Value visit(ObjectLiteral* node) override;
+    Value visit(FunctionLiteral* node) override;
+    Value visit(TemplateLiteral* node) override;
+
+    Value visit(Identifier* node) override;
+    Value visit(BinaryExpression* node) override;
+    Value visit(UnaryExpression* node) override;
+    Value visit(CallExpression* node) override;
+    Value visit(IndexExpression* node) override;
+    Value visit(AssignmentExpression* node) override;
+    Value visit(TernaryExpression* node) override;
+    Value visit(PropertyAccess* node) override;
+    Value visit(PropertyAssignment* node) override;
+    Value visit(ThisExpression* node) override;
+    Value visit(SuperExpression* node) override;
+    Value visit(NewExpression* node) override;
+    Value visit(PrefixUpdateExpression* node) override;
+    Value visit(PostfixUpdateExpression* node) override;
+    Value visit(SpreadExpression* node) override;
+
+    Value visit(LetStatement* node) override;
+    Value visit(ReturnStatement* node) override;
+    Value visit(BreakStatement* node) override;
+    Value visit(ContinueStatement* node) override;
+    Value visit(ThrowStatement* node) override;
+    Value visit(IfStatement* node) override;
+    Value visit(WhileStatement* node) override;
+    Value visit(ForStatement* node) override;
+    Value visit(ForInStatement* node) override;
+    Value visit(BlockStatement* node) override;
+    Value visit(ClassStatement* node) override;
+    Value visit(ImportStatement* node) override;
+    Value visit(ExportStatement* node) override;
+    Value visit(TryStatement* node) override;
+    Value visit(ExpressionStatement* node) override;
+    Value visit(LogStatement* node) override;
+    Value visit(SwitchCase* node) override;
+    Value visit(SwitchStatement* node) override;
+    Value visit(DoWhileStatement* node) override;
+};
@@ -1,35 +1,60 @@
 #include "callable/function_callable.hpp"
+#include <type_traits>
 
 MeowScriptFunction::MeowScriptFunction(FunctionLiteral* decl, std::shared_ptr<Environment> cl):
     declaration(decl), closure(cl) {}
-Value MeowScriptFunction::call(Interpreter* engine, const std::vector<Value>& args) {
-    auto localEnv = std::make_shared<Environment>(this->closure);
+namespace {
+    // Args là Arguments (sao chép) hoặc MutableArguments (chuyển giá trị ra khỏi ngăn xếp tham số)
+    template <typename Args>
+    std::shared_ptr<Environment> bindParameters(MeowScriptFunction* function, Args args, const Value* self) {
+        FunctionLiteral* decl = function->declaration;
+        auto localEnv = std::make_shared<Environment>(function->closure, &decl->scope);
 
-    size_t requiredParams = declaration->parameters.size();
+        if (self != nullptr) {
+            localEnv->define("this", *self);
+        }
 
-    for (size_t i = 0; i < requiredParams; ++i) {
-        const std::string& paramName = declaration->parameters[i]->name;
+        size_t requiredParams = decl->parameters.size();
 
-        localEnv->define(paramName, args[i]);
-    }
+        for (size_t i = 0; i < requiredParams; ++i) {
+            if constexpr (std::is_const_v<typename Args::element_type>) {
+                localEnv->defineAt(decl->parameters[i]->address.slot, args[i]);
+            } else {
+                localEnv->defineAt(decl->parameters[i]->address.slot, std::move(args[i]));
+            }
+        }
 
-    if (declaration->restParam) {
-        auto restArrayData = std::make_shared<ArrayData>();
+        if (decl->restParam) {
+            auto restArrayData = makeRef<ArrayData>();
+            if (args.size() > requiredParams) {
+                restArrayData->elements.reserve(args.size() - requiredParams);
+            }
+
+            for (size_t i = requiredParams; i < args.size(); ++i) {
+                if constexpr (std::is_const_v<typename Args::element_type>) {
+                    restArrayData->elements.push_back(args[i]);
+                } else {
+                    restArrayData->elements.push_back(std::move(args[i]));
+                }
+            }
 
-        for (size_t i = requiredParams; i < args.size(); ++i) {
-            restArrayData->elements.push_back(args[i]);
+            localEnv->defineAt(decl->restParam->address.slot, Value(Array(restArrayData)));
         }
 
-        localEnv->define(declaration->restParam->name, Value(Array(restArrayData)));
+        return localEnv;
     }
+}
 
-    try {
-        engine->exec(declaration->body.get(), localEnv);
-    } catch (ReturnException& e) {
-        return e.value;
-    }
+std::shared_ptr<Environment> MeowScriptFunction::makeFrame(Arguments args, const Value* self) {
+    return bindParameters(this, args, self);
+}
+
+std::shared_ptr<Environment> MeowScriptFunction::makeFrame(MutableArguments args, const Value* self) {
+    return bindParameters(this, args, self);
+}
 
-    return Value(Null{});
+Value MeowScriptFunction::call(Interpreter* engine, Arguments args) {
+    return engine->exec(declaration->body.get(), makeFrame(args));
 }
 
 Arity MeowScriptFunction::arity() const {
@@ -6,7 +6,7 @@
 
 NativeCallable::NativeCallable(std::shared_ptr<NativeFunction> data): functionData(std::move(data)) {}
 
-Value NativeCallable::call(Interpreter* engine, const std::vector<Value>& args) {
+Value NativeCallable::call(Interpreter* engine, Arguments args) {
     return std::visit(overloaded {
         [&](const NativeFnSimple& fn) {
             return fn(args);
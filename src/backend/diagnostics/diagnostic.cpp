@@ -49,24 +49,25 @@ Diagnostic::Diagnostic(DiagnosticType type, Severity sev, const std::string &msg
 static std::string formatToken(const Token& token, std::string_view sevColor, std::string_view sevLabel, std::string_view typeLabel, const std::string& message) {
     std::string header = std::format(
         "{}{}:{}:{}{} {}{}[{}] {}{}{}{}: {}{}{}",
-        AnsiColors::BOLD, shortenPath(token.filename), token.line, token.col, AnsiColors::RESET,
+        AnsiColors::BOLD, shortenPath(token.filename()), token.line(), token.col(), AnsiColors::RESET,
         sevColor, AnsiColors::BOLD, typeLabel, AnsiColors::RESET,
         AnsiColors::BOLD, sevColor, sevLabel, AnsiColors::RESET,
         sevColor, message, AnsiColors::RESET
     );
 
     std::string codeLine = token.getLine();
-    size_t pos = (token.col > 1) ? token.col - 1 : 0;
+    size_t col = token.col();
+    size_t pos = (col > 1) ? col - 1 : 0;
     pos = std::min(pos, codeLine.size());
 
     std::string indicator(pos, ' ');
-    indicator.append(std::max<size_t>(1, token.lexeme.length()), '^');
+    indicator.append(std::max<size_t>(1, token.length), '^');
 
     return std::format(
         "{}\n  {}-> {}{}{}\n  {}  {}{}{}",
         header,
         sevColor, AnsiColors::BOLD, codeLine, AnsiColors::RESET,
-        sevColor, std::string(pos, ' '), std::string(token.lexeme.length(), '^'), AnsiColors::RESET
+        sevColor, std::string(pos, ' '), std::string(token.length, '^'), AnsiColors::RESET
     );
 }
 
@@ -81,15 +82,15 @@ std::string Diagnostic::str() const noexcept {
         for (auto it = callStack_.rbegin(); it != callStack_.rend(); ++it) {
             out += std::format(
                 "\n\n{}Gọi từ {}:{}:{}{}\n  {}-> {}{}{}\n  {}  {}{}{}",
-                sevColor, it->filename, it->line, it->col, AnsiColors::RESET,
+                sevColor, it->filename(), it->line(), it->col(), AnsiColors::RESET,
                 sevColor, AnsiColors::BOLD, it->getLine(), AnsiColors::RESET,
-                sevColor, std::string(it->col - 1, ' '), "^", AnsiColors::RESET
+                sevColor, std::string(it->col() - 1, ' '), "^", AnsiColors::RESET
             );
         }
 
         return out;
     } catch (...) {
-        return "Lỗi định dạng: " + message_ + " ở " + token_.filename + ":" + std::to_string(token_.line);
+        return "Lỗi định dạng: " + message_ + " ở " + token_.filename() + ":" + std::to_string(token_.line());
     }
 }
 
@@ -0,0 +1,197 @@
+#include "jit/assembler.hpp"
+#include "jit/loop_jit.hpp"
+#include <cstring>
+
+#if MEOW_JIT_SUPPORTED
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+NativeCode::~NativeCode() {
+#if MEOW_JIT_SUPPORTED
+    munmap(memory, size);
+#endif
+}
+
+// Ghi mã vào trang RW rồi mới chuyển sang RX, không lúc nào trang vừa ghi được vừa chạy được
+std::unique_ptr<NativeCode> NativeCode::install(const std::vector<uint8_t>& bytes) {
+#if MEOW_JIT_SUPPORTED
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t size = (bytes.size() + pageSize - 1) / pageSize * pageSize;
+
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    std::memcpy(memory, bytes.data(), bytes.size());
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, size);
+        return nullptr;
+    }
+    return std::unique_ptr<NativeCode>(new NativeCode(memory, size));
+#else
+    return nullptr;
+#endif
+}
+
+void Assembler::emit(std::initializer_list<uint8_t> bytes) {
+    code.insert(code.end(), bytes);
+}
+
+void Assembler::emit32(int32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        code.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void Assembler::emit64(int64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        code.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+// Toán hạng bộ nhớ [rbx + disp32] đứng ngay sau byte ModRM
+void Assembler::emitSlot(int slot) {
+    emit32(slot * 8);
+}
+
+void Assembler::emitRel32(Label& label) {
+    if (label.position >= 0) {
+        emit32(static_cast<int32_t>(label.position - static_cast<std::ptrdiff_t>(code.size() + 4)));
+        return;
+    }
+    label.fixups.push_back(code.size());
+    emit32(0);
+}
+
+void Assembler::bind(Label& label) {
+    label.position = static_cast<std::ptrdiff_t>(code.size());
+    for (size_t fixup : label.fixups) {
+        int32_t offset = static_cast<int32_t>(label.position - static_cast<std::ptrdiff_t>(fixup + 4));
+        std::memcpy(&code[fixup], &offset, sizeof(offset));
+    }
+    label.fixups.clear();
+}
+
+void Assembler::jmp(Label& label) {
+    emit({0xE9});
+    emitRel32(label);
+}
+
+void Assembler::jcc(Condition condition, Label& label) {
+    emit({0x0F, static_cast<uint8_t>(0x80 | static_cast<uint8_t>(condition))});
+    emitRel32(label);
+}
+
+void Assembler::prologue() {
+    emit({0x55, 0x48, 0x89, 0xE5, 0x53, 0x48, 0x89, 0xFB});
+}
+
+void Assembler::epilogue() {
+    emit({0x48, 0x8B, 0x5D, 0xF8, 0x48, 0x89, 0xEC, 0x5D, 0xC3});
+}
+
+void Assembler::movRaxImm(int64_t value) {
+    emit({0x48, 0xB8});
+    emit64(value);
+}
+
+void Assembler::movRcxImm(int64_t value) {
+    emit({0x48, 0xB9});
+    emit64(value);
+}
+
+void Assembler::movRaxSlot(int slot) {
+    emit({0x48, 0x8B, 0x83});
+    emitSlot(slot);
+}
+
+void Assembler::movRcxSlot(int slot) {
+    emit({0x48, 0x8B, 0x8B});
+    emitSlot(slot);
+}
+
+void Assembler::movSlotRax(int slot) {
+    emit({0x48, 0x89, 0x83});
+    emitSlot(slot);
+}
+
+void Assembler::movRcxRax() { emit({0x48, 0x89, 0xC1}); }
+void Assembler::movRaxRdx() { emit({0x48, 0x89, 0xD0}); }
+void Assembler::pushRax() { emit({0x50}); }
+void Assembler::popRax() { emit({0x58}); }
+void Assembler::addRaxRcx() { emit({0x48, 0x01, 0xC8}); }
+void Assembler::subRaxRcx() { emit({0x48, 0x29, 0xC8}); }
+void Assembler::imulRaxRcx() { emit({0x48, 0x0F, 0xAF, 0xC1}); }
+void Assembler::andRaxRcx() { emit({0x48, 0x21, 0xC8}); }
+void Assembler::orRaxRcx() { emit({0x48, 0x09, 0xC8}); }
+void Assembler::xorRaxRcx() { emit({0x48, 0x31, 0xC8}); }
+void Assembler::shlRaxCl() { emit({0x48, 0xD3, 0xE0}); }
+void Assembler::sarRaxCl() { emit({0x48, 0xD3, 0xF8}); }
+void Assembler::negRax() { emit({0x48, 0xF7, 0xD8}); }
+void Assembler::notRax() { emit({0x48, 0xF7, 0xD0}); }
+void Assembler::idivRcx() { emit({0x48, 0x99, 0x48, 0xF7, 0xF9}); }
+
+void Assembler::incSlot(int slot) {
+    emit({0x48, 0xFF, 0x83});
+    emitSlot(slot);
+}
+
+void Assembler::decSlot(int slot) {
+    emit({0x48, 0xFF, 0x8B});
+    emitSlot(slot);
+}
+
+void Assembler::cmpRaxRcx() { emit({0x48, 0x39, 0xC8}); }
+void Assembler::cmpRcxImm8(int8_t value) { emit({0x48, 0x83, 0xF9, static_cast<uint8_t>(value)}); }
+void Assembler::testRaxRax() { emit({0x48, 0x85, 0xC0}); }
+void Assembler::testRcxRcx() { emit({0x48, 0x85, 0xC9}); }
+
+void Assembler::setRax(Condition condition) {
+    emit({0x0F, static_cast<uint8_t>(0x90 | static_cast<uint8_t>(condition)), 0xC0, 0x0F, 0xB6, 0xC0});
+}
+
+void Assembler::setCl(Condition condition) {
+    emit({0x0F, static_cast<uint8_t>(0x90 | static_cast<uint8_t>(condition)), 0xC1});
+}
+
+void Assembler::andAlCl() { emit({0x20, 0xC8}); }
+void Assembler::orAlCl() { emit({0x08, 0xC8}); }
+void Assembler::xorRaxImm8(int8_t value) { emit({0x48, 0x83, 0xF0, static_cast<uint8_t>(value)}); }
+
+void Assembler::movsdXmm0Slot(int slot) {
+    emit({0xF2, 0x0F, 0x10, 0x83});
+    emitSlot(slot);
+}
+
+void Assembler::movsdXmm1Slot(int slot) {
+    emit({0xF2, 0x0F, 0x10, 0x8B});
+    emitSlot(slot);
+}
+
+void Assembler::movsdSlotXmm0(int slot) {
+    emit({0xF2, 0x0F, 0x11, 0x83});
+    emitSlot(slot);
+}
+
+void Assembler::movqXmm0Rax() { emit({0x66, 0x48, 0x0F, 0x6E, 0xC0}); }
+void Assembler::movqXmm1Rcx() { emit({0x66, 0x48, 0x0F, 0x6E, 0xC9}); }
+void Assembler::movqRaxXmm0() { emit({0x66, 0x48, 0x0F, 0x7E, 0xC0}); }
+void Assembler::movapdXmm1Xmm0() { emit({0x66, 0x0F, 0x28, 0xC8}); }
+void Assembler::cvtsi2sdXmm0Rax() { emit({0xF2, 0x48, 0x0F, 0x2A, 0xC0}); }
+void Assembler::cvtsi2sdXmm1Rcx() { emit({0xF2, 0x48, 0x0F, 0x2A, 0xC9}); }
+void Assembler::cvtsi2sdXmm1Rax() { emit({0xF2, 0x48, 0x0F, 0x2A, 0xC8}); }
+void Assembler::addsd() { emit({0xF2, 0x0F, 0x58, 0xC1}); }
+void Assembler::subsd() { emit({0xF2, 0x0F, 0x5C, 0xC1}); }
+void Assembler::mulsd() { emit({0xF2, 0x0F, 0x59, 0xC1}); }
+void Assembler::divsd() { emit({0xF2, 0x0F, 0x5E, 0xC1}); }
+void Assembler::ucomisdXmm0Xmm1() { emit({0x66, 0x0F, 0x2E, 0xC1}); }
+void Assembler::ucomisdXmm1Xmm0() { emit({0x66, 0x0F, 0x2E, 0xC8}); }
+void Assembler::ucomisdXmm1Zero() { emit({0x66, 0x0F, 0x57, 0xD2, 0x66, 0x0F, 0x2E, 0xCA}); }
+void Assembler::ucomisdXmm0Zero() { emit({0x66, 0x0F, 0x57, 0xC9, 0x66, 0x0F, 0x2E, 0xC1}); }
+
+void Assembler::negXmm0() {
+    movqRaxXmm0();
+    emit({0x48, 0x0F, 0xBA, 0xF8, 0x3F});
+    movqXmm0Rax();
+}
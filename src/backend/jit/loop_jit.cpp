@@ -0,0 +1,814 @@
+#include "jit/loop_jit.hpp"
+#include "jit/assembler.hpp"
+#include "common/ast.hpp"
+#include "runtime/environment.hpp"
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Kiểu tĩnh của một biểu thức trong mã máy. Bool chỉ là kết quả so sánh, không biến nào mang kiểu này
+enum class JitType : uint8_t {
+    Int,
+    Real,
+    Bool,
+};
+
+// Một biến mà vòng lặp dùng, nằm ở ô cùng số thứ tự trong frame.
+// identifier là lần xuất hiện đầu tiên, dùng để tìm lại Variable ở mỗi lần vào vòng lặp
+struct JitVariable {
+    Identifier* identifier;
+    JitType type;
+    bool isWritten = false;
+};
+
+// Giống TreeWalker::resolveLValue với một Identifier
+Variable* resolve(Environment* env, Identifier* identifier) {
+    Environment* target = identifier->address.depth >= 0 ? env->ancestor(identifier->address.depth) : env;
+    int slot = identifier->address.slot;
+    return slot >= 0 ? target->lookupAt(slot) : target->lookup(identifier->name);
+}
+
+std::optional<JitType> typeOf(const Value& value) {
+    if (std::holds_alternative<Int>(value)) {
+        return JitType::Int;
+    }
+    if (std::holds_alternative<Real>(value)) {
+        return JitType::Real;
+    }
+    return std::nullopt;
+}
+
+bool isComparison(TokenType op) {
+    using enum TokenType;
+    return op == OP_EQ || op == OP_NEQ || op == OP_LT || op == OP_GT || op == OP_LE || op == OP_GE;
+}
+
+// Biểu thức chắc chắn cho ra Bool, nên !x và độ truthy của nó khớp nhau
+bool isBoolean(Expression* expression) {
+    switch (expression->type) {
+        case EXPR_LITERAL_BOOLEAN:
+            return true;
+        case EXPR_UNARY:
+            return static_cast<UnaryExpression*>(expression)->op == TokenType::OP_LOGICAL_NOT;
+        case EXPR_BINARY: {
+            auto node = static_cast<BinaryExpression*>(expression);
+            if (node->op == TokenType::OP_LOGICAL_AND || node->op == TokenType::OP_LOGICAL_OR) {
+                return isBoolean(node->left.get()) && isBoolean(node->right.get());
+            }
+            return isComparison(node->op);
+        }
+        default:
+            return false;
+    }
+}
+
+std::optional<TokenType> compoundOperator(TokenType op) {
+    using enum TokenType;
+    switch (op) {
+        case OP_PLUS_ASSIGN:     return OP_PLUS;
+        case OP_MINUS_ASSIGN:    return OP_MINUS;
+        case OP_MULTIPLY_ASSIGN: return OP_MULTIPLY;
+        case OP_DIVIDE_ASSIGN:   return OP_DIVIDE;
+        case OP_MODULO_ASSIGN:   return OP_MODULO;
+        case OP_AND_ASSIGN:      return OP_BIT_AND;
+        case OP_OR_ASSIGN:       return OP_BIT_OR;
+        case OP_XOR_ASSIGN:      return OP_BIT_XOR;
+        case OP_LSHIFT_ASSIGN:   return OP_LSHIFT;
+        case OP_RSHIFT_ASSIGN:   return OP_RSHIFT;
+        default:                 return std::nullopt;
+    }
+}
+
+// Cờ mà một phép so sánh để lại: condition đúng nghĩa là phép so sánh đúng.
+// So sánh Real bằng == / != còn phải xét NaN (cờ parity), khi đó kết quả là unorderedResult
+struct Comparison {
+    Condition condition;
+    bool checksParity = false;
+    bool unorderedResult = false;
+};
+
+// Dịch một vòng lặp thành hàm int64_t(int64_t* frame). Mọi biến ở lại trong frame,
+// biểu thức tính trên rax/rcx (Int, Bool) và xmm0/xmm1 (Real), vế trái phức tạp tạm đẩy lên stack.
+// Frame có thêm một bản chụp các biến bị ghi ở đầu mỗi lượt; guard trượt thì chép bản chụp về rồi trả 1
+class LoopCompiler {
+public:
+    explicit LoopCompiler(Environment* env): env(env) {}
+
+    std::vector<JitVariable> variables;
+
+    bool compile(Statement* loop) {
+        Expression* condition = nullptr;
+        Expression* update = nullptr;
+        Statement* body = nullptr;
+
+        if (loop->type == STMT_FOR) {
+            auto node = static_cast<ForStatement*>(loop);
+            condition = node->condition.get();
+            update = node->update.get();
+            body = node->body.get();
+        } else if (loop->type == STMT_WHILE) {
+            auto node = static_cast<WhileStatement*>(loop);
+            condition = node->condition.get();
+            body = node->body.get();
+        } else {
+            return false;
+        }
+
+        if (!collect(condition) || !collect(update) || !collect(body)) {
+            return false;
+        }
+
+        int count = static_cast<int>(variables.size());
+        Label head, next, exit;
+
+        as.prologue();
+        as.bind(head);
+        if (hasGuards) {
+            for (int i = 0; i < count; ++i) {
+                if (variables[i].isWritten) {
+                    as.movRaxSlot(i);
+                    as.movSlotRax(count + i);
+                }
+            }
+        }
+        if (condition != nullptr && !branch(condition, false, exit)) {
+            return false;
+        }
+        if (!emit(body, exit, next)) {
+            return false;
+        }
+        as.bind(next);
+        if (update != nullptr && !emitEffect(update)) {
+            return false;
+        }
+        as.jmp(head);
+
+        as.bind(exit);
+        as.movRaxImm(0);
+        as.epilogue();
+
+        as.bind(deopt);
+        for (int i = 0; i < count; ++i) {
+            if (variables[i].isWritten) {
+                as.movRaxSlot(count + i);
+                as.movSlotRax(i);
+            }
+        }
+        as.movRaxImm(1);
+        as.epilogue();
+        return true;
+    }
+
+    const std::vector<uint8_t>& bytes() const {
+        return as.bytes();
+    }
+
+private:
+    Environment* env;
+    Assembler as;
+    Label deopt;
+    std::unordered_map<std::string, int> slots;
+    // Có phép chia nào có thể trượt guard không, nếu không thì khỏi chụp biến ở đầu lượt
+    bool hasGuards = false;
+
+    // Lượt 1: kiểm tra loại node và gom biến, kiểu của biến lấy theo giá trị hiện tại
+
+    bool use(Identifier* identifier, bool writes) {
+        auto [it, inserted] = slots.try_emplace(identifier->name, static_cast<int>(variables.size()));
+        Variable* variable = resolve(env, identifier);
+        if (variable == nullptr) {
+            return false;
+        }
+        if (inserted) {
+            std::optional<JitType> type = typeOf(variable->value);
+            if (!type) {
+                return false;
+            }
+            variables.push_back({identifier, *type});
+        }
+        if (writes) {
+            if (variable->isConstant) {
+                return false;
+            }
+            variables[it->second].isWritten = true;
+        }
+        return true;
+    }
+
+    bool collect(Expression* expression) {
+        if (expression == nullptr) {
+            return true;
+        }
+
+        switch (expression->type) {
+            case EXPR_LITERAL_INTEGER:
+            case EXPR_LITERAL_REAL:
+            case EXPR_LITERAL_BOOLEAN:
+                return true;
+            case EXPR_IDENTIFIER:
+                return use(static_cast<Identifier*>(expression), false);
+            case EXPR_UNARY:
+                return collect(static_cast<UnaryExpression*>(expression)->operand.get());
+            case EXPR_BINARY: {
+                auto node = static_cast<BinaryExpression*>(expression);
+                hasGuards |= node->op == TokenType::OP_DIVIDE || node->op == TokenType::OP_MODULO;
+                return collect(node->left.get()) && collect(node->right.get());
+            }
+            case EXPR_ASSIGN: {
+                auto node = static_cast<AssignmentExpression*>(expression);
+                if (node->target->type != EXPR_IDENTIFIER) {
+                    return false;
+                }
+                TokenType op = node->token.type;
+                hasGuards |= op == TokenType::OP_DIVIDE_ASSIGN || op == TokenType::OP_MODULO_ASSIGN;
+                return use(static_cast<Identifier*>(node->target.get()), true) && collect(node->value.get());
+            }
+            case EXPR_UPDATE_PREFIX:
+            case EXPR_UPDATE_POSTFIX: {
+                Expression* operand = expression->type == EXPR_UPDATE_PREFIX
+                    ? static_cast<PrefixUpdateExpression*>(expression)->operand.get()
+                    : static_cast<PostfixUpdateExpression*>(expression)->operand.get();
+                return operand->type == EXPR_IDENTIFIER && use(static_cast<Identifier*>(operand), true);
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Scope không bị bỏ thì lúc chạy có Environment riêng, địa chỉ các biến bên trong sẽ lệch đi
+    bool collect(Statement* statement) {
+        if (statement == nullptr) {
+            return true;
+        }
+
+        switch (statement->type) {
+            case STMT_EXPR:
+                return collect(static_cast<ExpressionStatement*>(statement)->expression.get());
+            case STMT_BLOCK: {
+                auto node = static_cast<BlockStatement*>(statement);
+                if (!node->scope.isElided) {
+                    return false;
+                }
+                for (const auto& child : node->statements) {
+                    if (!collect(child.get())) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            case STMT_IF: {
+                auto node = static_cast<IfStatement*>(statement);
+                return node->scope.isElided && collect(node->condition.get())
+                    && collect(node->thenBranch.get()) && collect(node->elseBranch.get());
+            }
+            case STMT_BREAK:
+            case STMT_CONTINUE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Lượt 2: sinh mã, kiểu của từng biểu thức suy ra từ kiểu biến và phải khớp với bảng toán tử
+
+    int slotOf(Expression* identifier) {
+        return slots.at(static_cast<Identifier*>(identifier)->name);
+    }
+
+    bool emit(Statement* statement, Label& breakTarget, Label& continueTarget) {
+        if (statement == nullptr) {
+            return true;
+        }
+
+        switch (statement->type) {
+            case STMT_EXPR:
+                return emitEffect(static_cast<ExpressionStatement*>(statement)->expression.get());
+            case STMT_BLOCK:
+                for (const auto& child : static_cast<BlockStatement*>(statement)->statements) {
+                    if (!emit(child.get(), breakTarget, continueTarget)) {
+                        return false;
+                    }
+                }
+                return true;
+            case STMT_IF: {
+                auto node = static_cast<IfStatement*>(statement);
+                Label elseBranch, end;
+                if (!branch(node->condition.get(), false, elseBranch)
+                    || !emit(node->thenBranch.get(), breakTarget, continueTarget)) {
+                    return false;
+                }
+                if (node->elseBranch != nullptr) {
+                    as.jmp(end);
+                }
+                as.bind(elseBranch);
+                if (!emit(node->elseBranch.get(), breakTarget, continueTarget)) {
+                    return false;
+                }
+                as.bind(end);
+                return true;
+            }
+            case STMT_BREAK:
+                as.jmp(breakTarget);
+                return true;
+            case STMT_CONTINUE:
+                as.jmp(continueTarget);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Biểu thức đứng làm câu lệnh: gán, ++/--, còn lại thì tính rồi bỏ kết quả
+    bool emitEffect(Expression* expression) {
+        switch (expression->type) {
+            case EXPR_ASSIGN: {
+                auto node = static_cast<AssignmentExpression*>(expression);
+                int slot = slotOf(node->target.get());
+                std::optional<JitType> type;
+
+                if (node->token.type == TokenType::OP_ASSIGN) {
+                    type = emitValue(node->value.get());
+                } else if (auto op = compoundOperator(node->token.type)) {
+                    auto operands = emitOperands(node->target.get(), node->value.get());
+                    if (operands) {
+                        type = arithmetic(*op, operands->first, operands->second);
+                    }
+                }
+
+                // Gán xong mà biến đổi kiểu thì mã máy không còn đúng với các lượt sau
+                if (!type || *type != variables[slot].type) {
+                    return false;
+                }
+                store(slot);
+                return true;
+            }
+            case EXPR_UPDATE_PREFIX:
+            case EXPR_UPDATE_POSTFIX: {
+                bool isPrefix = expression->type == EXPR_UPDATE_PREFIX;
+                Expression* operand = isPrefix
+                    ? static_cast<PrefixUpdateExpression*>(expression)->operand.get()
+                    : static_cast<PostfixUpdateExpression*>(expression)->operand.get();
+                TokenType op = isPrefix
+                    ? static_cast<PrefixUpdateExpression*>(expression)->op
+                    : static_cast<PostfixUpdateExpression*>(expression)->op;
+                int slot = slotOf(operand);
+                if (variables[slot].type != JitType::Int) {
+                    return false;
+                }
+                if (op == TokenType::OP_INCREMENT) {
+                    as.incSlot(slot);
+                } else {
+                    as.decSlot(slot);
+                }
+                return true;
+            }
+            default:
+                return emitValue(expression).has_value();
+        }
+    }
+
+    void store(int slot) {
+        if (variables[slot].type == JitType::Int) {
+            as.movSlotRax(slot);
+        } else {
+            as.movsdSlotXmm0(slot);
+        }
+    }
+
+    // Tính biểu thức vào rax (Int, Bool 0/1) hoặc xmm0 (Real)
+    std::optional<JitType> emitValue(Expression* expression) {
+        switch (expression->type) {
+            case EXPR_LITERAL_INTEGER:
+                as.movRaxImm(static_cast<IntegerLiteral*>(expression)->value);
+                return JitType::Int;
+            case EXPR_LITERAL_REAL:
+                as.movRaxImm(std::bit_cast<int64_t>(static_cast<RealLiteral*>(expression)->value));
+                as.movqXmm0Rax();
+                return JitType::Real;
+            case EXPR_LITERAL_BOOLEAN:
+                as.movRaxImm(static_cast<BooleanLiteral*>(expression)->value ? 1 : 0);
+                return JitType::Bool;
+            case EXPR_IDENTIFIER: {
+                int slot = slotOf(expression);
+                if (variables[slot].type == JitType::Int) {
+                    as.movRaxSlot(slot);
+                } else {
+                    as.movsdXmm0Slot(slot);
+                }
+                return variables[slot].type;
+            }
+            case EXPR_UNARY:
+                return emitUnary(static_cast<UnaryExpression*>(expression));
+            case EXPR_BINARY:
+                return emitBinary(static_cast<BinaryExpression*>(expression));
+            default:
+                return std::nullopt;
+        }
+    }
+
+    std::optional<JitType> emitUnary(UnaryExpression* node) {
+        std::optional<JitType> type = emitValue(node->operand.get());
+        if (!type) {
+            return std::nullopt;
+        }
+
+        switch (node->op) {
+            case TokenType::OP_MINUS:
+                if (*type == JitType::Int) {
+                    as.negRax();
+                    return JitType::Int;
+                }
+                if (*type == JitType::Real) {
+                    as.negXmm0();
+                    return JitType::Real;
+                }
+                return std::nullopt;
+            case TokenType::OP_BIT_NOT:
+                if (*type != JitType::Int) {
+                    return std::nullopt;
+                }
+                as.notRax();
+                return JitType::Int;
+            case TokenType::OP_LOGICAL_NOT:
+                // Như bảng toán tử: !Int là x == 0, !Real là x == 0.0
+                if (*type == JitType::Bool) {
+                    as.xorRaxImm8(1);
+                } else if (*type == JitType::Int) {
+                    as.testRaxRax();
+                    as.setRax(Condition::Equal);
+                } else {
+                    as.ucomisdXmm0Zero();
+                    as.setCl(Condition::NoParity);
+                    as.setRax(Condition::Equal);
+                    as.andAlCl();
+                }
+                return JitType::Bool;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    std::optional<JitType> emitBinary(BinaryExpression* node) {
+        if (node->op == TokenType::OP_LOGICAL_AND || node->op == TokenType::OP_LOGICAL_OR || isComparison(node->op)) {
+            // a && b trả về chính a hoặc b, chỉ khi cả hai là Bool thì mới thu về 0/1 được
+            if (!isBoolean(node)) {
+                return std::nullopt;
+            }
+            Label isFalse, end;
+            if (!branch(node, false, isFalse)) {
+                return std::nullopt;
+            }
+            as.movRaxImm(1);
+            as.jmp(end);
+            as.bind(isFalse);
+            as.movRaxImm(0);
+            as.bind(end);
+            return JitType::Bool;
+        }
+
+        auto operands = emitOperands(node->left.get(), node->right.get());
+        if (!operands) {
+            return std::nullopt;
+        }
+        return arithmetic(node->op, operands->first, operands->second);
+    }
+
+    // Vế trái vào rax/xmm0, vế phải vào rcx/xmm1. Vế phải là biến hoặc hằng thì nạp thẳng,
+    // không thì vế trái phải đợi trên stack trong lúc tính vế phải
+    std::optional<std::pair<JitType, JitType>> emitOperands(Expression* left, Expression* right) {
+        std::optional<JitType> leftType = emitValue(left);
+        if (!leftType) {
+            return std::nullopt;
+        }
+
+        switch (right->type) {
+            case EXPR_LITERAL_INTEGER:
+                as.movRcxImm(static_cast<IntegerLiteral*>(right)->value);
+                return std::pair{*leftType, JitType::Int};
+            case EXPR_LITERAL_REAL:
+                as.movRcxImm(std::bit_cast<int64_t>(static_cast<RealLiteral*>(right)->value));
+                as.movqXmm1Rcx();
+                return std::pair{*leftType, JitType::Real};
+            case EXPR_IDENTIFIER: {
+                int slot = slotOf(right);
+                if (variables[slot].type == JitType::Int) {
+                    as.movRcxSlot(slot);
+                } else {
+                    as.movsdXmm1Slot(slot);
+                }
+                return std::pair{*leftType, variables[slot].type};
+            }
+            default:
+                break;
+        }
+
+        if (*leftType == JitType::Real) {
+            as.movqRaxXmm0();
+        }
+        as.pushRax();
+
+        std::optional<JitType> rightType = emitValue(right);
+        if (!rightType) {
+            return std::nullopt;
+        }
+        if (*rightType == JitType::Real) {
+            as.movapdXmm1Xmm0();
+        } else {
+            as.movRcxRax();
+        }
+
+        as.popRax();
+        if (*leftType == JitType::Real) {
+            as.movqXmm0Rax();
+        }
+        return std::pair{*leftType, *rightType};
+    }
+
+    // Int lẫn Real thì vế Int được đổi sang Real như static_cast<Real> trong bảng toán tử
+    void promote(JitType left, JitType right) {
+        if (left == JitType::Int && right == JitType::Real) {
+            as.cvtsi2sdXmm0Rax();
+        }
+        if (left == JitType::Real && right == JitType::Int) {
+            as.cvtsi2sdXmm1Rcx();
+        }
+    }
+
+    std::optional<JitType> arithmetic(TokenType op, JitType left, JitType right) {
+        using enum TokenType;
+
+        if (left == JitType::Bool || right == JitType::Bool) {
+            return std::nullopt;
+        }
+
+        if (left == JitType::Int && right == JitType::Int) {
+            switch (op) {
+                case OP_PLUS:     as.addRaxRcx(); return JitType::Int;
+                case OP_MINUS:    as.subRaxRcx(); return JitType::Int;
+                case OP_MULTIPLY: as.imulRaxRcx(); return JitType::Int;
+                case OP_BIT_AND:  as.andRaxRcx(); return JitType::Int;
+                case OP_BIT_OR:   as.orRaxRcx(); return JitType::Int;
+                case OP_BIT_XOR:  as.xorRaxRcx(); return JitType::Int;
+                case OP_LSHIFT:   as.shlRaxCl(); return JitType::Int;
+                case OP_RSHIFT:   as.sarRaxCl(); return JitType::Int;
+                case OP_DIVIDE:
+                    // Int / Int ra Real; chia cho 0 thì để tree walker tính NaN/inf như bảng
+                    as.testRcxRcx();
+                    as.jcc(Condition::Equal, deopt);
+                    as.cvtsi2sdXmm0Rax();
+                    as.cvtsi2sdXmm1Rcx();
+                    as.divsd();
+                    return JitType::Real;
+                case OP_MODULO: {
+                    // % 0 là lỗi lúc chạy, để tree walker báo. % -1 luôn là 0 nhưng idiv sẽ tràn với INT64_MIN
+                    Label divide, end;
+                    as.testRcxRcx();
+                    as.jcc(Condition::Equal, deopt);
+                    as.cmpRcxImm8(-1);
+                    as.jcc(Condition::NotEqual, divide);
+                    as.movRaxImm(0);
+                    as.jmp(end);
+                    as.bind(divide);
+                    as.idivRcx();
+                    as.movRaxRdx();
+                    as.bind(end);
+                    return JitType::Int;
+                }
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        // Chia với một vế Int: bảng toán tử tự xử lý số chia bằng 0, trả lại cho tree walker
+        if (op == OP_DIVIDE && right == JitType::Int) {
+            as.testRcxRcx();
+            as.jcc(Condition::Equal, deopt);
+        } else if (op == OP_DIVIDE && left == JitType::Int) {
+            Label nonZero;
+            as.ucomisdXmm1Zero();
+            as.jcc(Condition::Parity, nonZero);
+            as.jcc(Condition::Equal, deopt);
+            as.bind(nonZero);
+        }
+
+        promote(left, right);
+        switch (op) {
+            case OP_PLUS:     as.addsd(); return JitType::Real;
+            case OP_MINUS:    as.subsd(); return JitType::Real;
+            case OP_MULTIPLY: as.mulsd(); return JitType::Real;
+            case OP_DIVIDE:   as.divsd(); return JitType::Real;
+            default:          return std::nullopt;
+        }
+    }
+
+    std::optional<Comparison> emitComparison(BinaryExpression* node) {
+        using enum TokenType;
+
+        auto operands = emitOperands(node->left.get(), node->right.get());
+        if (!operands) {
+            return std::nullopt;
+        }
+        auto [left, right] = *operands;
+        if (left == JitType::Bool || right == JitType::Bool) {
+            return std::nullopt;
+        }
+
+        if (left == JitType::Int && right == JitType::Int) {
+            as.cmpRaxRcx();
+            switch (node->op) {
+                case OP_EQ:  return Comparison{Condition::Equal};
+                case OP_NEQ: return Comparison{Condition::NotEqual};
+                case OP_LT:  return Comparison{Condition::Less};
+                case OP_GT:  return Comparison{Condition::Greater};
+                case OP_LE:  return Comparison{Condition::LessEqual};
+                default:     return Comparison{Condition::GreaterEqual};
+            }
+        }
+
+        // Với Real chỉ dùng cờ above/aboveEqual để so sánh với NaN tự ra false như trong C++
+        promote(left, right);
+        switch (node->op) {
+            case OP_LT:
+                as.ucomisdXmm1Xmm0();
+                return Comparison{Condition::Above};
+            case OP_LE:
+                as.ucomisdXmm1Xmm0();
+                return Comparison{Condition::AboveEqual};
+            case OP_GT:
+                as.ucomisdXmm0Xmm1();
+                return Comparison{Condition::Above};
+            case OP_GE:
+                as.ucomisdXmm0Xmm1();
+                return Comparison{Condition::AboveEqual};
+            case OP_EQ:
+                as.ucomisdXmm0Xmm1();
+                return Comparison{Condition::Equal, true, false};
+            default:
+                as.ucomisdXmm0Xmm1();
+                return Comparison{Condition::NotEqual, true, true};
+        }
+    }
+
+    // Nhảy tới target khi độ truthy của biểu thức bằng jumpWhen, không thì chạy tiếp
+    bool branch(Expression* expression, bool jumpWhen, Label& target) {
+        if (expression->type == EXPR_BINARY) {
+            auto node = static_cast<BinaryExpression*>(expression);
+
+            // a && b truthy đúng khi cả a và b truthy, a || b khi một trong hai truthy
+            if (node->op == TokenType::OP_LOGICAL_AND || node->op == TokenType::OP_LOGICAL_OR) {
+                bool isAnd = node->op == TokenType::OP_LOGICAL_AND;
+                if (jumpWhen != isAnd) {
+                    return branch(node->left.get(), jumpWhen, target) && branch(node->right.get(), jumpWhen, target);
+                }
+                Label skip;
+                if (!branch(node->left.get(), !jumpWhen, skip) || !branch(node->right.get(), jumpWhen, target)) {
+                    return false;
+                }
+                as.bind(skip);
+                return true;
+            }
+
+            if (isComparison(node->op)) {
+                std::optional<Comparison> comparison = emitComparison(node);
+                if (!comparison) {
+                    return false;
+                }
+                jump(*comparison, jumpWhen, target);
+                return true;
+            }
+        }
+
+        if (expression->type == EXPR_UNARY) {
+            auto node = static_cast<UnaryExpression*>(expression);
+            if (node->op == TokenType::OP_LOGICAL_NOT && isBoolean(node->operand.get())) {
+                return branch(node->operand.get(), !jumpWhen, target);
+            }
+        }
+
+        if (expression->type == EXPR_LITERAL_BOOLEAN) {
+            if (static_cast<BooleanLiteral*>(expression)->value == jumpWhen) {
+                as.jmp(target);
+            }
+            return true;
+        }
+
+        std::optional<JitType> type = emitValue(expression);
+        if (!type) {
+            return false;
+        }
+        if (*type == JitType::Bool) {
+            as.testRaxRax();
+            as.jcc(jumpWhen ? Condition::NotEqual : Condition::Equal, target);
+        } else if (jumpWhen) {
+            // Int và Real luôn truthy, kể cả 0
+            as.jmp(target);
+        }
+        return true;
+    }
+
+    void jump(const Comparison& comparison, bool jumpWhen, Label& target) {
+        Condition condition = jumpWhen ? comparison.condition : negate(comparison.condition);
+        if (!comparison.checksParity) {
+            as.jcc(condition, target);
+            return;
+        }
+
+        Label skip;
+        as.jcc(Condition::Parity, comparison.unorderedResult == jumpWhen ? target : skip);
+        as.jcc(condition, target);
+        as.bind(skip);
+    }
+};
+
+}
+
+struct LoopJit::CompiledLoop {
+    std::vector<JitVariable> variables;
+    // nullptr: vòng lặp không dịch được hoặc đã bị huỷ, luôn chạy thông dịch
+    std::unique_ptr<NativeCode> code;
+    uint8_t deopts = 0;
+
+    // Dùng lại giữa các lần vào. frame gồm giá trị các biến rồi tới bản chụp đầu lượt
+    std::vector<Variable*> bindings;
+    std::vector<int64_t> frame;
+
+    bool deoptimize() {
+        if (++deopts >= maxDeopts) {
+            code.reset();
+        }
+        return false;
+    }
+};
+
+LoopJit::LoopJit() = default;
+LoopJit::~LoopJit() = default;
+
+bool LoopJit::isAvailable() {
+    if (!MEOW_JIT_SUPPORTED) {
+        return false;
+    }
+    const char* setting = std::getenv("MEOW_JIT");
+    return setting == nullptr || std::strcmp(setting, "0") != 0;
+}
+
+std::unique_ptr<LoopJit::CompiledLoop> LoopJit::compile(Statement* loop, Environment* env) {
+    auto compiled = std::make_unique<CompiledLoop>();
+
+    LoopCompiler compiler(env);
+    if (compiler.compile(loop)) {
+        compiled->variables = std::move(compiler.variables);
+        compiled->code = NativeCode::install(compiler.bytes());
+        compiled->bindings.resize(compiled->variables.size());
+        compiled->frame.resize(compiled->variables.size() * 2);
+    }
+    return compiled;
+}
+
+bool LoopJit::run(Statement* loop, Environment* env) {
+    std::unique_ptr<CompiledLoop>& compiled = loops[loop];
+    if (compiled == nullptr) {
+        compiled = compile(loop, env);
+    }
+    if (compiled->code == nullptr) {
+        return false;
+    }
+
+    // Guard: các biến vẫn còn đó, đúng kiểu lúc dịch và ghi được
+    size_t count = compiled->variables.size();
+    for (size_t i = 0; i < count; ++i) {
+        const JitVariable& variable = compiled->variables[i];
+        Variable* binding = resolve(env, variable.identifier);
+        if (binding == nullptr || typeOf(binding->value) != variable.type || (variable.isWritten && binding->isConstant)) {
+            return compiled->deoptimize();
+        }
+        compiled->bindings[i] = binding;
+        compiled->frame[i] = variable.type == JitType::Int
+            ? std::get<Int>(binding->value)
+            : std::bit_cast<int64_t>(std::get<Real>(binding->value));
+    }
+
+    int64_t status = (*compiled->code)(compiled->frame.data());
+
+    // Thoát hay trượt guard thì frame cũng đang giữ trạng thái đúng, ghi lại vào các biến
+    for (size_t i = 0; i < count; ++i) {
+        const JitVariable& variable = compiled->variables[i];
+        if (!variable.isWritten) {
+            continue;
+        }
+        if (variable.type == JitType::Int) {
+            compiled->bindings[i]->value = Value(compiled->frame[i]);
+        } else {
+            compiled->bindings[i]->value = Value(std::bit_cast<Real>(compiled->frame[i]));
+        }
+    }
+
+    if (status != 0) {
+        return compiled->deoptimize();
+    }
+    return true;
+}
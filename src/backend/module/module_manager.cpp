@@ -5,9 +5,11 @@
 #include <filesystem>
 
 #include "common/source_file.hpp"
-#include "lexer/lexer.hpp"
 #include "parser/parser.hpp"
+#include "resolver/resolver.hpp"
 #include "visitor/tree_walker.hpp"
+#include "visitor/closure_compiler.hpp"
+#include "vm/virtual_machine.hpp"
 
 #include <cstdlib>   // std::getenv
 #include <vector>
@@ -76,6 +78,22 @@ ModuleManager::ModuleManager(int argc, char* arguments[]) : ModuleManager() {
             g_includePaths.emplace_back(arguments[++i]);
         } else if (a.rfind("-I", 0) == 0 && a.size() > 2) { // -Ipath
             g_includePaths.emplace_back(a.substr(2));
+        } else if (a == "--backend=vm") {
+            backend = Backend::Bytecode;
+        } else if (a == "--backend=tree") {
+            backend = Backend::TreeWalker;
+        } else if (a == "--backend=closure") {
+            backend = Backend::Closure;
+        } else if (a == "-O0") {
+            optimizationLevel = OptimizationLevel::O0;
+        } else if (a == "-O1") {
+            optimizationLevel = OptimizationLevel::O1;
+        } else if (a == "-O2") {
+            optimizationLevel = OptimizationLevel::O2;
+        } else if (a == "--opt-stats") {
+            printsOptimizerStats = true;
+        } else if (a == "--jit") {
+            enablesJit = true;
         }
     }
 }
@@ -87,7 +105,7 @@ Value ModuleManager::load(const std::string& importerPath, const std::string& im
         }
 
         const auto& library = nativeModules.at(importPath);
-        auto exportsObj = std::make_shared<ObjectData>();
+        auto exportsObj = makeRef<ObjectData>();
         for(const auto& pair : library->contents) {
             exportsObj->pairs[HashKey{(Value(pair.first))}] = pair.second;
         }
@@ -156,20 +174,17 @@ Value ModuleManager::load(const std::string& importerPath, const std::string& im
     }
 
     SrcFilePtr srcFile = std::make_unique<SourceFile>(canonicalPath);
-    Lexer lexer(srcFile);
-    auto tokens = lexer.tokenize();
-    Parser parser(tokens);
+    Parser parser(srcFile);
     auto program = parser.parseProgram();
+    prepare(program.get(), canonicalPath);
 
     ParsedModule astModule;
     astModule.ast = std::move(program);
-    astModule.exports = Value(Object(std::make_shared<ObjectData>()));
+    astModule.exports = Value(Object(makeRef<ObjectData>()));
     
     auto& cachedModule = (moduleCache[canonicalPath] = std::move(astModule));
 
-    TreeWalker moduleWalker(this, srcFile, &cachedModule.exports, argv);
-    moduleWalker.isModuleContext = true;
-    moduleWalker.visit(cachedModule.ast.get());
+    run(cachedModule, srcFile, true);
     
     return cachedModule.exports;
 }
@@ -181,19 +196,58 @@ Value ModuleManager::loadFromSource(const std::string& moduleKey, const std::str
     }
 
     SrcFilePtr srcFile = std::make_unique<SourceFile>(sourceCode); 
-    Lexer lexer(srcFile);
-    auto tokens = lexer.tokenize();
-    Parser parser(tokens);
+    Parser parser(srcFile);
     auto program = parser.parseProgram();
+    prepare(program.get(), moduleKey);
 
     ParsedModule astModule;
     astModule.ast = std::move(program);
-    astModule.exports = Value(Object(std::make_shared<ObjectData>()));
+    astModule.exports = Value(Object(makeRef<ObjectData>()));
 
     auto& cachedModule = (moduleCache[moduleKey] = std::move(astModule));
 
-    TreeWalker moduleWalker(this, srcFile, &cachedModule.exports, argv.empty() ? std::vector<std::string>{} : argv);
-    moduleWalker.visit(cachedModule.ast.get());
+    run(cachedModule, srcFile, false);
 
     return cachedModule.exports;
 }
+
+ModuleManager::~ModuleManager() = default;
+
+void ModuleManager::prepare(Program* program, const std::string& moduleName) {
+    Optimizer optimizer(optimizationLevel);
+    optimizer.optimize(program);
+
+    if (printsOptimizerStats) {
+        for (const auto& pass : optimizer.statistics()) {
+            std::cerr << "[optimizer] " << moduleName << ": " << pass.name << " đã biến đổi " << pass.rewrites << " node\n";
+        }
+    }
+
+    Resolver().resolve(program);
+}
+
+void ModuleManager::run(ParsedModule& module, const SrcFilePtr& srcFile, bool isModuleContext) {
+    if (backend == Backend::Bytecode) {
+        auto machine = std::make_unique<VirtualMachine>(this, srcFile, &module.exports, argv, &chunkCache);
+        VirtualMachine* vm = machine.get();
+        machines.push_back(std::move(machine));
+
+        vm->isModuleContext = isModuleContext;
+        vm->runProgram(module.ast.get());
+        return;
+    }
+
+    if (backend == Backend::Closure) {
+        ClosureCompiler compiler(this, srcFile, &module.exports, argv);
+        compiler.isModuleContext = isModuleContext;
+        compiler.run(module.ast.get());
+        return;
+    }
+
+    TreeWalker moduleWalker(this, srcFile, &module.exports, argv);
+    moduleWalker.isModuleContext = isModuleContext;
+    if (enablesJit) {
+        moduleWalker.enableJit();
+    }
+    moduleWalker.visit(module.ast.get());
+}
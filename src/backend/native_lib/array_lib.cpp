@@ -39,7 +39,7 @@ Value native_array_slice(Arguments args) {
     start = std::max((Int)0, start);
     end = std::min((Int)arr->elements.size(), end);
 
-    auto newArrData = std::make_shared<ArrayData>();
+    auto newArrData = makeRef<ArrayData>();
     if (start < end) {
         for (Int i = start; i < end; ++i) {
             newArrData->elements.push_back(arr->elements[i]);
@@ -53,7 +53,7 @@ Value native_array_map(Interpreter* engine, Arguments args) {
     const auto& arr = std::get<Array>(args[0]);
     const auto& callback = std::get<Function>(args[1]);
     
-    auto newArrData = std::make_shared<ArrayData>();
+    auto newArrData = makeRef<ArrayData>();
     newArrData->elements.reserve(arr->elements.size());
 
     for (const auto& element : arr->elements) {
@@ -69,7 +69,7 @@ Value native_array_filter(Interpreter* engine, Arguments args) {
     const auto& arr = std::get<Array>(args[0]);
     const auto& callback = std::get<Function>(args[1]);
 
-    auto newArrData = std::make_shared<ArrayData>();
+    auto newArrData = makeRef<ArrayData>();
 
     for (const auto& element : arr->elements) {
 
@@ -78,9 +78,9 @@ Value toInt(Arguments args) {
     const auto& val = args[0];
     if (std::holds_alternative<Instance>(val)) {
         Instance instance = std::get<Instance>(val);
-        Function method = instance->klass->findMethod("__int__");
+        Function method = instance->klass->protocol(Protocol::Int);
         if (method) {
-            return MeowScriptBoundMethod(instance, method).call(instance->engine, {});
+            return MeowScriptBoundMethod::invoke(instance->engine, instance, method, {});
         }
     }
     return visit(overloaded{
@@ -134,9 +134,9 @@ Value toReal(Arguments args) {
     const auto& val = args[0];
     if (std::holds_alternative<Instance>(val)) {
         Instance instance = std::get<Instance>(val);
-        Function method = instance->klass->findMethod("__real__");
+        Function method = instance->klass->protocol(Protocol::Real);
         if (method) {
-            return MeowScriptBoundMethod(instance, method).call(instance->engine, {});
+            return MeowScriptBoundMethod::invoke(instance->engine, instance, method, {});
         }
     }
     return visit(overloaded{
@@ -172,9 +172,9 @@ Value toBool(Arguments args) {
     const auto& val = args[0];
     if (std::holds_alternative<Instance>(val)) {
         Instance instance = std::get<Instance>(val);
-        Function method = instance->klass->findMethod("__bool__");
+        Function method = instance->klass->protocol(Protocol::Bool);
         if (method) {
-            return MeowScriptBoundMethod(instance, method).call(instance->engine, {});
+            return MeowScriptBoundMethod::invoke(instance->engine, instance, method, {});
         }
     }
     return visit(overloaded{
@@ -204,9 +204,9 @@ Value toArray(Arguments args) {
     const auto& val = args[0];
     if (std::holds_alternative<Instance>(val)) {
         Instance instance = std::get<Instance>(val);
-        Function method = instance->klass->findMethod("__array__");
+        Function method = instance->klass->protocol(Protocol::Array);
         if (method) {
-            return MeowScriptBoundMethod(instance, method).call(instance->engine, {});
+            return MeowScriptBoundMethod::invoke(instance->engine, instance, method, {});
         }
     }
     return visit(overloaded{
@@ -219,14 +219,14 @@ Value toArray(Arguments args) {
             return Value(a);
         },
         [](const String& s) {
-            auto arrData = std::make_shared<ArrayData>();
+            auto arrData = makeRef<ArrayData>();
             for (char c : s->str) {
-                arrData->elements.push_back(Value(std::make_shared<StringData>(1, c)));
+                arrData->elements.push_back(Value(makeRef<StringData>(1, c)));
             }
             return Value(arrData);
         },
         [](const Object& o) {
-             auto arrData = std::make_shared<ArrayData>();
+             auto arrData = makeRef<ArrayData>();
              for(const auto& pair : o->pairs){
                  arrData->elements.push_back(pair.second);
              }
@@ -242,9 +242,9 @@ Value toObject(Arguments args) {
     const auto& val = args[0];
     if (std::holds_alternative<Instance>(val)) {
         Instance instance = std::get<Instance>(val);
-        Function method = instance->klass->findMethod("__object__");
+        Function method = instance->klass->protocol(Protocol::Object);
         if (method) {
-            return MeowScriptBoundMethod(instance, method).call(instance->engine, {});
+            return MeowScriptBoundMethod::invoke(instance->engine, instance, method, {});
         }
     }
     return visit(overloaded{
@@ -252,7 +252,7 @@ Value toObject(Arguments args) {
             return Value(o);
         },
         [](const Array& a) -> Value {
-            auto objData = std::make_shared<ObjectData>();
+            auto objData = makeRef<ObjectData>();
             for(const auto& item : a->elements){
                 if(std::holds_alternative<Array>(item)){
                     const auto& pair = std::get<Array>(item)->elements;
@@ -268,13 +268,12 @@ Value toObject(Arguments args) {
             return Value(objData);
         },
         [](const Instance& i) -> Value {
-            auto newObj = std::make_shared<ObjectData>();
-            newObj->pairs = i->fields->pairs;
+            auto newObj = i->copyFields();
             newObj->pairs.emplace(HashKey{Value("__class__")}, i->klass);
             return Value(newObj);
         },
         [](const Class& c) -> Value {
-            auto objData = std::make_shared<ObjectData>();
+            auto objData = makeRef<ObjectData>();
             for(const auto& pair : c->static_fields){
                 objData->pairs.emplace(HashKey{Value(pair.first)}, pair.second);
             }
@@ -300,8 +299,8 @@ Value toInstance(Interpreter* engine, Arguments args) {
             
             const Class& klass = std::get<Class>(classIt->second);
             
-            Instance instance = std::make_shared<MeowScriptInstance>(klass, engine);
-            instance->fields = o;
+            Instance instance = makeRef<MeowScriptInstance>(klass, engine);
+            instance->adoptFields(o);
             
             return Value(instance);
         },
@@ -371,7 +370,7 @@ Value native_range(Arguments args) {
         throw FunctionException("Tham số 'step' của hàm range() không thể bằng 0.");
     }
 
-    auto resultArrayData = std::make_shared<ArrayData>();
+    auto resultArrayData = makeRef<ArrayData>();
     
     if (step > 0) {
         for (Int i = start; i < stop; i += step) {
@@ -125,7 +125,7 @@ Value listDir(Arguments args) {
         throw FunctionException("Hàm 'listDir' yêu cầu tham số là chuỗi đường dẫn.");
     }
     const std::string& path_str = std::get<String>(args[0])->str;
-    auto arrData = std::make_shared<ArrayData>();
+    auto arrData = makeRef<ArrayData>();
     try {
         for (const auto& entry : fs::directory_iterator(path_str)) {
             arrData->elements.push_back(Value(entry.path().string()));
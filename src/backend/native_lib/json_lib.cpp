@@ -62,7 +62,7 @@ private:
     Value parseObject() {
         expectChar('{');
         skipWhitespace();
-        auto objData = std::make_shared<ObjectData>();
+        auto objData = makeRef<ObjectData>();
         skipWhitespace();
         if (peek() == '}') { advance(); return Value(objData); }
 
@@ -86,7 +86,7 @@ private:
     Value parseArray() {
         expectChar('[');
         skipWhitespace();
-        auto arrData = std::make_shared<ArrayData>();
+        auto arrData = makeRef<ArrayData>();
         if (peek() == ']') { advance(); return Value(arrData); }
 
         while (true) {
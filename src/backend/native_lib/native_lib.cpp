@@ -9,7 +9,7 @@ struct Arity;
 void NativeLibrary::registerFn(const std::string& name, NativeFnSimple fn, Arity arity) {
     auto data = std::make_shared<NativeFunction>(name, fn, arity);
 
-    auto callable = std::make_shared<NativeCallable>(data);
+    auto callable = makeRef<NativeCallable>(data);
 
     contents[name] = Value(Function(callable));
 }
@@ -21,7 +21,7 @@ void NativeLibrary::registerFn(const std::string& name, NativeFnSimple fn, int a
 void NativeLibrary::registerFn(const std::string& name, NativeFnAdvanced fn, Arity arity) {
     auto data = std::make_shared<NativeFunction>(name, fn, arity);
 
-    auto callable = std::make_shared<NativeCallable>(data);
+    auto callable = makeRef<NativeCallable>(data);
 
     contents[name] = Value(Function(callable));
 }
@@ -5,7 +5,7 @@
 
 Value native_object_keys(Arguments args) {
     const auto& obj = std::get<Object>(args[0]);
-    auto resultArr = std::make_shared<ArrayData>();
+    auto resultArr = makeRef<ArrayData>();
     for (const auto& pair : obj->pairs) {
         resultArr->elements.push_back(pair.first.value);
     }
@@ -14,7 +14,7 @@ Value native_object_keys(Arguments args) {
 
 Value native_object_values(Arguments args) {
     const auto& obj = std::get<Object>(args[0]);
-    auto resultArr = std::make_shared<ArrayData>();
+    auto resultArr = makeRef<ArrayData>();
     for (const auto& pair : obj->pairs) {
         resultArr->elements.push_back(pair.second);
     }
@@ -23,9 +23,9 @@ Value native_object_values(Arguments args) {
 
 Value native_object_entries(Arguments args) {
     const auto& obj = std::get<Object>(args[0]);
-    auto resultArr = std::make_shared<ArrayData>();
+    auto resultArr = makeRef<ArrayData>();
     for (const auto& pair : obj->pairs) {
-        auto entry = std::make_shared<ArrayData>();
+        auto entry = makeRef<ArrayData>();
         entry->elements.push_back(pair.first.value);
         entry->elements.push_back(pair.second);
         resultArr->elements.push_back(Value(entry));
@@ -43,7 +43,7 @@ Value native_object_has(Arguments args) {
 }
 
 Value native_object_merge(Arguments args) {
-    auto resultObj = std::make_shared<ObjectData>();
+    auto resultObj = makeRef<ObjectData>();
     for (const auto& arg : args) {
         if (!std::holds_alternative<Object>(arg)) {
             throw FunctionException("Hàm merge() chỉ chấp nhận các tham số là object.");
@@ -13,7 +13,7 @@ Value native_string_split(Arguments args) {
     std::string delimiter = " ";
     if (args.size() > 1) delimiter = valToStdStr(args[1]);
 
-    auto result = std::make_shared<ArrayData>();
+    auto result = makeRef<ArrayData>();
     size_t start = 0, end;
     while ((end = str.find(delimiter, start)) != std::string::npos) {
         result->elements.emplace_back(str.substr(start, end - start));
@@ -39,11 +39,11 @@ Value native_system_exec(Arguments args) {
 }
 
 Value nativeArgv(Interpreter* engine, Arguments args) {
-    Array arr = std::make_shared<ArrayData>();
+    Array arr = makeRef<ArrayData>();
     arr->elements.reserve(engine->getArgv().size());
 
     for (const auto &a : engine->getArgv()) {
-        String str = std::make_shared<StringData>(a);
+        String str = makeRef<StringData>(a);
         arr->elements.push_back(Value(str));
     }
 
@@ -0,0 +1,194 @@
+#include "runtime/inline_cache.hpp"
+#include "runtime/oop.hpp"
+
+namespace {
+    // Tên dạng __xxx__ có xử lý riêng trong MeowScriptInstance::get/MeowScriptClass::get, không cache
+    bool isDunder(const std::string& name) {
+        return name.size() >= 4 && name.compare(0, 2, "__") == 0 && name.compare(name.size() - 2, 2, "__") == 0;
+    }
+}
+
+void PropertyCache::record(Entry entry) {
+    if (isMegamorphic) {
+        return;
+    }
+    // Entry cũ cùng guard đã hết hạn (version đổi hoặc trường mang giá trị null), thay bằng entry mới
+    std::erase_if(entries, [&entry](const Entry& old) {
+        return old.kind == entry.kind && old.shape == entry.shape && old.klass == entry.klass;
+    });
+    if (entries.size() >= maxEntries) {
+        entries.clear();
+        entries.shrink_to_fit();
+        isMegamorphic = true;
+        return;
+    }
+    entries.push_back(std::move(entry));
+}
+
+Value PropertyCache::get(MeowScriptInstance* instance, const String& key) {
+    Shape* shape = instance->shape.get();
+
+    if (shape != nullptr) {
+        for (const auto& entry : entries) {
+            if (entry.shape.get() != shape) {
+                continue;
+            }
+            if (entry.kind == Kind::Field) {
+                const Value& value = instance->slots[entry.slot];
+                // Trường mang giá trị null vẫn phải đi tiếp sang phương thức và __getitem__ như get()
+                if (!std::holds_alternative<Null>(value)) {
+                    return value;
+                }
+                break;
+            }
+            if (entry.kind == Kind::Method && entry.version == instance->klass->lookupVersion()) {
+                return makeRef<MeowScriptBoundMethod>(Instance(instance), std::get<Function>(entry.value));
+            }
+        }
+    }
+
+    Value result = instance->get(key);
+
+    if (shape == nullptr || isMegamorphic || instance->shape.get() != shape) {
+        return result;
+    }
+
+    int slot = shape->slotOf(key.get());
+    if (slot >= 0) {
+        record(Entry{Kind::Field, slot, 0, instance->shape, nullptr, nullptr, Value(Null{})});
+        return result;
+    }
+
+    const std::string& name = key->str;
+    if (isDunder(name) || objectLib->contents.count(name)) {
+        return result;
+    }
+    if (Function method = instance->klass->findMethod(name)) {
+        record(Entry{Kind::Method, -1, instance->klass->lookupVersion(), instance->shape, nullptr, nullptr, Value(method)});
+    }
+    return result;
+}
+
+Value PropertyCache::getField(MeowScriptInstance* instance, const String& key) {
+    Shape* shape = instance->shape.get();
+
+    if (shape != nullptr) {
+        for (const auto& entry : entries) {
+            if (entry.shape.get() == shape && entry.kind == Kind::Field) {
+                return instance->slots[entry.slot];
+            }
+        }
+    }
+
+    Value result = instance->getField(key);
+
+    if (shape != nullptr && !isMegamorphic) {
+        int slot = shape->slotOf(key.get());
+        if (slot >= 0) {
+            record(Entry{Kind::Field, slot, 0, instance->shape, nullptr, nullptr, Value(Null{})});
+        }
+    }
+    return result;
+}
+
+void PropertyCache::setField(MeowScriptInstance* instance, const String& key, const Value& value) {
+    ShapeRef before = instance->shape;
+
+    if (before != nullptr) {
+        for (const auto& entry : entries) {
+            if (entry.shape != before) {
+                continue;
+            }
+            if (entry.kind == Kind::Field) {
+                instance->slots[entry.slot] = value;
+                return;
+            }
+            if (entry.kind == Kind::Transition) {
+                instance->shape = entry.target;
+                instance->slots.push_back(value);
+                instance->klass->slotHint = std::max(instance->klass->slotHint, instance->slots.size());
+                return;
+            }
+        }
+    }
+
+    instance->setField(key, value);
+
+    if (before == nullptr || instance->shape == nullptr || isMegamorphic) {
+        return;
+    }
+
+    if (instance->shape == before) {
+        record(Entry{Kind::Field, before->slotOf(key.get()), 0, before, nullptr, nullptr, Value(Null{})});
+    } else {
+        int slot = static_cast<int>(instance->slots.size()) - 1;
+        record(Entry{Kind::Transition, slot, 0, before, instance->shape, nullptr, Value(Null{})});
+    }
+}
+
+Value* PropertyCache::fieldSlot(MeowScriptInstance* instance, const String& key) {
+    Shape* shape = instance->shape.get();
+
+    if (shape != nullptr) {
+        for (const auto& entry : entries) {
+            if (entry.shape.get() == shape && entry.kind == Kind::Field) {
+                return &instance->slots[entry.slot];
+            }
+        }
+    }
+    return instance->fieldSlot(key);
+}
+
+Function PropertyCache::findMethod(const Value& receiver, const String& key) {
+    auto instancePtr = std::get_if<Instance>(&receiver);
+    if (instancePtr == nullptr) {
+        return findNativeMethod(receiver, key);
+    }
+
+    MeowScriptInstance* instance = instancePtr->get();
+    Shape* shape = instance->shape.get();
+
+    if (shape != nullptr) {
+        for (const auto& entry : entries) {
+            if (entry.shape.get() != shape) {
+                continue;
+            }
+            if (entry.kind == Kind::Method && entry.version == instance->klass->lookupVersion()) {
+                return std::get<Function>(entry.value);
+            }
+            if (entry.kind == Kind::Field && !std::holds_alternative<Null>(instance->slots[entry.slot])) {
+                return nullptr;
+            }
+        }
+    }
+
+    const std::string& name = key->str;
+    if (isDunder(name) || objectLib->contents.count(name)) {
+        return nullptr;
+    }
+    if (!std::holds_alternative<Null>(instance->getField(key))) {
+        return nullptr;
+    }
+
+    Function method = instance->klass->findMethod(name);
+    if (method != nullptr && shape != nullptr && shape->slotOf(key.get()) < 0) {
+        record(Entry{Kind::Method, -1, instance->klass->lookupVersion(), instance->shape, nullptr, nullptr, Value(method)});
+    }
+    return method;
+}
+
+Value PropertyCache::get(MeowScriptClass* klass, const String& key) {
+    for (const auto& entry : entries) {
+        if (entry.kind == Kind::Static && entry.klass.get() == klass && entry.version == klass->version) {
+            return entry.value;
+        }
+    }
+
+    Value result = klass->get(key);
+
+    const std::string& name = key->str;
+    if (!isMegamorphic && !isDunder(name) && klass->static_fields.count(name)) {
+        record(Entry{Kind::Static, -1, klass->version, nullptr, nullptr, Class(klass), result});
+    }
+    return result;
+}
@@ -0,0 +1,26 @@
+#include "runtime/intern.hpp"
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+    // Key là view vào chính chuỗi của atom: chuỗi bất biến và atom không bao giờ bị giải phóng
+    std::unordered_map<std::string_view, String>& internTable() {
+        static std::unordered_map<std::string_view, String> table;
+        return table;
+    }
+}
+
+String intern(const std::string& str) {
+    auto& table = internTable();
+
+    auto it = table.find(str);
+    if (it != table.end()) {
+        return it->second;
+    }
+
+    String atom = makeRef<StringData>(str);
+    atom->isInterned = true;
+    atom->hash();
+    table.emplace(atom->str, atom);
+    return atom;
+}
@@ -0,0 +1,29 @@
+#include "runtime/interpreter.hpp"
+#include "diagnostics/meow_exceptions.hpp"
+#include <sstream>
+
+void Interpreter::throwArityError(const Arity& arity, const Value& callee, Arguments args) {
+    if (arity.isVariadic) {
+        throw FunctionException("Hàm cần ít nhất " + std::to_string(arity.required) + " tham số.");
+    }
+
+    std::ostringstream os;
+    os << "Hàm cần từ " + std::to_string(arity.required) + " đến "
+                        + std::to_string(arity.required + arity.optional) + " tham số.";
+
+    os << " Nhưng lại nhận được '" << args.size() << "' tham số. Các tham số đó là: ";
+    for (const auto& arg : args) {
+        os << arg << " ";
+    }
+    os << ". Và callee là: " << callee << "\n";
+    throw FunctionException(os.str());
+}
+
+void Interpreter::throwNotCallable(const Value& callee, Arguments args) {
+    std::ostringstream os;
+    os << "Đối tượng này không thể gọi được: '" << callee << "' với các tham số là: ";
+    for (const auto& a : args) {
+        os << "'" << a << "'" << " ";
+    }
+    throw FunctionException(os.str());
+}
@@ -1,5 +1,6 @@
 #include "runtime/oop.hpp"
 #include "runtime/value.hpp"
+#include "runtime/intern.hpp"
 #include "runtime/environment.hpp"
 #include "runtime/interpreter.hpp"
 #include "runtime/function_arity.hpp"
@@ -7,8 +8,32 @@
 #include "callable/function_callable.hpp"
 #include "diagnostics/meow_exceptions.hpp"
 
-Value MeowScriptClass::call(Interpreter* engine, const std::vector<Value>& args) {
-    Instance instance = std::make_shared<MeowScriptInstance>(shared_from_this(), engine);
+int Shape::slotOf(const StringData* key) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (stringEquals(keys[i].get(), key)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+ShapeRef Shape::withKey(const String& key) {
+    String atom = key->isInterned ? key : intern(key->str);
+
+    auto it = transitions.find(atom.get());
+    if (it != transitions.end()) {
+        return it->second;
+    }
+
+    auto child = makeRef<Shape>();
+    child->keys = keys;
+    child->keys.push_back(atom);
+    transitions.emplace(atom.get(), child);
+    return child;
+}
+
+Value MeowScriptClass::call(Interpreter* engine, Arguments args) {
+    Instance instance = makeRef<MeowScriptInstance>(Class(this), engine);
 
     Function initializer = nullptr;
 
@@ -22,22 +47,73 @@ Value MeowScriptClass::call(Interpreter* engine, const std::vector<Value>& args)
     return instance;
 }
 
-Function MeowScriptClass::findMethod(const std::string& methodName) const {
-    if (methods.count(methodName)) {
-        return methods.at(methodName);
+namespace {
+    constexpr std::array<const char*, static_cast<size_t>(Protocol::_TOTAL_PROTOCOLS)> protocolNames = {
+        "__getitem__", "__setitem__", "__str__", "__call__", "__iterator__", "__next__",
+        "__int__", "__real__", "__bool__", "__array__", "__object__",
+    };
+}
+
+void MeowScriptClass::ensureFlattened() const {
+    uint32_t currentVersion = lookupVersion();
+    if (flatVersion == currentVersion) {
+        return;
     }
-    
+
     if (superclass != nullptr) {
-        return superclass->findMethod(methodName);
+        superclass->ensureFlattened();
+        flatMethods = superclass->flatMethods;
+    } else {
+        flatMethods.clear();
+    }
+    for (const auto& [methodName, method] : methods) {
+        flatMethods[methodName] = method;
+    }
+
+    for (size_t i = 0; i < protocolNames.size(); ++i) {
+        auto it = flatMethods.find(protocolNames[i]);
+        protocolSlots[i] = it != flatMethods.end() ? it->second : nullptr;
+    }
+    flatVersion = currentVersion;
+}
+
+Function MeowScriptClass::findMethod(const std::string& methodName) const {
+    ensureFlattened();
+
+    auto it = flatMethods.find(methodName);
+    if (it != flatMethods.end()) {
+        return it->second;
     }
-    
     return nullptr;
 }
 
+const Function& MeowScriptClass::protocol(Protocol slot) const {
+    ensureFlattened();
+    return protocolSlots[static_cast<size_t>(slot)];
+}
+
+
+
 
 
 
+void MeowScriptClass::defineMethod(const std::string& methodName, Function method) {
+    methods[methodName] = std::move(method);
+    ++version;
+}
+
+void MeowScriptClass::defineStatic(const std::string& fieldName, const Value& value) {
+    static_fields[fieldName] = value;
+    ++version;
+}
 
+uint32_t MeowScriptClass::lookupVersion() const {
+    uint32_t total = 0;
+    for (const MeowScriptClass* klass = this; klass != nullptr; klass = klass->superclass.get()) {
+        total += klass->version;
+    }
+    return total;
+}
 
 Arity MeowScriptClass::arity() const {
     Function initializer = nullptr;
@@ -83,7 +159,111 @@ void MeowScriptClass::set(const Value& key, const Value& value) {
     }
     const std::string& name = std::get<String>(key)->str;
     
-    static_fields[name] = value;
+    defineStatic(name, value);
+}
+
+MeowScriptInstance::MeowScriptInstance(Class k, Interpreter* e) : klass(std::move(k)), engine(e) {
+    shape = klass->rootShape;
+    slots.reserve(klass->slotHint);
+}
+
+MeowScriptInstance::~MeowScriptInstance() = default;
+
+Value MeowScriptInstance::getField(const Value& key) {
+    if (shape != nullptr) {
+        if (auto name = std::get_if<String>(&key)) {
+            int slot = shape->slotOf(name->get());
+            if (slot >= 0) {
+                return slots[slot];
+            }
+            // ObjectData::get trả về các hàm của objectLib gắn với chính object đó, giữ nguyên hành vi này
+            auto it = objectLib->contents.find((*name)->str);
+            if (it == objectLib->contents.end()) {
+                return Value(Null{});
+            }
+            return objectLibFunction((*name)->str, std::get<Function>(it->second));
+        }
+        if (isHashable(key)) {
+            return Value(Null{});
+        }
+        return fieldsObject()->get(key);
+    }
+    return fields->get(key);
+}
+
+// Hàm của objectLib gắn với các trường của instance mà không chuyển instance sang dictionary mode.
+// Các hàm này chỉ đọc object nhận được (merge cũng trả về object mới), nên lúc gọi chỉ cần
+// một bản sao các trường hiện có; instance đã ở dictionary mode thì dùng thẳng fields.
+Value MeowScriptInstance::objectLibFunction(const std::string& name, const Function& unboundFunction) {
+    NativeFnAdvanced boundFunction = [self = Instance(this), unboundFunction](Interpreter* engine, Arguments args) -> Value {
+        std::vector<Value> finalArgs;
+        finalArgs.push_back(Value(self->shape != nullptr ? self->copyFields() : self->fields));
+        finalArgs.insert(finalArgs.end(), args.begin(), args.end());
+        return unboundFunction->call(engine, finalArgs);
+    };
+    Arity arity = unboundFunction->arity().withoutReceiver();
+    return makeRef<NativeCallable>(std::make_shared<NativeFunction>(name, boundFunction, arity));
+}
+
+void MeowScriptInstance::setField(const Value& key, const Value& value) {
+    if (shape != nullptr) {
+        if (auto name = std::get_if<String>(&key)) {
+            int slot = shape->slotOf(name->get());
+            if (slot >= 0) {
+                slots[slot] = value;
+                return;
+            }
+            if (shape->keys.size() < Shape::maxSlots) {
+                shape = shape->withKey(*name);
+                slots.push_back(value);
+                klass->slotHint = std::max(klass->slotHint, slots.size());
+                return;
+            }
+        } else if (!isHashable(key)) {
+            throw std::runtime_error("Không thể dùng key với kiểu dữ liệu này");
+        }
+        fieldsObject();
+    }
+    fields->set(key, value);
+}
+
+Value* MeowScriptInstance::fieldSlot(const String& key) {
+    if (shape != nullptr) {
+        int slot = shape->slotOf(key.get());
+        return slot >= 0 ? &slots[slot] : nullptr;
+    }
+    auto it = fields->pairs.find(HashKey{Value(key)});
+    return it != fields->pairs.end() ? &it->second : nullptr;
+}
+
+Object MeowScriptInstance::fieldsObject() {
+    if (shape != nullptr) {
+        fields = copyFields();
+        shape = nullptr;
+        slots.clear();
+        slots.shrink_to_fit();
+    }
+    return fields;
+}
+
+Object MeowScriptInstance::copyFields() const {
+    if (shape == nullptr) {
+        auto copy = makeRef<ObjectData>();
+        copy->pairs = fields->pairs;
+        return copy;
+    }
+
+    auto obj = makeRef<ObjectData>();
+    for (size_t i = 0; i < slots.size(); ++i) {
+        obj->pairs.emplace(HashKey{Value(shape->keys[i])}, slots[i]);
+    }
+    return obj;
+}
+
+void MeowScriptInstance::adoptFields(Object obj) {
+    fields = std::move(obj);
+    shape = nullptr;
+    slots.clear();
 }
 
 Value MeowScriptInstance::get(const Value& key) {
@@ -102,7 +282,7 @@ Value MeowScriptInstance::get(const Value& key) {
 
 
 
-    Value value = this->fields->get(key);
+    Value value = this->getField(key);
     if (value != Value(Null{})) {
         return value;
     }
@@ -112,10 +292,10 @@ Value MeowScriptInstance::get(const Value& key) {
         if (name == "__class__") {
             return this->klass;
         } else if (name == "__fields__") {
-            return this->fields;
+            return this->fieldsObject();
         } else if (name == "__instanceof__") {
-            Instance self = shared_from_this();
-            NativeFnAdvanced instanceof = [self](Interpreter* engine, const std::vector<Value>& args) -> Value {
+            Instance self = Instance(this);
+            NativeFnAdvanced instanceof = [self](Interpreter* engine, Arguments args) -> Value {
                 if (!std::holds_alternative<Class>(args[0])) {
                     throw std::runtime_error("Hàm __instanceof__ cần đúng 1 tham số là một Class.");
                 }
@@ -130,20 +310,20 @@ Value MeowScriptInstance::get(const Value& key) {
                 }
                 return false;
             };
-            return std::make_shared<NativeCallable>(std::make_shared<NativeFunction>("__instanceof__", instanceof, Arity::fixed(1)));
+            return makeRef<NativeCallable>(std::make_shared<NativeFunction>("__instanceof__", instanceof, Arity::fixed(1)));
         } else if (name == "__hasmethod__") {
-            Instance self = shared_from_this();
-            NativeFnAdvanced hasmethod = [self](Interpreter* engine, const std::vector<Value>& args) -> Value {
+            Instance self = Instance(this);
+            NativeFnAdvanced hasmethod = [self](Interpreter* engine, Arguments args) -> Value {
                 if (!std::holds_alternative<String>(args[0])) {
                     throw std::runtime_error("Hàm __hasmethod__ cần 1 tham số là tên phương thức (chuỗi).");
                 }
                 const std::string& methodName = std::get<String>(args[0])->str;
                 return self->klass->findMethod(methodName) != nullptr;
             };
-            return std::make_shared<NativeCallable>(std::make_shared<NativeFunction>("__hasmethod__", hasmethod, Arity::fixed(1)));
+            return makeRef<NativeCallable>(std::make_shared<NativeFunction>("__hasmethod__", hasmethod, Arity::fixed(1)));
         } else if (name == "__getmethod__") {
-            Instance self = shared_from_this();
-            NativeFnAdvanced getmethod = [self](Interpreter* engine, const std::vector<Value>& args) -> Value {
+            Instance self = Instance(this);
+            NativeFnAdvanced getmethod = [self](Interpreter* engine, Arguments args) -> Value {
                 if (!std::holds_alternative<String>(args[0])) {
                     throw std::runtime_error("Hàm __getmethod__ cần 1 tham số là tên phương thức (chuỗi).");
                 }
@@ -152,18 +332,18 @@ Value MeowScriptInstance::get(const Value& key) {
                 if (method) return method;
                 return Value(Null{});
             };
-            return std::make_shared<NativeCallable>(std::make_shared<NativeFunction>("__getmethod__", getmethod, Arity::fixed(1)));
+            return makeRef<NativeCallable>(std::make_shared<NativeFunction>("__getmethod__", getmethod, Arity::fixed(1)));
         }
 
         Function method = this->klass->findMethod(name);
         if (method != nullptr) {
-            return std::make_shared<MeowScriptBoundMethod>(shared_from_this(), method);
+            return makeRef<MeowScriptBoundMethod>(Instance(this), method);
         }
     }
 
-    Function getitem = this->klass->findMethod("__getitem__");
+    Function getitem = this->klass->protocol(Protocol::GetItem);
     if (getitem != nullptr) {
-        return MeowScriptBoundMethod(shared_from_this(), getitem).call(this->engine, {key});
+        return MeowScriptBoundMethod(Instance(this), getitem).call(this->engine, Arguments(&key, 1));
     }
     
     return Value(Null{});
@@ -183,18 +363,19 @@ void MeowScriptInstance::set(const Value& key, const Value& value) {
 
 
 
-    Function setitem = this->klass->findMethod("__setitem__");
+    Function setitem = this->klass->protocol(Protocol::SetItem);
     if (setitem != nullptr) {
-        MeowScriptBoundMethod(shared_from_this(), setitem).call(this->engine, {key, value});
+        Value setitemArgs[] = {key, value};
+        MeowScriptBoundMethod(Instance(this), setitem).call(this->engine, setitemArgs);
         return;
     }
-    this->fields->set(key, value);
+    this->setField(key, value);
 }
 
 std::string MeowScriptInstance::toString() const {
-    Function strMethod = this->klass->findMethod("__str__");
+    Function strMethod = this->klass->protocol(Protocol::Str);
     if (strMethod != nullptr) {
-        auto self = std::const_pointer_cast<MeowScriptInstance>(shared_from_this());
+        auto self = Instance(const_cast<MeowScriptInstance*>(this));
         MeowScriptBoundMethod boundStr(self, strMethod);
         try {
             Value result = boundStr.call(this->engine, {});
@@ -208,16 +389,16 @@ std::string MeowScriptInstance::toString() const {
     return this->klass->toString() + " instance";
 }
 
-Value MeowScriptInstance::call(Interpreter* engine, const std::vector<Value>& args) {
-    Function callMethod = this->klass->findMethod("__call__");
+Value MeowScriptInstance::call(Interpreter* engine, Arguments args) {
+    Function callMethod = this->klass->protocol(Protocol::Call);
     if (callMethod != nullptr) {
-        return MeowScriptBoundMethod(shared_from_this(), callMethod).call(engine, args);
+        return MeowScriptBoundMethod(Instance(this), callMethod).call(engine, args);
     }
     throw std::runtime_error("Instance của class '" + klass->name + "' không thể gọi được (thiếu phương thức __call__).");
 }
 
 Arity MeowScriptInstance::arity() const {
-    Function callMethod = this->klass->findMethod("__call__");
+    Function callMethod = this->klass->protocol(Protocol::Call);
     if (callMethod != nullptr) {
         return callMethod->arity();
     }
@@ -231,13 +412,13 @@ std::unique_ptr<Iterator> MeowScriptInstance::makeIterator() {
 InstanceIterator::InstanceIterator::InstanceIterator(MeowScriptInstance* instance) : isFinished(false) {
     this->engine = instance->engine;
     
-    Function iterMethod = instance->klass->findMethod("__iterator__");
+    Function iterMethod = instance->klass->protocol(Protocol::Iterator);
     if (iterMethod == nullptr) {
         throw std::runtime_error("Đối tượng này không phải là một iterable.");
     }
     
     this->iteratorObject = std::make_unique<Value>(
-        MeowScriptBoundMethod(instance->shared_from_this(), iterMethod).call(this->engine, {})
+        MeowScriptBoundMethod(Instance(instance), iterMethod).call(this->engine, {})
     );
 
     this->advance();
@@ -247,7 +428,7 @@ InstanceIterator::~InstanceIterator() = default;
 
 void InstanceIterator::advance() {
     if (auto inst = std::get_if<Instance>(&*iteratorObject)) {
-        Function nextMethod = (*inst)->klass->findMethod("__next__");
+        Function nextMethod = (*inst)->klass->protocol(Protocol::Next);
         if (nextMethod != nullptr) {
             try {
                 this->nextValue = std::make_unique<Value>(
@@ -286,40 +467,17 @@ Value InstanceIterator::next() {
 
 
 
-Value MeowScriptBoundMethod::call(Interpreter* engine, const std::vector<Value>& args) {
-    auto userFunction = dynamic_cast<MeowScriptFunction*>(this->function.get());
-
-    if (userFunction) {
-        auto executionEnv = std::make_shared<Environment>(userFunction->getEnv());
-
-        executionEnv->define("this", this->instance);
-
-        auto& decl = userFunction->declaration;
-        size_t requiredParams = decl->parameters.size();
-
-        for (size_t i = 0; i < requiredParams; ++i) {
-            const std::string& paramName = decl->parameters[i]->name;
-            executionEnv->define(paramName, args[i]);
-        }
-
-        if (decl->restParam) {
-            auto restArrayData = std::make_shared<ArrayData>();
-            for (size_t i = requiredParams; i < args.size(); ++i) {
-                restArrayData->elements.push_back(args[i]);
-            }
-            executionEnv->define(decl->restParam->name, Value(Array(restArrayData)));
-        }
-
-        try {
-            engine->exec(decl->body.get(), executionEnv);
-        } catch (const ReturnException& returnValue) {
-            return returnValue.value;
-        }
+Value MeowScriptBoundMethod::call(Interpreter* engine, Arguments args) {
+    return invoke(engine, this->instance, this->function, args);
+}
 
-        return Value(Null{});
+Value MeowScriptBoundMethod::invoke(Interpreter* engine, const Instance& instance, const Function& function, Arguments args) {
+    if (auto userFunction = dynamic_cast<MeowScriptFunction*>(function.get())) {
+        Value self = instance;
+        return engine->exec(userFunction->declaration->body.get(), userFunction->makeFrame(args, &self));
     }
 
-    return this->function->call(engine, args);
+    return function->call(engine, args);
 }
 
 Value MeowScriptBoundMethod::get(const Value& key) {
@@ -347,4 +505,4 @@ Arity MeowScriptBoundMethod::arity() const {
 
 std::string MeowScriptBoundMethod::toString() const {
     return "bound_method";
-}
\ No newline at end of file
+}
@@ -21,7 +21,7 @@ namespace {
     Value multiply_array_by_int(const Value& l_array, const Value& r_int) {
         const auto& original_elements = std::get<Array>(l_array)->elements;
         Int multiplier = std::get<Int>(r_int);
-        Array new_array = std::make_shared<ArrayData>();
+        Array new_array = makeRef<ArrayData>();
         if (multiplier <= 0) return Value(new_array);
         
         new_array->elements.reserve(original_elements.size() * multiplier);
@@ -33,19 +33,11 @@ namespace {
 }
 
 
-#define BINARY(token, left, right) binary_dispatch_table_[+token][+left][+right] = [](const Value& l, const Value& r) -> Value
-#define UNARY(token, right) unary_dispatch_table_[+token][+right] = [](const Value& r) -> Value
-
-OperatorDispatcher::OperatorDispatcher() noexcept {
-    for (size_t i = 0; i < NUM_TOKEN_TYPES; ++i) {
-        for (size_t j = 0; j < NUM_VALUE_TYPES; ++j) {
-            unary_dispatch_table_[i][j] = nullptr;
-            for (size_t k = 0; k < NUM_VALUE_TYPES; ++k) {
-                binary_dispatch_table_[i][j][k] = nullptr;
-            }
-        }
-    }
+// Toán tử chưa có trong BINARY_OPERATORS/UNARY_OPERATORS sẽ làm việc dựng bảng lúc biên dịch báo lỗi
+#define BINARY(token, left, right) binary_dispatch_table_[binaryRows[+token]][+left][+right] = [](const Value& l, const Value& r) -> Value
+#define UNARY(token, right) unary_dispatch_table_[unaryRows[+token]][+right] = [](const Value& r) -> Value
 
+constexpr OperatorDispatcher::OperatorDispatcher() noexcept {
     using enum TokenType;
     using VT = ValueType;
 
@@ -70,7 +62,7 @@ OperatorDispatcher::OperatorDispatcher() noexcept {
     BINARY(OP_PLUS, VT::String, VT::Object) { return Value(std::get<String>(l)->str + toString(r)); };
     BINARY(OP_PLUS, VT::Object, VT::String) { return Value(toString(l) + std::get<String>(r)->str); };
     BINARY(OP_PLUS, VT::Array, VT::Array) {
-        Array new_arr = std::make_shared<ArrayData>();
+        Array new_arr = makeRef<ArrayData>();
         new_arr->elements = std::get<Array>(l)->elements;
         const auto& r_elements = std::get<Array>(r)->elements;
         new_arr->elements.insert(new_arr->elements.end(), r_elements.begin(), r_elements.end());
@@ -172,7 +164,7 @@ OperatorDispatcher::OperatorDispatcher() noexcept {
     BINARY(OP_EQ, VT::Int, VT::Real) { return static_cast<Real>(std::get<Int>(l)) == std::get<Real>(r); };
     BINARY(OP_EQ, VT::Real, VT::Int) { return std::get<Real>(l) == static_cast<Real>(std::get<Int>(r)); };
     BINARY(OP_EQ, VT::Bool, VT::Bool) { return std::get<Bool>(l) == std::get<Bool>(r); };
-    BINARY(OP_EQ, VT::String, VT::String) { return std::get<String>(l)->str == std::get<String>(r)->str; };
+    BINARY(OP_EQ, VT::String, VT::String) { return stringEquals(std::get<String>(l).get(), std::get<String>(r).get()); };
     BINARY(OP_EQ, VT::Null, VT::Null) { return true; };
     BINARY(OP_EQ, VT::Bool, VT::Int) { return bool_to_int(std::get<Bool>(l)) == std::get<Int>(r); };
     BINARY(OP_EQ, VT::Int, VT::Bool) { return std::get<Int>(l) == bool_to_int(std::get<Bool>(r)); };
@@ -203,7 +195,7 @@ OperatorDispatcher::OperatorDispatcher() noexcept {
     BINARY(OP_NEQ, VT::Int, VT::Real) { return static_cast<Real>(std::get<Int>(l)) != std::get<Real>(r); };
     BINARY(OP_NEQ, VT::Real, VT::Int) { return std::get<Real>(l) != static_cast<Real>(std::get<Int>(r)); };
     BINARY(OP_NEQ, VT::Bool, VT::Bool) { return std::get<Bool>(l) != std::get<Bool>(r); };
-    BINARY(OP_NEQ, VT::String, VT::String) { return std::get<String>(l)->str != std::get<String>(r)->str; };
+    BINARY(OP_NEQ, VT::String, VT::String) { return !stringEquals(std::get<String>(l).get(), std::get<String>(r).get()); };
     BINARY(OP_NEQ, VT::Null, VT::Null) { return false; };
     BINARY(OP_NEQ, VT::Bool, VT::Int) { return bool_to_int(std::get<Bool>(l)) != std::get<Int>(r); };
     BINARY(OP_NEQ, VT::Int, VT::Bool) { return std::get<Int>(l) != bool_to_int(std::get<Bool>(r)); };
@@ -309,4 +301,6 @@ OperatorDispatcher::OperatorDispatcher() noexcept {
     UNARY(OP_LOGICAL_NOT, VT::Instance) { return false; };
     UNARY(OP_LOGICAL_NOT, VT::Class) { return false; };
     UNARY(OP_LOGICAL_NOT, VT::BoundMethod) { return false; };
-}
\ No newline at end of file
+}
+
+constinit const OperatorDispatcher OperatorDispatcher::shared{};
\ No newline at end of file
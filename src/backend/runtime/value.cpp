@@ -17,6 +17,32 @@ void initNativeMethods(const NativeLibrary& arr, const NativeLibrary& obj, const
     stringLib = &str;
 }
 
+Function findNativeMethod(const Value& receiver, const String& name) {
+    const NativeLibrary* library = nullptr;
+
+    if (std::holds_alternative<Array>(receiver)) {
+        library = arrayLib;
+    } else if (std::holds_alternative<String>(receiver)) {
+        library = stringLib;
+    } else if (auto object = std::get_if<Object>(&receiver)) {
+        if ((*object)->pairs.count(HashKey{Value(name)})) {
+            return nullptr;
+        }
+        library = objectLib;
+    } else {
+        return nullptr;
+    }
+
+    if (name->str == "length" && library != objectLib) {
+        return nullptr;
+    }
+    auto it = library->contents.find(name->str);
+    if (it == library->contents.end()) {
+        return nullptr;
+    }
+    return std::get<Function>(it->second);
+}
+
 Value ArrayData::get(const Value& key) {
     if (std::holds_alternative<String>(key)) {
         const auto& propName = std::get<String>(key)->str;
@@ -28,16 +54,15 @@ Value ArrayData::get(const Value& key) {
         auto it = arrayLib->contents.find(propName);
         if (it != arrayLib->contents.end()) {
             const auto& unboundFunction = std::get<Function>(it->second);
-            NativeFnAdvanced boundedFunction = [self = this, unboundFunction](Interpreter* engine, Arguments args) -> Value {
+            NativeFnAdvanced boundedFunction = [self = Array(this), unboundFunction](Interpreter* engine, Arguments args) -> Value {
                 std::vector<Value> finalArgs;
-                finalArgs.push_back(Value(self->shared_from_this()));
+                finalArgs.push_back(Value(self));
                 finalArgs.insert(finalArgs.end(), args.begin(), args.end());
                 return unboundFunction->call(engine, finalArgs);
             };
-            Arity newArity = unboundFunction->arity();
-            newArity.required = std::max(0, newArity.required - 1);
+            Arity newArity = unboundFunction->arity().withoutReceiver();
             auto data = std::make_shared<NativeFunction>(propName, boundedFunction, newArity);
-            return Value(Function(std::make_shared<NativeCallable>(data)));
+            return Value(Function(makeRef<NativeCallable>(data)));
         }
     }
 
@@ -113,7 +138,7 @@ bool operator==(const Value& lhs, const Value& rhs) {
     }
 
     return std::visit(overloaded {
-        [](const String& l, const String& r) { return l->str == r->str; },
+        [](const String& l, const String& r) { return stringEquals(l.get(), r.get()); },
         [](const Array&, const Array&)   { return false; },
         [](const Object&, const Object&) { return false; },
 
@@ -130,7 +155,7 @@ size_t Hasher::operator()(const Value& v) const {
     return std::visit(overloaded {
         [](const Int& i)      { return std::hash<Int>{}(i); },
         [](const Bool& b)     { return std::hash<Bool>{}(b); },
-        [](const String& s)   { return std::hash<Str>{}(s->str); },
+        [](const String& s)   { return s->hash(); },
         [](const auto&) -> size_t {
             throw std::runtime_error("Hm... bạn đang cố dùng một key không 'hash' được?");
         }
@@ -160,16 +185,15 @@ Value ObjectData::get(const Value& key) {
         auto it = objectLib->contents.find(propName);
         if (it != objectLib->contents.end()) {
             const auto& unboundFunction = std::get<Function>(it->second);
-            NativeFnAdvanced boundedFunction = [self = this, unboundFunction](Interpreter* engine, Arguments args) -> Value {
+            NativeFnAdvanced boundedFunction = [self = Object(this), unboundFunction](Interpreter* engine, Arguments args) -> Value {
                 std::vector<Value> finalArgs;
-                finalArgs.push_back(Value(self->shared_from_this()));
+                finalArgs.push_back(Value(self));
                 finalArgs.insert(finalArgs.end(), args.begin(), args.end());
                 return unboundFunction->call(engine, finalArgs);
             };
-            Arity newArity = unboundFunction->arity();
-            newArity.required = std::max(0, newArity.required - 1);
+            Arity newArity = unboundFunction->arity().withoutReceiver();
             auto data = std::make_shared<NativeFunction>(propName, boundedFunction, newArity);
-            return Value(Function(std::make_shared<NativeCallable>(data)));
+            return Value(Function(makeRef<NativeCallable>(data)));
         }
     }
 
@@ -198,7 +222,7 @@ bool ObjectIterator::hasNext() const {
 }
 
 Value ObjectIterator::next() {
-    auto obj = std::make_shared<ObjectData>();
+    auto obj = makeRef<ObjectData>();
     obj->set(Value("first"), current->first.value);
     obj->set(Value("second"), current->second);
     ++current;
@@ -234,17 +258,16 @@ Value StringData::get(const Value& key) {
         auto it = stringLib->contents.find(propName);
         if (it != stringLib->contents.end()) {
             const auto& unboundFunction = std::get<Function>(it->second);
-            auto self_shared = this->shared_from_this();
+            String self_shared(this);
             NativeFnAdvanced boundedFunction = [self_shared, unboundFunction](Interpreter* engine, Arguments args) -> Value {
                 std::vector<Value> finalArgs;
-                finalArgs.push_back(Value(self_shared)); // Value(Array) from shared_ptr<ArrayData>
+                finalArgs.push_back(Value(self_shared));
                 finalArgs.insert(finalArgs.end(), args.begin(), args.end());
                 return unboundFunction->call(engine, finalArgs);
             };
-            Arity newArity = unboundFunction->arity();
-            newArity.required = std::max(0, newArity.required - 1);
+            Arity newArity = unboundFunction->arity().withoutReceiver();
             auto data = std::make_shared<NativeFunction>(propName, boundedFunction, newArity);
-            return Value(Function(std::make_shared<NativeCallable>(data)));
+            return Value(Function(makeRef<NativeCallable>(data)));
         }
     }
 
@@ -253,7 +276,7 @@ Value StringData::get(const Value& key) {
         if (static_cast<size_t>(idx) >= str.size() || idx < 0) {
             throw std::runtime_error("Chỉ số không nằm trong phạm vi truy cập phần tử!");
         }
-        return Value(std::make_shared<StringData>(1, str[idx]));
+        return Value(makeRef<StringData>(1, str[idx]));
     }
     
     throw std::runtime_error("Không thể truy cập chuỗi bằng key '" + ::toString(key) + "'.");
@@ -274,7 +297,7 @@ bool StringIterator::hasNext() const {
 }
 
 Value StringIterator::next() { 
-    return std::make_shared<StringData>(1, char(strData->str[current++])); 
+    return makeRef<StringData>(1, char(strData->str[current++])); 
 }
 
 std::string StringData::toString() const {
@@ -346,4 +369,4 @@ Str toString(const Value& v) {
             }
         }
     }, v);
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "runtime/value_stack.hpp"
+#include <algorithm>
+
+Value* ValueStack::allocate(size_t count) {
+    if (!blocks.empty() && top + count <= blocks[current].capacity) {
+        Value* result = blocks[current].values.get() + top;
+        top += count;
+        return result;
+    }
+
+    // Khối hiện tại không đủ chỗ liền nhau: sang khối kế tiếp, các khối phía trên current đều đang trống
+    size_t next = blocks.empty() ? 0 : current + 1;
+    size_t capacity = std::max(blockSize, count);
+    if (next == blocks.size()) {
+        blocks.push_back(Block{std::make_unique<Value[]>(capacity), capacity});
+    } else if (blocks[next].capacity < count) {
+        blocks[next] = Block{std::make_unique<Value[]>(capacity), capacity};
+    }
+
+    current = next;
+    top = count;
+    return blocks[current].values.get();
+}
+
+ValueStack::Frame::Frame(ValueStack& stack, size_t capacity)
+    : owner(stack), savedBlock(stack.current), savedTop(stack.top) {
+    base = owner.allocate(capacity);
+}
+
+ValueStack::Frame::~Frame() {
+    // Nhả tham chiếu ngay, giá trị còn nằm lại trên ngăn xếp sẽ giữ object sống lâu hơn cần thiết
+    for (size_t i = 0; i < count; ++i) {
+        base[i] = Value(Null{});
+    }
+    owner.current = savedBlock;
+    owner.top = savedTop;
+}
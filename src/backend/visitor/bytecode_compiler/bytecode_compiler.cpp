@@ -0,0 +1,249 @@
+#include "visitor/bytecode_compiler.hpp"
+#include "common/ast.hpp"
+#include "runtime/intern.hpp"
+
+namespace {
+    // Các lệnh mà TreeWalker tự bọc lỗi runtime tại vị trí node của chính nó
+    bool wrapsOwnErrors(OpCode op) {
+        switch (op) {
+            case OpCode::CALL:
+            case OpCode::CALL_ARRAY:
+            case OpCode::GET_METHOD:
+            case OpCode::CALL_METHOD:
+            case OpCode::GET_INDEX:
+            case OpCode::SET_INDEX:
+            case OpCode::GET_PROP:
+            case OpCode::GET_FIELD:
+            case OpCode::SET_PROP:
+            case OpCode::MAKE_OBJECT:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+std::unique_ptr<Chunk> BytecodeCompiler::compileProgram(Program* program) {
+    chunk = std::make_unique<Chunk>();
+    currentNode = program;
+    errorSite = nullptr;
+
+    compileStatements(program->body);
+    emit(OpCode::HALT);
+
+    return std::move(chunk);
+}
+
+std::unique_ptr<Chunk> BytecodeCompiler::compileBody(ASTNode* body) {
+    chunk = std::make_unique<Chunk>();
+    currentNode = body;
+    errorSite = nullptr;
+
+    compile(body);
+    emit(OpCode::HALT);
+
+    return std::move(chunk);
+}
+
+std::unique_ptr<Chunk> BytecodeCompiler::compileBlock(BlockStatement* block) {
+    chunk = std::make_unique<Chunk>();
+    currentNode = block;
+    errorSite = nullptr;
+
+    compileStatements(block->statements);
+    emit(OpCode::HALT);
+
+    return std::move(chunk);
+}
+
+Value BytecodeCompiler::visit(Program* node) {
+    compileStatements(node->body);
+    return Value(Null{});
+}
+
+size_t BytecodeCompiler::emit(OpCode op, uint32_t a, uint16_t b) {
+    chunk->code.push_back(Instruction{op, b, a});
+    chunk->nodes.push_back(currentNode);
+    if (errorSite != nullptr) {
+        chunk->errorSites.push_back(errorSite);
+    } else {
+        chunk->errorSites.push_back(wrapsOwnErrors(op) ? currentNode : nullptr);
+    }
+    return chunk->code.size() - 1;
+}
+
+size_t BytecodeCompiler::emitJump(OpCode op) {
+    return emit(op, 0);
+}
+
+void BytecodeCompiler::patchJump(size_t at) {
+    patchJump(at, chunk->code.size());
+}
+
+void BytecodeCompiler::patchJump(size_t at, size_t target) {
+    chunk->code[at].a = static_cast<uint32_t>(target);
+}
+
+void BytecodeCompiler::emitUnwind(size_t depth) {
+    for (size_t i = unwindStack.size(); i > depth; --i) {
+        switch (unwindStack[i - 1]) {
+            case Unwind::Scope: emit(OpCode::POP_SCOPE); break;
+            case Unwind::Try: emit(OpCode::TRY_END); break;
+            case Unwind::Catch: emit(OpCode::CLEAR_CAUGHT); break;
+            case Unwind::Iterator: emit(OpCode::END_ITER); break;
+        }
+    }
+}
+
+uint32_t BytecodeCompiler::addConstant(Value value) {
+    chunk->constants.push_back(std::move(value));
+    return static_cast<uint32_t>(chunk->constants.size() - 1);
+}
+
+uint32_t BytecodeCompiler::addName(const std::string& name) {
+    auto it = chunk->nameIndex.find(name);
+    if (it != chunk->nameIndex.end()) {
+        return it->second;
+    }
+
+    chunk->names.push_back(name);
+    chunk->nameValues.push_back(Value(intern(name)));
+
+    uint32_t index = static_cast<uint32_t>(chunk->names.size() - 1);
+    chunk->nameIndex.emplace(name, index);
+    return index;
+}
+
+uint16_t BytecodeCompiler::addPropertyCache() {
+    if (chunk->propertyCaches.size() >= NO_PROPERTY_CACHE) {
+        return NO_PROPERTY_CACHE;
+    }
+    chunk->propertyCaches.emplace_back();
+    return static_cast<uint16_t>(chunk->propertyCaches.size() - 1);
+}
+
+uint32_t BytecodeCompiler::addChild(ASTNode* node) {
+    chunk->children.push_back(node);
+    return static_cast<uint32_t>(chunk->children.size() - 1);
+}
+
+uint32_t BytecodeCompiler::addLayout(const ScopeLayout* layout) {
+    chunk->layouts.push_back(layout);
+    return static_cast<uint32_t>(chunk->layouts.size() - 1);
+}
+
+void BytecodeCompiler::emitLoad(const std::string& name, const LexicalAddress& address) {
+    if (address.slot >= 0) {
+        emit(OpCode::LOAD_SLOT, static_cast<uint32_t>(address.slot), static_cast<uint16_t>(address.depth));
+        return;
+    }
+    emit(OpCode::LOAD_NAME, addName(name), static_cast<uint16_t>(address.depth + 1));
+}
+
+void BytecodeCompiler::emitStore(const std::string& name, const LexicalAddress& address) {
+    if (address.slot >= 0) {
+        emit(OpCode::STORE_SLOT, static_cast<uint32_t>(address.slot), static_cast<uint16_t>(address.depth));
+        return;
+    }
+    emit(OpCode::STORE_NAME, addName(name), static_cast<uint16_t>(address.depth + 1));
+}
+
+void BytecodeCompiler::emitDefine(Identifier* name, bool isConstant) {
+    if (name->address.slot >= 0) {
+        emit(OpCode::DEFINE_SLOT, static_cast<uint32_t>(name->address.slot), isConstant ? 1 : 0);
+        return;
+    }
+    emit(OpCode::DEFINE_NAME, addName(name->name), isConstant ? 1 : 0);
+}
+
+void BytecodeCompiler::emitUpdate(Identifier* name, uint16_t flags) {
+    const LexicalAddress& address = name->address;
+    if (address.slot >= 0) {
+        emit(OpCode::UPDATE_SLOT, static_cast<uint32_t>(address.slot), flags | address.depth << UPDATE_DEPTH_SHIFT);
+        return;
+    }
+    emit(OpCode::UPDATE_NAME, addName(name->name), flags | (address.depth + 1) << UPDATE_DEPTH_SHIFT);
+}
+
+void BytecodeCompiler::compile(ASTNode* node) {
+    if (node == nullptr) {
+        emit(OpCode::PUSH_NULL);
+        return;
+    }
+
+    ASTNode* previous = currentNode;
+    currentNode = node;
+    node->accept(this);
+    currentNode = previous;
+}
+
+void BytecodeCompiler::compileStatements(const std::vector<StmtPtr>& statements) {
+    for (const auto& stmt : statements) {
+        compile(stmt.get());
+    }
+}
+
+void BytecodeCompiler::beginScope(const ScopeLayout& layout) {
+    if (layout.isElided) {
+        return;
+    }
+    emit(OpCode::PUSH_SCOPE, addLayout(&layout));
+    unwindStack.push_back(Unwind::Scope);
+}
+
+void BytecodeCompiler::endScope(const ScopeLayout& layout) {
+    if (layout.isElided) {
+        return;
+    }
+    unwindStack.pop_back();
+    emit(OpCode::POP_SCOPE);
+}
+
+void BytecodeCompiler::compileArguments(const std::vector<ExprPtr>& elements, bool& hasSpread) {
+    hasSpread = false;
+    for (const auto& element : elements) {
+        if (element->type == EXPR_SPREAD) {
+            hasSpread = true;
+            break;
+        }
+    }
+
+    if (!hasSpread) {
+        for (const auto& element : elements) {
+            compile(element.get());
+        }
+        return;
+    }
+
+    emit(OpCode::MAKE_ARRAY, 0);
+    for (const auto& element : elements) {
+        if (auto spread = dynamic_cast<SpreadExpression*>(element.get())) {
+            compile(spread->expression.get());
+
+            ASTNode* previous = currentNode;
+            currentNode = spread;
+            emit(OpCode::ARRAY_SPREAD);
+            currentNode = previous;
+        } else {
+            compile(element.get());
+            emit(OpCode::ARRAY_APPEND);
+        }
+    }
+}
+
+void BytecodeCompiler::beginLoop(bool isSwitch) {
+    loops.push_back(LoopContext{isSwitch, unwindStack.size(), {}, {}});
+}
+
+void BytecodeCompiler::endLoop(size_t breakTarget, size_t continueTarget) {
+    LoopContext& loop = loops.back();
+
+    for (size_t jump : loop.breakJumps) {
+        patchJump(jump, breakTarget);
+    }
+    for (size_t jump : loop.continueJumps) {
+        patchJump(jump, continueTarget);
+    }
+
+    loops.pop_back();
+}
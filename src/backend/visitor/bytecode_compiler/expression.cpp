@@ -0,0 +1,252 @@
+#include "visitor/bytecode_compiler.hpp"
+#include "common/ast.hpp"
+#include <algorithm>
+
+namespace {
+    TokenType compoundToBinary(TokenType type) {
+        switch (type) {
+            case TokenType::OP_PLUS_ASSIGN:     return TokenType::OP_PLUS;
+            case TokenType::OP_MINUS_ASSIGN:    return TokenType::OP_MINUS;
+            case TokenType::OP_MULTIPLY_ASSIGN: return TokenType::OP_MULTIPLY;
+            case TokenType::OP_DIVIDE_ASSIGN:   return TokenType::OP_DIVIDE;
+            case TokenType::OP_MODULO_ASSIGN:   return TokenType::OP_MODULO;
+            case TokenType::OP_EXPONENT_ASSIGN: return TokenType::OP_EXPONENT;
+            case TokenType::OP_AND_ASSIGN:      return TokenType::OP_BIT_AND;
+            case TokenType::OP_OR_ASSIGN:       return TokenType::OP_BIT_OR;
+            case TokenType::OP_XOR_ASSIGN:      return TokenType::OP_BIT_XOR;
+            case TokenType::OP_LSHIFT_ASSIGN:   return TokenType::OP_LSHIFT;
+            case TokenType::OP_RSHIFT_ASSIGN:   return TokenType::OP_RSHIFT;
+            default:                            return TokenType::UNKNOWN;
+        }
+    }
+
+    uint16_t updateFlags(TokenType op, bool isPostfix) {
+        uint16_t flags = 0;
+        if (op != TokenType::OP_INCREMENT) flags |= UPDATE_DECREMENT;
+        if (isPostfix) flags |= UPDATE_POSTFIX;
+        return flags;
+    }
+}
+
+Value BytecodeCompiler::visit(Identifier* node) {
+    emitLoad(node->name, node->address);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(UnaryExpression* node) {
+    compile(node->operand.get());
+    emit(OpCode::UNARY, 0, static_cast<uint16_t>(node->op));
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(BinaryExpression* node) {
+    using enum TokenType;
+
+    OpCode shortCircuit = OpCode::HALT;
+    if (node->op == OP_LOGICAL_OR) shortCircuit = OpCode::JUMP_IF_TRUE_KEEP;
+    else if (node->op == OP_LOGICAL_AND) shortCircuit = OpCode::JUMP_IF_FALSE_KEEP;
+    else if (node->op == OP_NULLISH) shortCircuit = OpCode::JUMP_IF_NOT_NULL_KEEP;
+
+    compile(node->left.get());
+
+    if (shortCircuit != OpCode::HALT) {
+        size_t jump = emitJump(shortCircuit);
+        compile(node->right.get());
+        patchJump(jump);
+        return Value(Null{});
+    }
+
+    compile(node->right.get());
+    emit(OpCode::BINARY, 0, static_cast<uint16_t>(node->op));
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(CallExpression* node) {
+    bool hasSpread = std::any_of(node->args.begin(), node->args.end(), [](const ExprPtr& arg) {
+        return arg->type == EXPR_SPREAD;
+    });
+
+    // obj.method(...) gọi thẳng phương thức, không dựng bound method hay hàm bọc receiver
+    if (node->callee->type == EXPR_PROPERTY_ACCESS && !hasSpread && node->args.size() <= UINT16_MAX) {
+        auto access = static_cast<PropertyAccess*>(node->callee.get());
+        uint32_t name = addName(access->property->name);
+        compile(access->object.get());
+
+        ASTNode* previous = currentNode;
+        currentNode = access;
+        emit(OpCode::GET_METHOD, name, addPropertyCache());
+        currentNode = previous;
+
+        compileArguments(node->args, hasSpread);
+        emit(OpCode::CALL_METHOD, name, static_cast<uint16_t>(node->args.size()));
+        return Value(Null{});
+    }
+
+    compile(node->callee.get());
+    compileArguments(node->args, hasSpread);
+
+    if (hasSpread) {
+        emit(OpCode::CALL_ARRAY);
+    } else {
+        emit(OpCode::CALL, static_cast<uint32_t>(node->args.size()));
+    }
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(IndexExpression* node) {
+    compile(node->left.get());
+    compile(node->index.get());
+    emit(OpCode::GET_INDEX);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(AssignmentExpression* node) {
+    // TreeWalker bọc lỗi của cả vế trái lẫn vế phải tại vị trí phép gán. Phép gán lồng bên trong
+    // không đổi errorSite vì lỗi của nó rồi cũng bị phép gán ngoài cùng bọc lại lần nữa.
+    if (errorSite != nullptr) {
+        compileAssignment(node);
+        return Value(Null{});
+    }
+    errorSite = node;
+    compileAssignment(node);
+    errorSite = nullptr;
+    return Value(Null{});
+}
+
+void BytecodeCompiler::compileAssignment(AssignmentExpression* node) {
+    bool isCompound = node->token.type != TokenType::OP_ASSIGN;
+    uint16_t op = static_cast<uint16_t>(compoundToBinary(node->token.type));
+
+    if (auto identifier = dynamic_cast<Identifier*>(node->target.get())) {
+        if (isCompound) {
+            emitLoad(identifier->name, identifier->address);
+        }
+        compile(node->value.get());
+        if (isCompound) {
+            emit(OpCode::COMPOUND, 0, op);
+        }
+        emitStore(identifier->name, identifier->address);
+        return;
+    }
+
+    if (auto indexExpr = dynamic_cast<IndexExpression*>(node->target.get())) {
+        compile(indexExpr->left.get());
+        compile(indexExpr->index.get());
+        if (isCompound) {
+            emit(OpCode::DUP2);
+            emit(OpCode::GET_INDEX);
+        }
+        compile(node->value.get());
+        if (isCompound) {
+            emit(OpCode::COMPOUND, 0, op);
+        }
+        emit(OpCode::SET_INDEX);
+        return;
+    }
+
+    if (auto propAccess = dynamic_cast<PropertyAccess*>(node->target.get())) {
+        uint32_t name = addName(propAccess->property->name);
+        compile(propAccess->object.get());
+        if (isCompound) {
+            emit(OpCode::DUP);
+            emit(OpCode::GET_FIELD, name, addPropertyCache());
+        }
+        compile(node->value.get());
+        if (isCompound) {
+            emit(OpCode::COMPOUND, 0, op);
+        }
+        emit(OpCode::SET_PROP, name, addPropertyCache());
+        return;
+    }
+
+    emit(OpCode::RAISE, addConstant(Value("Biểu thức không hợp lệ ở vế trái của phép gán.")));
+}
+
+Value BytecodeCompiler::visit(TernaryExpression* node) {
+    compile(node->condition.get());
+    size_t elseJump = emitJump(OpCode::JUMP_IF_FALSE);
+
+    compile(node->thenBranch.get());
+    size_t endJump = emitJump(OpCode::JUMP);
+
+    patchJump(elseJump);
+    compile(node->elseBranch.get());
+    patchJump(endJump);
+
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(PropertyAccess* node) {
+    compile(node->object.get());
+    emit(OpCode::GET_PROP, addName(node->property->name), addPropertyCache());
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(PropertyAssignment* node) {
+    compile(node->targetObj.get());
+    compile(node->value.get());
+    emit(OpCode::SET_PROP, addName(node->property->name), addPropertyCache());
+    emit(OpCode::POP);
+    emit(OpCode::PUSH_NULL);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(ThisExpression* node) {
+    if (node->address.slot >= 0) {
+        emit(OpCode::LOAD_SLOT, static_cast<uint32_t>(node->address.slot), static_cast<uint16_t>(node->address.depth));
+    } else {
+        emit(OpCode::LOAD_THIS, 0, static_cast<uint16_t>(node->address.depth + 1));
+    }
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(SuperExpression* node) {
+    emit(OpCode::SUPER, addChild(node));
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(NewExpression* node) {
+    compile(node->expression.get());
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(PrefixUpdateExpression* node) {
+    uint16_t flags = updateFlags(node->op, false);
+
+    if (auto identifier = dynamic_cast<Identifier*>(node->operand.get())) {
+        emitUpdate(identifier, flags);
+    } else if (auto indexExpr = dynamic_cast<IndexExpression*>(node->operand.get())) {
+        compile(indexExpr->left.get());
+        compile(indexExpr->index.get());
+        emit(OpCode::UPDATE_INDEX, 0, flags);
+    } else if (auto propAccess = dynamic_cast<PropertyAccess*>(node->operand.get())) {
+        compile(propAccess->object.get());
+        emit(OpCode::UPDATE_PROP, addName(propAccess->property->name), flags);
+    } else {
+        emit(OpCode::RAISE, addConstant(Value("Biểu thức không hợp lệ ở vế trái của phép gán.")));
+    }
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(PostfixUpdateExpression* node) {
+    uint16_t flags = updateFlags(node->op, true);
+
+    if (auto identifier = dynamic_cast<Identifier*>(node->operand.get())) {
+        emitUpdate(identifier, flags);
+    } else if (auto indexExpr = dynamic_cast<IndexExpression*>(node->operand.get())) {
+        compile(indexExpr->left.get());
+        compile(indexExpr->index.get());
+        emit(OpCode::UPDATE_INDEX, 0, flags);
+    } else if (auto propAccess = dynamic_cast<PropertyAccess*>(node->operand.get())) {
+        compile(propAccess->object.get());
+        emit(OpCode::UPDATE_PROP, addName(propAccess->property->name), flags);
+    } else {
+        emit(OpCode::RAISE, addConstant(Value("Biểu thức không hợp lệ ở vế trái của phép gán.")));
+    }
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(SpreadExpression*) {
+    emit(OpCode::PUSH_NULL);
+    return Value(Null{});
+}
@@ -0,0 +1,57 @@
+#include "visitor/bytecode_compiler.hpp"
+#include "common/ast.hpp"
+
+Value BytecodeCompiler::visit(IntegerLiteral* node) {
+    emit(OpCode::PUSH_CONST, addConstant(Value(node->value)));
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(RealLiteral* node) {
+    emit(OpCode::PUSH_CONST, addConstant(Value(node->value)));
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(StringLiteral* node) {
+    emit(OpCode::PUSH_CONST, addConstant(Value(node->atom)));
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(BooleanLiteral* node) {
+    emit(node->value ? OpCode::PUSH_TRUE : OpCode::PUSH_FALSE);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(NullLiteral*) {
+    emit(OpCode::PUSH_NULL);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(ArrayLiteral* node) {
+    bool hasSpread = false;
+    compileArguments(node->elements, hasSpread);
+
+    if (!hasSpread) {
+        emit(OpCode::MAKE_ARRAY, static_cast<uint32_t>(node->elements.size()));
+    }
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(ObjectLiteral* node) {
+    for (const auto& pair : node->properties) {
+        compile(pair.first.get());
+        compile(pair.second.get());
+    }
+
+    emit(OpCode::MAKE_OBJECT, static_cast<uint32_t>(node->properties.size()));
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(FunctionLiteral* node) {
+    emit(OpCode::CLOSURE, addChild(node));
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(TemplateLiteral* node) {
+    for (const auto& part : node->parts) {
+        compile(part.get());
+    }
+
+    emit(OpCode::MAKE_TEMPLATE, static_cast<uint32_t>(node->parts.size()));
+    return Value(Null{});
+}
@@ -0,0 +1,317 @@
+#include "visitor/bytecode_compiler.hpp"
+#include "common/ast.hpp"
+#include <algorithm>
+
+Value BytecodeCompiler::visit(LetStatement* node) {
+    compile(node->value.get());
+    emitDefine(node->name.get(), node->isConstant);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(ReturnStatement* node) {
+    compile(node->value.get());
+
+    if (std::find(unwindStack.begin(), unwindStack.end(), Unwind::Catch) != unwindStack.end()) {
+        emit(OpCode::CLEAR_CAUGHT);
+    }
+    emit(OpCode::RETURN);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(BreakStatement*) {
+    if (loops.empty()) {
+        // Giống TreeWalker: break ngoài vòng lặp lan ra như một ngoại lệ
+        emit(OpCode::THROW_BREAK);
+        return Value(Null{});
+    }
+
+    LoopContext& loop = loops.back();
+    emitUnwind(loop.unwindDepth);
+    loop.breakJumps.push_back(emitJump(OpCode::JUMP));
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(ContinueStatement*) {
+    auto loop = std::find_if(loops.rbegin(), loops.rend(), [](const LoopContext& l) { return !l.isSwitch; });
+
+    if (loop == loops.rend()) {
+        emit(OpCode::THROW_CONTINUE);
+        return Value(Null{});
+    }
+
+    emitUnwind(loop->unwindDepth);
+    loop->continueJumps.push_back(emitJump(OpCode::JUMP));
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(ThrowStatement* node) {
+    if (node->argument) {
+        compile(node->argument.get());
+        emit(OpCode::THROW);
+    } else {
+        emit(OpCode::RETHROW);
+    }
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(IfStatement* node) {
+    beginScope(node->scope);
+
+    compile(node->condition.get());
+    size_t elseJump = emitJump(OpCode::JUMP_IF_FALSE);
+
+    compile(node->thenBranch.get());
+
+    if (node->elseBranch != nullptr) {
+        size_t endJump = emitJump(OpCode::JUMP);
+        patchJump(elseJump);
+        compile(node->elseBranch.get());
+        patchJump(endJump);
+    } else {
+        patchJump(elseJump);
+    }
+
+    endScope(node->scope);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(WhileStatement* node) {
+    beginScope(node->scope);
+    beginLoop();
+
+    size_t start = chunk->code.size();
+    compile(node->condition.get());
+    size_t exitJump = emitJump(OpCode::JUMP_IF_FALSE);
+
+    compile(node->body.get());
+    emit(OpCode::JUMP, static_cast<uint32_t>(start));
+
+    patchJump(exitJump);
+    endLoop(chunk->code.size(), start);
+
+    endScope(node->scope);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(ForStatement* node) {
+    beginScope(node->scope);
+
+    if (node->init != nullptr) {
+        compile(node->init.get());
+    }
+
+    beginLoop();
+
+    size_t start = chunk->code.size();
+    size_t exitJump = SIZE_MAX;
+    if (node->condition != nullptr) {
+        compile(node->condition.get());
+        exitJump = emitJump(OpCode::JUMP_IF_FALSE);
+    }
+
+    compile(node->body.get());
+
+    size_t continueTarget = chunk->code.size();
+    if (node->update != nullptr) {
+        compile(node->update.get());
+        emit(OpCode::POP);
+    }
+    emit(OpCode::JUMP, static_cast<uint32_t>(start));
+
+    if (exitJump != SIZE_MAX) {
+        patchJump(exitJump);
+    }
+    endLoop(chunk->code.size(), continueTarget);
+
+    endScope(node->scope);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(ForInStatement* node) {
+    beginScope(node->scope);
+
+    compile(node->collection.get());
+    emit(OpCode::GET_ITER);
+    unwindStack.push_back(Unwind::Iterator);
+    beginLoop();
+
+    size_t start = chunk->code.size();
+    size_t exitJump = emitJump(OpCode::FOR_ITER);
+    emitDefine(node->variable.get());
+
+    compile(node->body.get());
+    emit(OpCode::JUMP, static_cast<uint32_t>(start));
+
+    patchJump(exitJump);
+    endLoop(chunk->code.size(), start);
+
+    unwindStack.pop_back();
+    emit(OpCode::END_ITER);
+    endScope(node->scope);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(BlockStatement* node) {
+    beginScope(node->scope);
+
+    compileStatements(node->statements);
+
+    endScope(node->scope);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(ClassStatement* node) {
+    if (node->superclass != nullptr) {
+        compile(node->superclass.get());
+    }
+
+    emit(OpCode::CLASS, addChild(node), node->superclass != nullptr ? 1 : 0);
+
+    for (const auto& methodStmt : node->methods) {
+        auto letStmt = static_cast<LetStatement*>(methodStmt.get());
+        emit(OpCode::METHOD, addChild(letStmt->value.get()), static_cast<uint16_t>(addName(letStmt->name->name)));
+    }
+
+    for (const auto& field : node->static_fields) {
+        if (auto letStmt = dynamic_cast<LetStatement*>(field.get())) {
+            compile(letStmt->value.get());
+            emit(OpCode::SET_STATIC, addName(letStmt->name->name));
+        } else if (auto classStmt = dynamic_cast<ClassStatement*>(field.get())) {
+            compile(classStmt);
+            emit(OpCode::LOAD_NAME, addName(classStmt->name->name));
+            emit(OpCode::SET_STATIC, addName(classStmt->name->name));
+        }
+    }
+
+    emit(OpCode::POP);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(ImportStatement* node) {
+    compile(node->path.get());
+    emit(OpCode::IMPORT, addChild(node));
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(ExportStatement* node) {
+    emit(OpCode::EXPORT_CHECK);
+
+    if (!node->specifiers.empty()) {
+        for (const auto& specifier : node->specifiers) {
+            emit(OpCode::EXPORT_NAME, addName(specifier->name));
+        }
+        return Value(Null{});
+    }
+
+    if (node->declaration) {
+        compile(node->declaration.get());
+
+        if (auto letStmt = dynamic_cast<LetStatement*>(node->declaration.get())) {
+            emit(OpCode::EXPORT_NAME, addName(letStmt->name->name));
+        } else if (auto classStmt = dynamic_cast<ClassStatement*>(node->declaration.get())) {
+            emit(OpCode::EXPORT_NAME, addName(classStmt->name->name));
+        } else {
+            emit(OpCode::RAISE, addConstant(Value("Câu lệnh export này không được hỗ trợ đâu.")));
+        }
+    }
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(TryStatement* node) {
+    size_t handler = emitJump(OpCode::TRY_BEGIN);
+    unwindStack.push_back(Unwind::Try);
+
+    compile(node->tryBlock.get());
+
+    unwindStack.pop_back();
+    emit(OpCode::TRY_END);
+    size_t endJump = emitJump(OpCode::JUMP);
+
+    // VM đẩy giá trị ngoại lệ lên ngăn xếp rồi nhảy tới đây
+    patchJump(handler);
+    beginScope(node->catchScope);
+    emit(OpCode::DUP);
+    emitDefine(node->catchVariable.get());
+    emit(OpCode::SET_CAUGHT);
+    unwindStack.push_back(Unwind::Catch);
+
+    compile(node->catchBlock.get());
+
+    unwindStack.pop_back();
+    emit(OpCode::CLEAR_CAUGHT);
+    endScope(node->catchScope);
+
+    patchJump(endJump);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(ExpressionStatement* node) {
+    compile(node->expression.get());
+    emit(OpCode::POP);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(LogStatement* node) {
+    compile(node->expression.get());
+    emit(OpCode::LOG);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(SwitchCase* node) {
+    compileStatements(node->statements);
+    return Value(Null{});
+}
+Value BytecodeCompiler::visit(SwitchStatement* node) {
+    compile(node->value.get());
+
+    size_t caseCount = node->cases.size();
+    std::vector<size_t> matchJumps(caseCount, SIZE_MAX);
+    int defaultIdx = -1;
+
+    for (size_t i = 0; i < caseCount; ++i) {
+        const auto& currentCase = node->cases[i];
+        if (currentCase->value) {
+            emit(OpCode::DUP);
+            compile(currentCase->value.get());
+            emit(OpCode::CASE_EQ);
+            matchJumps[i] = emitJump(OpCode::JUMP_IF_TRUE);
+        } else {
+            defaultIdx = static_cast<int>(i);
+        }
+    }
+
+    emit(OpCode::POP);
+    size_t noMatchJump = emitJump(OpCode::JUMP);
+
+    // Mỗi case khớp cần bỏ giá trị switch khỏi ngăn xếp trước khi vào thân
+    std::vector<size_t> entryJumps(caseCount, SIZE_MAX);
+    for (size_t i = 0; i < caseCount; ++i) {
+        if (matchJumps[i] == SIZE_MAX) continue;
+        patchJump(matchJumps[i]);
+        emit(OpCode::POP);
+        entryJumps[i] = emitJump(OpCode::JUMP);
+    }
+
+    beginLoop(true);
+
+    std::vector<size_t> bodyStarts(caseCount);
+    for (size_t i = 0; i < caseCount; ++i) {
+        bodyStarts[i] = chunk->code.size();
+        compile(node->cases[i].get());
+    }
+
+    size_t end = chunk->code.size();
+    for (size_t i = 0; i < caseCount; ++i) {
+        if (entryJumps[i] != SIZE_MAX) {
+            patchJump(entryJumps[i], bodyStarts[i]);
+        }
+    }
+    patchJump(noMatchJump, defaultIdx != -1 ? bodyStarts[defaultIdx] : end);
+
+    endLoop(end, end);
+    return Value(Null{});
+}
+
+Value BytecodeCompiler::visit(DoWhileStatement* node) {
+    beginLoop();
+
+    size_t start = chunk->code.size();
+    compile(node->body.get());
+
+    size_t conditionStart = chunk->code.size();
+    compile(node->condition.get());
+    emit(OpCode::JUMP_IF_TRUE, static_cast<uint32_t>(start));
+
+    endLoop(chunk->code.size(), conditionStart);
+    return Value(Null{});
+}
@@ -0,0 +1,58 @@
+#include "visitor/closure_compiler.hpp"
+#include "common/ast.hpp"
+#include "diagnostics/diagnostic.hpp"
+#include <iostream>
+
+Value ClosureCompiler::run(Program* program) {
+    std::vector<StmtCode> statements = compile(program->body);
+
+    try {
+        for (const auto& statement : statements) {
+            statement();
+            if (isAbrupt()) {
+                break;
+            }
+        }
+        return takeReturnValue();
+    } catch (Diagnostic& e) {
+        std::cerr << e.str() << "\n";
+    }
+
+    return Value(Null{});
+}
+
+void ClosureCompiler::runBody(ASTNode* node) {
+    // exec chỉ nhận thân hàm (FunctionLiteral::body), luôn là một Statement
+    body(static_cast<Statement*>(node))();
+}
+
+// Thân hàm được dịch ở lần gọi đầu tiên. Phần tử của unordered_map không bị dời chỗ khi bảng lớn lên,
+// nên tham chiếu trả về vẫn dùng được trong lúc thân hàm gọi sang hàm khác chưa được dịch.
+const ClosureCompiler::StmtCode& ClosureCompiler::body(Statement* statement) {
+    auto it = bodies.find(statement);
+    if (it == bodies.end()) {
+        it = bodies.emplace(statement, compile(statement)).first;
+    }
+    return it->second;
+}
+
+std::vector<ClosureCompiler::StmtCode> ClosureCompiler::compile(const std::vector<StmtPtr>& statements) {
+    std::vector<StmtCode> result;
+    result.reserve(statements.size());
+    for (const auto& statement : statements) {
+        result.push_back(compile(statement.get()));
+    }
+    return result;
+}
+
+ExprCode ClosureCompiler::fallback(Expression* expression) {
+    return [this, expression] {
+        return evaluate(expression);
+    };
+}
+
+ClosureCompiler::StmtCode ClosureCompiler::fallback(Statement* statement) {
+    return [this, statement] {
+        evaluate(statement);
+    };
+}
@@ -0,0 +1,220 @@
+#include "visitor/closure_compiler.hpp"
+#include "common/ast.hpp"
+#include <functional>
+
+ExprCode ClosureCompiler::compile(Expression* expression) {
+    if (expression == nullptr) {
+        return [] { return Value(Null{}); };
+    }
+
+    switch (expression->type) {
+        case EXPR_LITERAL_INTEGER: {
+            Value value(static_cast<IntegerLiteral*>(expression)->value);
+            return [value] { return value; };
+        }
+        case EXPR_LITERAL_REAL: {
+            Value value(static_cast<RealLiteral*>(expression)->value);
+            return [value] { return value; };
+        }
+        case EXPR_LITERAL_STRING: {
+            Value value(static_cast<StringLiteral*>(expression)->atom);
+            return [value] { return value; };
+        }
+        case EXPR_LITERAL_BOOLEAN: {
+            Value value(static_cast<BooleanLiteral*>(expression)->value);
+            return [value] { return value; };
+        }
+        case EXPR_LITERAL_NULL:
+            return [] { return Value(Null{}); };
+
+        case EXPR_IDENTIFIER:
+            return compileIdentifier(static_cast<Identifier*>(expression));
+        case EXPR_BINARY:
+            return compileBinary(static_cast<BinaryExpression*>(expression));
+        case EXPR_CALL:
+            return compileCall(static_cast<CallExpression*>(expression));
+
+        case EXPR_UNARY: {
+            auto node = static_cast<UnaryExpression*>(expression);
+            return [this, node, operand = compile(node->operand.get())] {
+                return unary(node, operand());
+            };
+        }
+        case EXPR_TERNARY: {
+            auto node = static_cast<TernaryExpression*>(expression);
+            return [condition = compile(node->condition.get()),
+                    thenBranch = compile(node->thenBranch.get()),
+                    elseBranch = compile(node->elseBranch.get())] {
+                return isTruthy(condition()) ? thenBranch() : elseBranch();
+            };
+        }
+        case EXPR_INDEX: {
+            auto node = static_cast<IndexExpression*>(expression);
+            return [this, node, left = compile(node->left.get()), index = compile(node->index.get())] {
+                Value container = left();
+                Value key = index();
+                return element(node, container, key);
+            };
+        }
+        case EXPR_PROPERTY_ACCESS: {
+            auto node = static_cast<PropertyAccess*>(expression);
+            return [this, node, object = compile(node->object.get())] {
+                return getProperty(node, object());
+            };
+        }
+        case EXPR_ASSIGN: {
+            auto node = static_cast<AssignmentExpression*>(expression);
+            return [this, node, value = compile(node->value.get())] {
+                return assign(node, value);
+            };
+        }
+        case EXPR_UPDATE_PREFIX: {
+            auto node = static_cast<PrefixUpdateExpression*>(expression);
+            return [this, node] {
+                return updateLValue(node->operand.get(), node->op, node->token, false);
+            };
+        }
+        case EXPR_UPDATE_POSTFIX: {
+            auto node = static_cast<PostfixUpdateExpression*>(expression);
+            return [this, node] {
+                return updateLValue(node->operand.get(), node->op, node->token, true);
+            };
+        }
+        default:
+            return fallback(expression);
+    }
+}
+
+// Địa chỉ do Resolver tính không đổi lúc chạy, nên chọn luôn cách đọc biến lúc dựng closure
+ExprCode ClosureCompiler::compileIdentifier(Identifier* node) {
+    int depth = node->address.depth;
+    int slot = node->address.slot;
+
+    if (slot >= 0 && depth == 0) {
+        return [this, slot] {
+            return env->findAt(slot);
+        };
+    }
+    if (slot >= 0) {
+        return [this, depth, slot] {
+            return env->ancestor(depth)->findAt(slot);
+        };
+    }
+    if (depth >= 0) {
+        return [this, node, depth] {
+            return env->ancestor(depth)->find(node->name);
+        };
+    }
+    return [this, node] {
+        return env->find(node->name);
+    };
+}
+
+// Int ∘ Int tính ngay bằng op, các kiểu khác đi qua TreeWalker::binary như bình thường
+template <typename IntOp>
+ExprCode ClosureCompiler::compileIntBinary(BinaryExpression* node, IntOp op) {
+    return [this, node, op, left = compile(node->left.get()), right = compile(node->right.get())] {
+        Value a = left();
+        Value b = right();
+        auto x = std::get_if<Int>(&a);
+        auto y = std::get_if<Int>(&b);
+        if (x != nullptr && y != nullptr) {
+            return Value(op(*x, *y));
+        }
+        return binary(node, a, b);
+    };
+}
+
+ExprCode ClosureCompiler::compileBinary(BinaryExpression* node) {
+    using enum TokenType;
+
+    switch (node->op) {
+        case OP_LOGICAL_OR:
+            return [left = compile(node->left.get()), right = compile(node->right.get())] {
+                Value value = left();
+                return isTruthy(value) ? value : right();
+            };
+        case OP_LOGICAL_AND:
+            return [left = compile(node->left.get()), right = compile(node->right.get())] {
+                Value value = left();
+                return !isTruthy(value) ? value : right();
+            };
+        case OP_NULLISH:
+            return [left = compile(node->left.get()), right = compile(node->right.get())] {
+                Value value = left();
+                return !std::holds_alternative<Null>(value) ? value : right();
+            };
+
+        case OP_PLUS:     return compileIntBinary(node, std::plus<Int>{});
+        case OP_MINUS:    return compileIntBinary(node, std::minus<Int>{});
+        case OP_MULTIPLY: return compileIntBinary(node, std::multiplies<Int>{});
+        case OP_EQ:       return compileIntBinary(node, std::equal_to<Int>{});
+        case OP_NEQ:      return compileIntBinary(node, std::not_equal_to<Int>{});
+        case OP_LT:       return compileIntBinary(node, std::less<Int>{});
+        case OP_GT:       return compileIntBinary(node, std::greater<Int>{});
+        case OP_LE:       return compileIntBinary(node, std::less_equal<Int>{});
+        case OP_GE:       return compileIntBinary(node, std::greater_equal<Int>{});
+        case OP_BIT_AND:  return compileIntBinary(node, std::bit_and<Int>{});
+        case OP_BIT_OR:   return compileIntBinary(node, std::bit_or<Int>{});
+        case OP_BIT_XOR:  return compileIntBinary(node, std::bit_xor<Int>{});
+
+        default:
+            return [this, node, left = compile(node->left.get()), right = compile(node->right.get())] {
+                Value a = left();
+                Value b = right();
+                return binary(node, a, b);
+            };
+    }
+}
+
+ExprCode ClosureCompiler::compileCall(CallExpression* node) {
+    // Lời gọi có ...x phải trải tham số ra lúc chạy, để TreeWalker lo
+    if (node->hasSpread) {
+        return fallback(node);
+    }
+
+    std::vector<ExprCode> args;
+    args.reserve(node->args.size());
+    for (const auto& arg : node->args) {
+        args.push_back(compile(arg.get()));
+    }
+
+    // obj.method(...): giống TreeWalker::visit(CallExpression), gọi thẳng phương thức qua inline cache
+    if (node->callee->type == EXPR_PROPERTY_ACCESS) {
+        auto access = static_cast<PropertyAccess*>(node->callee.get());
+        return [this, node, access, object = compile(access->object.get()), args = std::move(args)] {
+            Value receiver = object();
+            Function method = access->cache.findMethod(receiver, access->key);
+            Value callee;
+            if (method == nullptr) {
+                callee = getProperty(access, receiver);
+            }
+            bool passesReceiver = method != nullptr && !std::holds_alternative<Instance>(receiver);
+
+            ValueStack::Frame frame(valueStack, args.size() + (passesReceiver ? 1 : 0));
+            if (passesReceiver) {
+                frame.push(receiver);
+            }
+            for (const auto& arg : args) {
+                frame.push(arg());
+            }
+            if (node->isTailCall && prepareTailCall(node, callee, receiver, method, frame.arguments())) {
+                return Value(Null{});
+            }
+            return finishCall(node, callee, receiver, method, frame.arguments());
+        };
+    }
+
+    return [this, node, callee = compile(node->callee.get()), args = std::move(args)] {
+        Value function = callee();
+
+        ValueStack::Frame frame(valueStack, args.size());
+        for (const auto& arg : args) {
+            frame.push(arg());
+        }
+        if (node->isTailCall && prepareTailCall(node, function, Value(Null{}), nullptr, frame.arguments())) {
+            return Value(Null{});
+        }
+        return finishCall(node, function, Value(Null{}), nullptr, frame.arguments());
+    };
+}
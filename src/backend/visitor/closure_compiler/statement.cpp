@@ -0,0 +1,160 @@
+#include "visitor/closure_compiler.hpp"
+#include "common/ast.hpp"
+#include "utils/guards.hpp"
+
+ClosureCompiler::StmtCode ClosureCompiler::compile(Statement* statement) {
+    if (statement == nullptr) {
+        return [] {};
+    }
+
+    switch (statement->type) {
+        case STMT_EXPR:
+            return [expression = compile(static_cast<ExpressionStatement*>(statement)->expression.get())] {
+                expression();
+            };
+        case STMT_LET: {
+            auto node = static_cast<LetStatement*>(statement);
+            return [this, node, value = compile(node->value.get())] {
+                defineIdentifier(node->name.get(), value(), node->isConstant);
+            };
+        }
+        case STMT_RETURN:
+            return [this, value = compile(static_cast<ReturnStatement*>(statement)->value.get())] {
+                Value result = value();
+                if (completion.type != CompletionType::TailCall) {
+                    completion = Completion{CompletionType::Return, std::move(result)};
+                }
+            };
+        case STMT_BREAK:
+            return [this] {
+                completion.type = CompletionType::Break;
+            };
+        case STMT_CONTINUE:
+            return [this] {
+                completion.type = CompletionType::Continue;
+            };
+
+        case STMT_BLOCK:
+            return compileBlock(static_cast<BlockStatement*>(statement));
+        case STMT_IF:
+            return compileIf(static_cast<IfStatement*>(statement));
+        case STMT_WHILE:
+            return compileWhile(static_cast<WhileStatement*>(statement));
+        case STMT_FOR:
+            return compileFor(static_cast<ForStatement*>(statement));
+        case STMT_FOR_IN:
+            return compileForIn(static_cast<ForInStatement*>(statement));
+        case STMT_DO_WHILE:
+            return compileDoWhile(static_cast<DoWhileStatement*>(statement));
+
+        default:
+            return fallback(statement);
+    }
+}
+
+// Scope mà Resolver đã bỏ (isElided) thì closure không dựng Environment, chọn ngay lúc dịch
+ClosureCompiler::StmtCode ClosureCompiler::compileBlock(BlockStatement* node) {
+    std::vector<StmtCode> statements = compile(node->statements);
+
+    if (node->scope.isElided) {
+        return [this, statements = std::move(statements)] {
+            for (const auto& statement : statements) {
+                statement();
+                if (isAbrupt()) {
+                    break;
+                }
+            }
+        };
+    }
+
+    return [this, scope = &node->scope, statements = std::move(statements)] {
+        EnvGuard guard(this->env, scope);
+        for (const auto& statement : statements) {
+            statement();
+            if (isAbrupt()) {
+                break;
+            }
+        }
+    };
+}
+
+ClosureCompiler::StmtCode ClosureCompiler::compileIf(IfStatement* node) {
+    return [this, scope = &node->scope,
+            condition = compile(node->condition.get()),
+            thenBranch = compile(node->thenBranch.get()),
+            elseBranch = compile(node->elseBranch.get())] {
+        EnvGuard guard(this->env, scope);
+        if (isTruthy(condition())) {
+            thenBranch();
+        } else {
+            elseBranch();
+        }
+    };
+}
+
+ClosureCompiler::StmtCode ClosureCompiler::compileWhile(WhileStatement* node) {
+    return [this, scope = &node->scope, condition = compile(node->condition.get()), body = compile(node->body.get())] {
+        EnvGuard guard(this->env, scope);
+        while (isTruthy(condition())) {
+            body();
+            if (exitsLoop()) {
+                break;
+            }
+        }
+    };
+}
+
+ClosureCompiler::StmtCode ClosureCompiler::compileFor(ForStatement* node) {
+    // for (;;) không có điều kiện thì lặp mãi
+    ExprCode condition = node->condition != nullptr
+        ? compile(node->condition.get())
+        : ExprCode([] { return Value(true); });
+
+    return [this, scope = &node->scope,
+            init = compile(node->init.get()),
+            condition = std::move(condition),
+            update = compile(node->update.get()),
+            body = compile(node->body.get())] {
+        EnvGuard guard(this->env, scope);
+        init();
+        while (isTruthy(condition())) {
+            body();
+            if (exitsLoop()) {
+                break;
+            }
+            update();
+        }
+    };
+}
+
+ClosureCompiler::StmtCode ClosureCompiler::compileForIn(ForInStatement* node) {
+    return [this, node, collection = compile(node->collection.get()), body = compile(node->body.get())] {
+        EnvGuard guard(this->env, &node->scope);
+
+        Value items = collection();
+        Iterable* iterable = toIterable(items);
+        if (iterable == nullptr) {
+            throwRuntimeErr(node->token, "Kiểu dữ liệu này không thể duyệt qua.");
+        }
+
+        auto iterator = iterable->makeIterator();
+        while (iterator->hasNext()) {
+            defineIdentifier(node->variable.get(), iterator->next());
+            body();
+            if (exitsLoop()) {
+                break;
+            }
+        }
+    };
+}
+
+ClosureCompiler::StmtCode ClosureCompiler::compileDoWhile(DoWhileStatement* node) {
+    return [this, body = compile(node->body.get()), condition = compile(node->condition.get())] {
+        do {
+            body();
+            if (exitsLoop()) {
+                break;
+            }
+        } while (isTruthy(condition()));
+    };
+}
@@ -1,25 +1,103 @@
 #include "visitor/tree_walker.hpp"
 #include "common/ast.hpp"
+#include "callable/function_callable.hpp"
 #include "diagnostics/diagnostic.hpp"
 
 #include <functional>
 #include <sstream>
 #include <type_traits>
 
+namespace {
+    // a += b khi a là chuỗi/mảng mà ngoài ô lưu trữ ra chỉ còn bản đọc current giữ nó:
+    // nối thẳng vào a thay vì dựng chuỗi/mảng mới. Chuỗi đã intern dùng chung nên không được sửa.
+    bool appendInPlace(Value& storage, Value& current, const Value& rvalue) {
+        if (auto string = std::get_if<String>(&storage)) {
+            auto read = std::get_if<String>(&current);
+            auto other = std::get_if<String>(&rvalue);
+            if (read == nullptr || other == nullptr || !(*read == *string)
+                || string->use_count() != 2 || (*string)->isInterned) {
+                return false;
+            }
+            current = Value(Null{});
+            (*string)->str += (*other)->str;
+            (*string)->isHashed = false;
+            return true;
+        }
+        if (auto array = std::get_if<Array>(&storage)) {
+            auto read = std::get_if<Array>(&current);
+            auto other = std::get_if<Array>(&rvalue);
+            if (read == nullptr || other == nullptr || !(*read == *array) || array->use_count() != 2) {
+                return false;
+            }
+            current = Value(Null{});
+            const auto& extra = (*other)->elements;
+            (*array)->elements.insert((*array)->elements.end(), extra.begin(), extra.end());
+            return true;
+        }
+        return false;
+    }
+}
+
 Value TreeWalker::visit(Identifier* node) {
-    return env->find(node->name);
+    const LexicalAddress& address = node->address;
+    if (address.slot >= 0) {
+        return env->ancestor(address.depth)->findAt(address.slot);
+    }
+    Environment* target = address.depth >= 0 ? env->ancestor(address.depth) : env.get();
+    if (Variable* variable = lookupVariable(node, target)) {
+        return variable->value;
+    }
+    return Value(Null{});
+}
+
+// Chỗ lưu giá trị hiện tại của biến mà expression đọc tới, nullptr nếu expression không phải biến đã khai báo
+const Value* TreeWalker::variableStorage(Expression* expression) {
+    if (expression->type != NodeType::EXPR_IDENTIFIER) {
+        return nullptr;
+    }
+    auto node = static_cast<Identifier*>(expression);
+    const LexicalAddress& address = node->address;
+    Variable* variable = nullptr;
+    if (address.slot >= 0) {
+        variable = env->ancestor(address.depth)->lookupAt(address.slot);
+    } else {
+        variable = lookupVariable(node, address.depth >= 0 ? env->ancestor(address.depth) : env.get());
+    }
+    return variable != nullptr ? &variable->value : nullptr;
+}
+
+// Tên lưu theo tên (slot = -1) nhìn từ target, như target->lookup(node->name).
+// Tên thấy ngay trong target nhiều lần liên tiếp thì node giữ luôn con trỏ tới biến đó,
+// những lần sau chỉ cần so identity() của target thay vì băm tên.
+Variable* TreeWalker::lookupVariable(Identifier* node, Environment* target) {
+    auto& quickening = node->quickening;
+    if (quickening.form.variable != nullptr) {
+        if (quickening.form.environment == target->identity()) {
+            return quickening.form.variable;
+        }
+        quickening.deoptimize();
+    }
+
+    if (Variable* variable = target->lookupOwn(node->name)) {
+        quickening.observe(ResolvedVariable{target->identity(), variable});
+        return variable;
+    }
+    quickening.observe(ResolvedVariable{});
+    return target->lookup(node->name);
 }
 
 Value TreeWalker::visit(UnaryExpression* node) {
-    Value right = evaluate(node->operand.get());
+    return unary(node, evaluate(node->operand.get()));
+}
 
+Value TreeWalker::unary(UnaryExpression* node, const Value& right) {
     if (auto opFunc = opDispatcher->find(node->op, right)) {
         return (*opFunc)(right);
     }
 
     std::ostringstream os;
 
-    os << "Toán tử một ngôi '" << node->token.lexeme << "' không hợp lệ cho phép toán này: '" << right << "'\n";
+    os << "Toán tử một ngôi '" << node->token.lexeme() << "' không hợp lệ cho phép toán này: '" << right << "'\n";
     
     auto diag = Diagnostic::RuntimeErr(os.str(), node->token);
     throwRuntimeErr(node->token, diag.str());
@@ -29,6 +107,30 @@ Value TreeWalker::visit(UnaryExpression* node) {
 
 Value TreeWalker::visit(BinaryExpression* node) {
     using enum TokenType;
+    // Nút đã chuyên biệt hoá theo (toán tử, kiểu hai vế): tính thẳng bằng kernel, trượt guard thì về binary().
+    // Vế là biến thì kernel đọc thẳng từ chỗ lưu của biến, không chép ra Value tạm. Vế trái chỉ được đọc
+    // như vậy khi vế phải là biến hoặc literal, vì tính vế phải không thể đổi giá trị của nó.
+    if (BinaryKernel kernel = node->quickening.form) {
+        Expression* leftNode = node->left.get();
+        Expression* rightNode = node->right.get();
+        bool isRightPure = rightNode->type == NodeType::EXPR_IDENTIFIER || rightNode->type == NodeType::EXPR_LITERAL_INTEGER
+            || rightNode->type == NodeType::EXPR_LITERAL_REAL;
+
+        const Value* leftStorage = isRightPure ? variableStorage(leftNode) : nullptr;
+        Value leftValue = leftStorage != nullptr ? Value() : evaluate(leftNode);
+        const Value* rightStorage = variableStorage(rightNode);
+        Value rightValue = rightStorage != nullptr ? Value() : evaluate(rightNode);
+        const Value& left = leftStorage != nullptr ? *leftStorage : leftValue;
+        const Value& right = rightStorage != nullptr ? *rightStorage : rightValue;
+
+        Value result;
+        if (kernel(left, right, result)) {
+            return result;
+        }
+        node->quickening.deoptimize();
+        return binary(node, Value(left), Value(right));
+    }
+
     if (node->op == OP_LOGICAL_OR) {
         Value left = evaluate(node->left.get());
         if (isTruthy(left)) return left;
@@ -50,6 +152,16 @@ Value TreeWalker::visit(BinaryExpression* node) {
 
     Value left = evaluate(node->left.get());
     Value right = evaluate(node->right.get());
+    node->quickening.observe(findBinaryKernel(node->op, left, right));
+    return binary(node, left, right);
+}
+
+// Phần còn lại của BinaryExpression (trừ &&, ||, ??) sau khi đã tính xong hai vế
+Value TreeWalker::binary(BinaryExpression* node, const Value& left, const Value& right) {
+    Value result;
+    if (fastBinary(node->op, left, right, result)) {
+        return result;
+    }
 
     if (auto opFunc = opDispatcher->find(node->op, left, right)) {
         return (*opFunc)(left, right);
@@ -57,7 +169,7 @@ Value TreeWalker::visit(BinaryExpression* node) {
 
     std::ostringstream os;
 
-    os << "Toán tử hai ngôi '" << node->token.lexeme << "' không hợp lệ cho phép toán với vế trái: '" << left << "' và right: '" << right << "'\n";
+    os << "Toán tử hai ngôi '" << node->token.lexeme() << "' không hợp lệ cho phép toán với vế trái: '" << left << "' và right: '" << right << "'\n";
 
     auto diag = Diagnostic::RuntimeErr(os.str(), node->token);
     throwRuntimeErr(node->token, diag.str());
@@ -65,12 +177,11 @@ Value TreeWalker::visit(BinaryExpression* node) {
     return Value(Null{});
 }
 
-Value TreeWalker::visit(CallExpression* node) {
-    Value callee = evaluate(node->callee.get());
-    
-    std::vector<Value> args;
+// Chỉ dùng cho lời gọi có ...x, khi chưa biết trước số tham số
+void TreeWalker::evaluateArguments(CallExpression* node, std::vector<Value>& args) {
     for (const auto& arg : node->args) {
-        if (auto spread = dynamic_cast<SpreadExpression*>(arg.get())) {
+        if (arg->type == NodeType::EXPR_SPREAD) {
+            auto spread = static_cast<SpreadExpression*>(arg.get());
             Value collection = evaluate(spread->expression.get());
             
             if (auto iterable = toIterable(collection)) {
@@ -85,12 +196,98 @@ Value TreeWalker::visit(CallExpression* node) {
             args.push_back(evaluate(arg.get()));
         }
     }
-    
+}
+
+// Gọi thẳng phương thức đã tìm được cho receiver.name(...).
+// Sai số tham số thì dựng lại bound method và đi đường thường để thông báo lỗi giữ nguyên như cũ.
+Value TreeWalker::callMethod(PropertyAccess* node, const Value& receiver, const Function& method, MutableArguments args) {
+    int argsCount = static_cast<int>(args.size());
+
+    if (auto instance = std::get_if<Instance>(&receiver)) {
+        if (method->arity().accepts(argsCount)) {
+            if (auto script = dynamic_cast<MeowScriptFunction*>(method.get())) {
+                return exec(script->declaration->body.get(), script->makeFrame(args, &receiver));
+            }
+            return MeowScriptBoundMethod::invoke(this, *instance, method, args);
+        }
+        return this->call(getProperty(node, receiver), args);
+    }
+
+    // Hàm thư viện nhận receiver ở tham số đầu tiên, đã được đặt sẵn trong args
+    if (method->arity().withoutReceiver().accepts(argsCount - 1)) {
+        return method->call(this, args);
+    }
+    return this->call(getProperty(node, receiver), args.subspan(1));
+}
+
+Value TreeWalker::visit(CallExpression* node) {
+    Value callee;
+    Value receiver;
+    Function method = nullptr;
+    PropertyAccess* access = nullptr;
+
+    // obj.method(...) gọi thẳng phương thức, không dựng bound method hay hàm bọc receiver
+    if (node->callee->type == NodeType::EXPR_PROPERTY_ACCESS) {
+        access = static_cast<PropertyAccess*>(node->callee.get());
+        receiver = evaluate(access->object.get());
+        method = access->cache.findMethod(receiver, access->key);
+        if (method == nullptr) {
+            callee = getProperty(access, receiver);
+        }
+    } else {
+        callee = evaluate(node->callee.get());
+    }
+    bool passesReceiver = method != nullptr && !std::holds_alternative<Instance>(receiver);
+
+    // Số tham số biết trước thì đặt thẳng lên valueStack, chỉ lời gọi có ...x mới cần vector riêng
+    std::vector<Value> spreadArgs;
+    std::optional<ValueStack::Frame> frame;
+    MutableArguments args;
+
+    if (node->hasSpread) {
+        if (passesReceiver) {
+            spreadArgs.push_back(receiver);
+        }
+        evaluateArguments(node, spreadArgs);
+        args = spreadArgs;
+    } else {
+        frame.emplace(valueStack, node->args.size() + (passesReceiver ? 1 : 0));
+        if (passesReceiver) {
+            frame->push(receiver);
+        }
+        for (const auto& arg : node->args) {
+            frame->push(evaluate(arg.get()));
+        }
+        args = frame->arguments();
+    }
+
+    if (node->isTailCall && prepareTailCall(node, callee, receiver, method, args)) {
+        return Value(Null{});
+    }
+    return finishCall(node, callee, receiver, method, args);
+}
+
+// Gọi sau khi đã tính xong callee (hoặc receiver + method của obj.method(...)) và tham số
+Value TreeWalker::finishCall(CallExpression* node, const Value& callee, const Value& receiver, const Function& method, MutableArguments args) {
+    try {
+        if (method != nullptr) {
+            return callMethod(static_cast<PropertyAccess*>(node->callee.get()), receiver, method, args);
+        }
+        return callFrame(callee, args);
+    } catch (...) {
+        rethrowAtCallSite(node);
+    }
+
+    return Value(Null{});
+}
+
+// Lỗi lọt ra khỏi hàm được gọi ở node được gắn thêm vị trí lời gọi đó, gọi trong khối catch
+void TreeWalker::rethrowAtCallSite(CallExpression* node) {
     try {
-        return this->call(callee, args); 
+        throw;
     } catch (FunctionException &e) {
         std::ostringstream os;
-        os << "[DEBUG] Lỗi ở [" << node->token.filename << ":" << node->token.line << ":" << node->token.col << "] " << node->token.getLine() << "\n";
+        os << "[DEBUG] Lỗi ở [" << node->token.filename() << ":" << node->token.line() << ":" << node->token.col() << "] " << node->token.getLine() << "\n";
         std::cout << os.str();
         this->throwRuntimeErr(node->token, e.what());
     } catch (Diagnostic& e) {
@@ -99,15 +296,57 @@ Value TreeWalker::visit(CallExpression* node) {
     catch (std::runtime_error &e) {
         this->throwRuntimeErr(node->token, e.what());
     }
+}
 
-    return Value(Null{});
+// return f(...): nếu f là hàm MeowScript thì dựng sẵn frame của nó và để exec đang chạy hàm hiện tại
+// chạy tiếp f, hàm hiện tại kết thúc luôn. Mọi trường hợp khác (hàm native, class, sai số tham số...)
+// trả về false để finishCall gọi và báo lỗi như một lời gọi thường.
+bool TreeWalker::prepareTailCall(CallExpression* node, const Value& callee, const Value& receiver, const Function& method, MutableArguments args) {
+    MeowScriptFunction* script = nullptr;
+    const Value* self = nullptr;
+
+    if (method != nullptr) {
+        if (!std::holds_alternative<Instance>(receiver)) {
+            return false;
+        }
+        script = dynamic_cast<MeowScriptFunction*>(method.get());
+        self = &receiver;
+    } else if (auto function = std::get_if<Function>(&callee)) {
+        script = dynamic_cast<MeowScriptFunction*>(function->get());
+    }
+
+    if (script == nullptr || !script->arity().accepts(static_cast<int>(args.size()))) {
+        return false;
+    }
+
+    tailCall = TailCall{node, script->declaration->body.get(), script->makeFrame(args, self)};
+    completion.type = CompletionType::TailCall;
+    return true;
 }
 
 Value TreeWalker::visit(IndexExpression* node) {
     Value left = evaluate(node->left.get());
+    Value index = evaluate(node->index.get());
+
+    // Nút đã chuyên biệt hoá cho mảng: đọc thẳng phần tử, trượt guard thì về element()
+    if (node->quickening.form == IndexQuickening::ArrayElement) {
+        auto array = std::get_if<Array>(&left);
+        auto position = std::get_if<Int>(&index);
+        if (array != nullptr && position != nullptr && *position >= 0 && static_cast<size_t>(*position) < (*array)->elements.size()) {
+            return (*array)->elements[static_cast<size_t>(*position)];
+        }
+        node->quickening.deoptimize();
+        return element(node, left, index);
+    }
+
+    bool isArrayElement = std::holds_alternative<Array>(left) && std::holds_alternative<Int>(index);
+    node->quickening.observe(isArrayElement ? IndexQuickening::ArrayElement : IndexQuickening::Generic);
+    return element(node, left, index);
+}
 
+// Phần còn lại của IndexExpression sau khi đã tính xong mảng/object và chỉ số
+Value TreeWalker::element(IndexExpression* node, const Value& left, const Value& index) {
     if (Indexable* indexable = toIndexable(left)) {
-        Value index = evaluate(node->index.get());
         try {
             return indexable->get(index);
         } catch (const FunctionException& e) {
@@ -117,55 +356,79 @@ Value TreeWalker::visit(IndexExpression* node) {
         }
     }
     std::ostringstream os;
+
     os << "Chỉ có thể truy cập phần tử của Mảng hoặc Object: '";
     os << left;
     os << "' và index: '";
-    os << evaluate(node->index.get()) << "'";
+    os << index << "'";
 
     auto diag = Diagnostic::RuntimeErr(os.str(), node->token);
     throw Diagnostic::RuntimeErr(diag.str(), node->token);
 }
 
 Value TreeWalker::visit(AssignmentExpression* node) {
+    return assign(node, [this, node] { return evaluate(node->value.get()); });
+}
+
+// evaluateValue tính vế phải; nó được gọi đúng một lần, sau khi đã xác định vị trí được gán
+template <typename EvaluateValue>
+Value TreeWalker::assign(AssignmentExpression* node, const EvaluateValue& evaluateValue) {
     try {
         LValue target = resolveLValue(node->target.get());
-        Value rvalue = evaluate(node->value.get());
-
-        Value finalValue;
 
         if (node->token.type == TokenType::OP_ASSIGN) {
-            finalValue = rvalue; // Gán thường: a = b
-        } else {
-            Value lvalue = target.currentValue;
-            
-            TokenType opType = TokenType::UNKNOWN;
-            switch (node->token.type) {
-                case TokenType::OP_PLUS_ASSIGN:   opType = TokenType::OP_PLUS; break;
-                case TokenType::OP_MINUS_ASSIGN:  opType = TokenType::OP_MINUS; break;
-                case TokenType::OP_MULTIPLY_ASSIGN: opType = TokenType::OP_MULTIPLY; break;
-                case TokenType::OP_DIVIDE_ASSIGN: opType = TokenType::OP_DIVIDE; break;
-                case TokenType::OP_MODULO_ASSIGN: opType = TokenType::OP_MODULO; break;
-                case TokenType::OP_EXPONENT_ASSIGN: opType = TokenType::OP_EXPONENT; break;
-                case TokenType::OP_AND_ASSIGN: opType = TokenType::OP_BIT_AND; break;
-                case TokenType::OP_OR_ASSIGN:  opType = TokenType::OP_BIT_OR; break;
-                case TokenType::OP_XOR_ASSIGN: opType = TokenType::OP_BIT_XOR; break;
-                case TokenType::OP_LSHIFT_ASSIGN:  opType = TokenType::OP_LSHIFT; break;
-                case TokenType::OP_RSHIFT_ASSIGN: opType = TokenType::OP_RSHIFT; break;
-                default:
-                    throwRuntimeErr(node->token, "Toán tử gán này... lạ quá tớ chưa biết!");
+            // Gán thường: a = b, không cần giá trị cũ. Riêng Indexable::get có thể gọi __getitem__
+            // hoặc báo lỗi chỉ số trước khi tính vế phải, nên vẫn đọc khi không chắc nó vô hại
+            if (target.kind == LValue::Kind::Element && lvalueStorage(target) == nullptr
+                && !(std::holds_alternative<Object>(target.container) && isHashable(target.key))) {
+                readLValue(target);
             }
-            
-            if (auto opFunc = opDispatcher->find(opType, lvalue, rvalue)) {
-                finalValue = (*opFunc)(lvalue, rvalue);
-            } else {
-                std::ostringstream os;
-                os << "Không thể thực hiện phép toán gán kép '" << node->token.lexeme 
-                   << "' với '" << lvalue << "' và '" << rvalue << "'.";
-                throwRuntimeErr(node->token, os.str());
+            Value rvalue = evaluateValue();
+            writeLValue(target, rvalue);
+            return rvalue;
+        }
+
+        Value lvalue = readLValue(target);
+        Value rvalue = evaluateValue();
+
+        Value finalValue;
+
+        TokenType opType = TokenType::UNKNOWN;
+        switch (node->token.type) {
+            case TokenType::OP_PLUS_ASSIGN:   opType = TokenType::OP_PLUS; break;
+            case TokenType::OP_MINUS_ASSIGN:  opType = TokenType::OP_MINUS; break;
+            case TokenType::OP_MULTIPLY_ASSIGN: opType = TokenType::OP_MULTIPLY; break;
+            case TokenType::OP_DIVIDE_ASSIGN: opType = TokenType::OP_DIVIDE; break;
+            case TokenType::OP_MODULO_ASSIGN: opType = TokenType::OP_MODULO; break;
+            case TokenType::OP_EXPONENT_ASSIGN: opType = TokenType::OP_EXPONENT; break;
+            case TokenType::OP_AND_ASSIGN: opType = TokenType::OP_BIT_AND; break;
+            case TokenType::OP_OR_ASSIGN:  opType = TokenType::OP_BIT_OR; break;
+            case TokenType::OP_XOR_ASSIGN: opType = TokenType::OP_BIT_XOR; break;
+            case TokenType::OP_LSHIFT_ASSIGN:  opType = TokenType::OP_LSHIFT; break;
+            case TokenType::OP_RSHIFT_ASSIGN: opType = TokenType::OP_RSHIFT; break;
+            default:
+                throwRuntimeErr(node->token, "Toán tử gán này... lạ quá tớ chưa biết!");
+        }
+        
+        if (opType == TokenType::OP_PLUS) {
+            Value* storage = lvalueStorage(target);
+            if (storage != nullptr && appendInPlace(*storage, lvalue, rvalue)) {
+                return *storage;
             }
         }
+
+        if (fastBinary(opType, lvalue, rvalue, finalValue)) {
+            // Int/Real: đã tính xong tại chỗ
+        } else if (auto opFunc = opDispatcher->find(opType, lvalue, rvalue)) {
+            finalValue = (*opFunc)(lvalue, rvalue);
+        } else {
+            std::ostringstream os;
+            os << "Không thể thực hiện phép toán gán kép '" << node->token.lexeme() 
+               << "' với '" << lvalue << "' và '" << rvalue << "'.";
+            throwRuntimeErr(node->token, os.str());
+        }
         
-        target.setter(finalValue);
+        writeLValue(target, finalValue);
         return finalValue;
 
     } catch (const FunctionException& e) {
@@ -174,6 +437,9 @@ Value TreeWalker::visit(AssignmentExpression* node) {
         throw Diagnostic::RuntimeErr(e.what(), node->token);
     }
 }
+
+template Value TreeWalker::assign<ExprCode>(AssignmentExpression* node, const ExprCode& evaluateValue);
+
 Value TreeWalker::visit(TernaryExpression* node) {
     Value condition = evaluate(node->condition.get());
     if (isTruthy(condition)) {
@@ -184,11 +450,19 @@ Value TreeWalker::visit(TernaryExpression* node) {
     return Value(Null{});
 }
 Value TreeWalker::visit(PropertyAccess* node) {
-    Value object = evaluate(node->object.get());
+    return getProperty(node, evaluate(node->object.get()));
+}
 
+Value TreeWalker::getProperty(PropertyAccess* node, const Value& object) {
     if (Indexable* indexable = toIndexable(object)) {
-        Value propertyKey = Value(node->property->name);
+        Value propertyKey = Value(node->key);
         try {
+            if (auto instance = std::get_if<Instance>(&object)) {
+                return node->cache.get(instance->get(), node->key);
+            }
+            if (auto klass = std::get_if<Class>(&object)) {
+                return node->cache.get(klass->get(), node->key);
+            }
             return indexable->get(propertyKey);
         } catch (const FunctionException& e) {
             throw Diagnostic::RuntimeErr(e.what(), node->token);
@@ -217,7 +491,7 @@ Value TreeWalker::visit(PropertyAssignment* node) {
     auto obj = std::get<Object>(target);
     Value value = evaluate(node->value.get());
 
-    const std::string& name = node->property->token.lexeme;
+    const std::string& name = node->property->name;
 
     HashKey key{Value(name)};
 
@@ -233,6 +507,12 @@ Value TreeWalker::visit(PropertyAssignment* node) {
     return Value(Null{});
 }
 Value TreeWalker::visit(ThisExpression* node) {
+    if (node->address.slot >= 0) {
+        return env->ancestor(node->address.depth)->findAt(node->address.slot);
+    }
+    if (node->address.depth >= 0) {
+        return env->ancestor(node->address.depth)->find("this");
+    }
     return env->find("this");
 }
 Value TreeWalker::visit(SuperExpression* node) {
@@ -256,7 +536,7 @@ Value TreeWalker::visit(SuperExpression* node) {
         throwRuntimeErr(node->token, "Không tìm thấy phương thức trên lớp cha.");
     }
 
-    return std::make_shared<MeowScriptBoundMethod>(object, method);
+    return makeRef<MeowScriptBoundMethod>(object, method);
 }
 
 Value TreeWalker::visit(NewExpression* node) {
@@ -266,29 +546,35 @@ Value TreeWalker::visit(NewExpression* node) {
 }
 
 Value TreeWalker::visit(PrefixUpdateExpression* node) {
-    LValue lvalue = resolveLValue(node->operand.get());
-
-    if (!std::holds_alternative<Int>(lvalue.currentValue)) {
-        throwRuntimeErr(node->token, "Toán tử ++/-- chỉ dùng cho số nguyên.");
-    }
-    
-    Value newValue = std::get<Int>(lvalue.currentValue) + (node->op == TokenType::OP_INCREMENT ? 1 : -1);
-    lvalue.setter(newValue);
-    
-    return newValue;
+    return updateLValue(node->operand.get(), node->op, node->token, false);
 }
 
 Value TreeWalker::visit(PostfixUpdateExpression* node) {
-    LValue lvalue = resolveLValue(node->operand.get());
+    return updateLValue(node->operand.get(), node->op, node->token, true);
+}
+
+// ++/-- cộng thẳng vào số nguyên đang nằm trong biến/phần tử/trường, trả về giá trị trước hoặc sau khi cập nhật
+Value TreeWalker::updateLValue(ASTNode* operand, TokenType op, const Token& token, bool returnsOld) {
+    LValue target = resolveLValue(operand);
+    Int delta = op == TokenType::OP_INCREMENT ? 1 : -1;
+
+    if (Value* storage = lvalueStorage(target)) {
+        if (auto number = std::get_if<Int>(storage)) {
+            Int oldValue = *number;
+            *number += delta;
+            return returnsOld ? oldValue : *number;
+        }
+    }
 
-    if (!std::holds_alternative<Int>(lvalue.currentValue)) {
-        throwRuntimeErr(node->token, "Toán tử ++/-- chỉ dùng cho số nguyên.");
+    Value currentValue = readLValue(target);
+    if (!std::holds_alternative<Int>(currentValue)) {
+        throwRuntimeErr(token, "Toán tử ++/-- chỉ dùng cho số nguyên.");
     }
 
-    Value newValue = std::get<Int>(lvalue.currentValue) + (node->op == TokenType::OP_INCREMENT ? 1 : -1);
-    lvalue.setter(newValue);
+    Value newValue = std::get<Int>(currentValue) + delta;
+    writeLValue(target, newValue);
 
-    return lvalue.currentValue;
+    return returnsOld ? currentValue : newValue;
 }
 
 Value TreeWalker::visit(SpreadExpression* node) {
@@ -12,7 +12,7 @@ Value TreeWalker::visit(RealLiteral* node) {
     return Value(node->value);
 }
 Value TreeWalker::visit(StringLiteral* node) {
-    return Value(std::make_shared<StringData>(node->value));
+    return Value(node->atom);
 }
 Value TreeWalker::visit(BooleanLiteral* node) {
     return Value(node->value);
@@ -22,7 +22,7 @@ Value TreeWalker::visit(NullLiteral* node) {
 }
 
 Value TreeWalker::visit(ArrayLiteral* node) {
-    auto data = std::make_shared<ArrayData>();
+    auto data = makeRef<ArrayData>();
 
     for (const auto& element : node->elements) {
         if (auto spread = dynamic_cast<SpreadExpression*>(element.get())) {
@@ -44,7 +44,7 @@ Value TreeWalker::visit(ArrayLiteral* node) {
 }
 
 Value TreeWalker::visit(ObjectLiteral* node) {
-    auto obj = std::make_shared<ObjectData>();
+    auto obj = makeRef<ObjectData>();
 
     for (const auto& pair : node->properties) {
         Value key = evaluate(pair.first.get());
@@ -61,7 +61,7 @@ Value TreeWalker::visit(ObjectLiteral* node) {
 }
 
 Value TreeWalker::visit(FunctionLiteral* node) {
-    Function function = std::make_shared<MeowScriptFunction>(node, this->env);
+    Function function = makeRef<MeowScriptFunction>(node, this->env);
     
     return Value(function);
 }
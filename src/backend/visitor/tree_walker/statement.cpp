@@ -8,27 +8,27 @@
 
 Value TreeWalker::visit(LetStatement* node) {
     Value value = evaluate(node->value.get());
-    env->define(node->name->name, value, node->isConstant);
+    defineIdentifier(node->name.get(), value, node->isConstant);
 
     return value;
 }
 Value TreeWalker::visit(ReturnStatement* node) {
+    Value value = evaluate(node->value.get());
 
-    if (node->value != nullptr) {
-        throw ReturnException(node->value->accept(this));
+    // Lời gọi ở vị trí đuôi đã để lại completion TailCall
+    if (completion.type != CompletionType::TailCall) {
+        completion = Completion{CompletionType::Return, std::move(value)};
     }
 
-    throw ReturnException(Value(Null{}));
-
     return Value(Null{});
 }
 Value TreeWalker::visit(BreakStatement* node) {
-    throw BreakException();
+    completion.type = CompletionType::Break;
 
     return Value(Null{});
 }
 Value TreeWalker::visit(ContinueStatement* node) {
-    throw ContinueException();
+    completion.type = CompletionType::Continue;
     return Value(Null{});
 }
 Value TreeWalker::visit(ThrowStatement* node) {
@@ -46,7 +46,7 @@ Value TreeWalker::visit(ThrowStatement* node) {
 }
 
 Value TreeWalker::visit(IfStatement* node) {
-    EnvGuard guard(this->env);
+    EnvGuard guard(this->env, &node->scope);
 
     Value condition = evaluate(node->condition.get());
 
@@ -59,27 +59,26 @@ Value TreeWalker::visit(IfStatement* node) {
     return Value(Null{});
 }
 Value TreeWalker::visit(WhileStatement* node) {
-    EnvGuard guard(this->env);
-    while (isTruthy(evaluate(node->condition.get()))) {
-        try {
-            evaluate(node->body.get());
-        } catch (const BreakException&) {
+    EnvGuard guard(this->env, &node->scope);
+    uint32_t iterations = 0;
+    while (!finishesNatively(node, iterations) && isTruthy(evaluate(node->condition.get()))) {
+        evaluate(node->body.get());
+        if (exitsLoop()) {
             break;
-        } catch (const ContinueException&) {
-            continue;
         }
     }
 
     return Value(Null{});
 }
 Value TreeWalker::visit(ForStatement* node) {
-    EnvGuard guard(this->env);
+    EnvGuard guard(this->env, &node->scope);
 
     if (node->init != nullptr) {
         evaluate(node->init.get());
     }
 
-    while (true) {
+    uint32_t iterations = 0;
+    while (!finishesNatively(node, iterations)) {
         if (node->condition != nullptr) {
             Value condition = evaluate(node->condition.get());
             if (!isTruthy(condition)) {
@@ -87,15 +86,9 @@ Value TreeWalker::visit(ForStatement* node) {
             }
         }
 
-        try {
-            evaluate(node->body.get());
-        } catch (const BreakException&) {
+        evaluate(node->body.get());
+        if (exitsLoop()) {
             break;
-        } catch (const ContinueException&) {
-            if (node-> update != nullptr) {
-                evaluate(node->update.get());
-                continue;
-            }
         }
 
         if (node->update != nullptr) {
@@ -106,7 +99,7 @@ Value TreeWalker::visit(ForStatement* node) {
     return Value(Null{});
 }
 Value TreeWalker::visit(ForInStatement* node) {
-    EnvGuard guard(this->env);
+    EnvGuard guard(this->env, &node->scope);
 
     Value collection = evaluate(node->collection.get());
 
@@ -114,14 +107,11 @@ Value TreeWalker::visit(ForInStatement* node) {
         auto iterator = iterable->makeIterator();
         while (iterator->hasNext()) {
 
-            env->define(node->variable->name, iterator->next());
+            defineIdentifier(node->variable.get(), iterator->next());
 
-            try {
-                evaluate(node->body.get());
-            } catch (const BreakException&) {
+            evaluate(node->body.get());
+            if (exitsLoop()) {
                 break;
-            } catch (const ContinueException&) {
-                continue;
             }
         }
     } else {
@@ -131,10 +121,13 @@ Value TreeWalker::visit(ForInStatement* node) {
     return Value(Null{});
 }
 Value TreeWalker::visit(BlockStatement* node) {
-    EnvGuard guard(this->env);
+    EnvGuard guard(this->env, &node->scope);
 
     for (const auto& stmt : node->statements) {
         evaluate(stmt.get());
+        if (isAbrupt()) {
+            break;
+        }
     }
 
     return Value(Null{});
@@ -150,26 +143,26 @@ Value TreeWalker::visit(ClassStatement* node) {
         }
     }
 
-    Class klass = std::make_shared<MeowScriptClass>(node->name->name, superklass);
+    Class klass = makeRef<MeowScriptClass>(node->name->name, superklass);
 
-    env->define(node->name->name, klass);
+    defineIdentifier(node->name.get(), klass);
 
     for (const auto& methodStmt : node->methods) {
         auto letStmt = static_cast<LetStatement*>(methodStmt.get());
         auto funcLiteral = static_cast<FunctionLiteral*>(letStmt->value.get());
         
-        Function function = std::make_shared<MeowScriptFunction>(funcLiteral, env); 
+        Function function = makeRef<MeowScriptFunction>(funcLiteral, env); 
         
-        klass->methods[letStmt->name->name] = function;
+        klass->defineMethod(letStmt->name->name, function);
     }
 
     for (const auto& field : node->static_fields) {
         if (auto letStmt = dynamic_cast<LetStatement*>(field.get())) {
             auto staticValue = evaluate(letStmt->value.get());
-            klass->static_fields[letStmt->name->name] = staticValue;
+            klass->defineStatic(letStmt->name->name, staticValue);
         } else if (auto classStmt = dynamic_cast<ClassStatement*>(field.get())) {
             auto staticValue = evaluate(classStmt);
-            klass->static_fields[classStmt->name->name] = staticValue;
+            klass->defineStatic(classStmt->name->name, staticValue);
         }
     }
 
@@ -188,7 +181,7 @@ Value TreeWalker::visit(ImportStatement* node) {
     auto exportsObj = std::get<Object>(exportsValue);
 
     if (node->namespaceImport) {
-        env->define(node->namespaceImport->name, exportsValue);
+        defineIdentifier(node->namespaceImport.get(), exportsValue);
     } else if (!node->namedImports.empty()) {
         for (const auto& specifier : node->namedImports) {
             std::string name = specifier->name;
@@ -196,7 +189,7 @@ Value TreeWalker::visit(ImportStatement* node) {
             if (it == exportsObj->pairs.end()) {
                 throwRuntimeErr(specifier->token, "Module không export '" + name + "'.");
             }
-            env->define(name, it->second);
+            defineIdentifier(specifier.get(), it->second);
         }
     } else if (node->importAll) {
         for (const auto& pair : exportsObj->pairs) {
@@ -258,11 +251,12 @@ Value TreeWalker::visit(TryStatement* node) {
     } catch (MeowScriptException& e) {
         CaughtExceptionGuard guard(this, e.value);
 
-        auto catchEnv = std::make_shared<Environment>(this->env);
+        auto catchEnv = std::make_shared<Environment>(this->env, &node->catchScope);
 
-        catchEnv->define(node->catchVariable->name, e.value, false);
+        catchEnv->defineAt(node->catchVariable->address.slot, e.value, false);
 
-        this->exec(node->catchBlock.get(), catchEnv);
+        EnvGuard envGuard(this->env, std::move(catchEnv));
+        evaluate(node->catchBlock.get());
     }
 
     return Value(Null{});
@@ -309,12 +303,15 @@ Value TreeWalker::visit(SwitchStatement* node) {
     if (startIdx != -1) {
         for (int i = startIdx; i < node->cases.size(); ++i) {
             const auto& currentCase = node->cases[i];
-            try {
-                for (const auto& stmt : currentCase->statements) {
-                    evaluate(stmt.get());
+            for (const auto& stmt : currentCase->statements) {
+                evaluate(stmt.get());
+                if (completion.type == CompletionType::Break) {
+                    completion.type = CompletionType::Normal;
+                    return Value(Null{});
+                }
+                if (isAbrupt()) {
+                    return Value(Null{});
                 }
-            } catch (const BreakException&) {
-                return Value(Null{}); 
             }
         }
     }
@@ -324,14 +321,11 @@ Value TreeWalker::visit(SwitchStatement* node) {
 
 Value TreeWalker::visit(DoWhileStatement* node) {
     do {
-        try {
-            evaluate(node->body.get());
-        } catch (const ContinueException&) {
-            continue;
-        } catch (const BreakException&) {
+        evaluate(node->body.get());
+        if (exitsLoop()) {
             break;
         }
     } while (isTruthy(evaluate(node->condition.get())));
 
     return Value(Null{});
-}
\ No newline at end of file
+}
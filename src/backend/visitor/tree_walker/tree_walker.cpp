@@ -1,8 +1,11 @@
 #include "native_lib/standard_lib.hpp"
 #include "visitor/tree_walker.hpp"
 #include "common/ast.hpp"
+#include "callable/function_callable.hpp"
 #include "diagnostics/diagnostic.hpp"
+#include "utils/guards.hpp"
 #include <iostream>
+#include <utility>
 #include <variant>
 #include <type_traits>
 #include <sstream>
@@ -36,6 +39,12 @@ TreeWalker::TreeWalker(ModuleManager* manager, SrcFilePtr sourceFile, Value* exp
     initCommon();
 }
 
+void TreeWalker::enableJit() {
+    if (LoopJit::isAvailable()) {
+        jit = std::make_unique<LoopJit>();
+    }
+}
+
 void TreeWalker::loadLibrary(std::unique_ptr<NativeLibrary> library) {
     for (const auto& pair : library->contents) {
         env->define(pair.first, pair.second);
@@ -43,9 +52,6 @@ void TreeWalker::loadLibrary(std::unique_ptr<NativeLibrary> library) {
 }
 
 void TreeWalker::initCommon() {
-    if (!opDispatcher) {
-        opDispatcher = std::make_unique<OperatorDispatcher>();
-    }
     if (!env) {
         env = std::make_shared<Environment>(nullptr);
     }
@@ -55,11 +61,7 @@ void TreeWalker::initCommon() {
 Value interpret(Program* program) {
     TreeWalker treeWalker;
     try {
-        for (auto& stmt : program->body) {
-            treeWalker.evaluate(stmt.get());
-        }
-    } catch (ReturnException& e) {
-        return e.value;
+        return treeWalker.visit(program);
     } catch (MeowScriptException& e) {
         std::cerr << "Lỗi chưa được bắt: " << e.value << "\n";
     } catch (Diagnostic& e) {
@@ -76,30 +78,82 @@ Value TreeWalker::evaluate(ASTNode* node) {
     return node->accept(this);
 }
 
+// Thân hàm kết thúc bằng return f(...) thì f chạy ngay trong vòng lặp này, thay env bằng frame của f:
+// stack C++ không sâu thêm và frame cũ được giải phóng, nên đệ quy đuôi chạy với bộ nhớ cố định
 Value TreeWalker::exec(ASTNode* node, std::shared_ptr<Environment> local) {
-    auto prevEnv = this->env;
-    try {
-        env = local;
-        if (node != nullptr) {
-            evaluate(node);
+    {
+        EnvGuard guard(this->env, std::move(local));
+        runBody(node);
+        while (completion.type == CompletionType::TailCall) {
+            runTailCall();
         }
+    }
+
+    return takeReturnValue();
+}
+
+void TreeWalker::runBody(ASTNode* body) {
+    evaluate(body);
+}
+
+// Lỗi trong hàm được gọi ở vị trí đuôi vẫn mang vị trí của lời gọi đó như lời gọi thường,
+// nhưng những lời gọi đuôi trước nó đã nhường chỗ nên không còn trong call stack
+void TreeWalker::runTailCall() {
+    TailCall call = std::exchange(tailCall, TailCall{});
+    completion.type = CompletionType::Normal;
+    env = std::move(call.frame);
+
+    try {
+        runBody(call.body);
     } catch (...) {
-        env = prevEnv;
-        throw;
+        rethrowAtCallSite(call.site);
     }
+}
 
-    env = prevEnv;
+// Tiêu thụ completion khi thoát khỏi thân hàm hoặc chương trình.
+// break/continue lọt ra tới đây là lỗi, báo giống như khi chúng còn là exception.
+Value TreeWalker::takeReturnValue() {
+    Completion result = std::exchange(completion, Completion{});
+
+    switch (result.type) {
+        case CompletionType::Return:
+            return result.value;
+        case CompletionType::Break:
+            throw std::runtime_error("Break");
+        case CompletionType::Continue:
+            throw std::runtime_error("Continue");
+        default:
+            return Value(Null{});
+    }
+}
 
-    return Value(Null{}); 
+// Gọi sau mỗi lần chạy thân vòng lặp: break/continue được tiêu thụ ở đây,
+// return thì giữ nguyên để truyền tiếp lên trên
+bool TreeWalker::exitsLoop() {
+    switch (completion.type) {
+        case CompletionType::Break:
+            completion.type = CompletionType::Normal;
+            return true;
+        case CompletionType::Continue:
+            completion.type = CompletionType::Normal;
+            return false;
+        case CompletionType::Return:
+        case CompletionType::TailCall:
+            return true;
+        default:
+            return false;
+    }
 }
 
 Value TreeWalker::visit(Program* node) {
     try {
         for (auto& stmt : node->body) {
             this->evaluate(stmt.get());
+            if (isAbrupt()) {
+                break;
+            }
         }
-    } catch (ReturnException& e) {
-        return e.value;
+        return takeReturnValue();
     } catch (Diagnostic& e) {
         std::cerr << e.str() << "\n";
     }
@@ -111,128 +165,188 @@ template <typename T>
 struct is_callable_ptr : std::false_type {};
 
 template <typename U>
-struct is_callable_ptr<std::shared_ptr<U>> : std::is_base_of<Callable, U> {};
+struct is_callable_ptr<Ref<U>> : std::is_base_of<Callable, U> {};
 
 template <typename T>
 inline constexpr bool is_callable_ptr_v = is_callable_ptr<T>::value;
 
-Value TreeWalker::call(const Value& callee, const std::vector<Value>& args) {
+Value TreeWalker::call(const Value& callee, Arguments args) {
     return std::visit([this, &callee, &args](auto&& arg) -> Value {
         using T = std::decay_t<decltype(arg)>;
 
         if constexpr (is_callable_ptr_v<T>) {
             Function callable = arg;
-            
-            const Arity& arity = callable->arity();
-            int argsCount = args.size();
-
-            if (arity.isVariadic) {
-                if (argsCount < arity.required) {
-                    throw FunctionException("Hàm cần ít nhất " + std::to_string(arity.required) + " tham số.");
-                }
-            } else {
-                if (argsCount < arity.required || argsCount > arity.required + arity.optional) {
-                    std::ostringstream os;
-                    os << "Hàm cần từ " + std::to_string(arity.required) + " đến " 
-                                        + std::to_string(arity.required + arity.optional) + " tham số.";
-
-                    os << " Nhưng lại nhận được '" << argsCount << "' tham số. Các tham số đó là: ";
-                    for (const auto& arg : args) {
-                        os << arg << " ";
-                    }
-                    os << ". Và callee là: " << callee << "\n";
-                    throw FunctionException(os.str());
-                }
-            }
-            
+            checkArity(callable->arity(), callee, args);
             return callable->call(this, args);
-
         } else {
-            std::ostringstream os;
-            os << "Đối tượng này không thể gọi được: '" << arg << "' với các tham số là: ";
-            for (const auto& a : args) {
-                os << "'" << a << "'" << " ";
-            }
-            throw FunctionException(os.str());
+            throwNotCallable(callee, args);
         }
     }, callee);
 }
 
-void TreeWalker::execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) {
-    auto prevEnv = this->env;
-    try {
-        this->env = environment;
+// Như call() nhưng tham số nằm trên valueStack của lời gọi này, nên hàm MeowScript
+// được gọi có thể nhận thẳng chúng vào slot mà không phải sao chép
+Value TreeWalker::callFrame(const Value& callee, MutableArguments args) {
+    if (auto function = std::get_if<Function>(&callee)) {
+        if (auto script = dynamic_cast<MeowScriptFunction*>(function->get())) {
+            checkArity(script->arity(), callee, args);
+            return exec(script->declaration->body.get(), script->makeFrame(args));
+        }
+    }
+    return call(callee, args);
+}
+
+Value TreeWalker::execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) {
+    {
+        EnvGuard guard(this->env, std::move(environment));
 
         for (const auto& stmt : block->statements) {
             evaluate(stmt.get());
+            if (isAbrupt()) {
+                break;
+            }
         }
-    } catch (...) {
-        this->env = prevEnv;
-        throw;
     }
 
-    this->env = prevEnv;
+    return takeReturnValue();
+}
+
+void TreeWalker::defineIdentifier(Identifier* name, const Value& value, bool isConstant) {
+    if (name->address.slot >= 0) {
+        env->defineAt(name->address.slot, value, isConstant);
+        return;
+    }
+    env->define(name->name, value, isConstant);
 }
 
 LValue TreeWalker::resolveLValue(ASTNode* node) {
-    if (auto identifier = dynamic_cast<Identifier*>(node)) {
-        return LValue {
-            env->find(identifier->name), 
-            [this, name = identifier->name](const Value& newValue) {
-                this->env->assign(name, newValue);
+    switch (node->type) {
+        case NodeType::EXPR_IDENTIFIER: {
+            auto identifier = static_cast<Identifier*>(node);
+            Environment* target = env.get();
+            if (identifier->address.depth >= 0) {
+                target = env->ancestor(identifier->address.depth);
             }
-        };
-    }
-
-    if (auto indexExpr = dynamic_cast<IndexExpression*>(node)) {
-        Value left = evaluate(indexExpr->left.get());
-        
-        if (Indexable* indexable = toIndexable(left)) {
-            Value index = evaluate(indexExpr->index.get());
-            return LValue {
-                indexable->get(index),
-                [indexable, index](const Value& newValue) {
-                    indexable->set(index, newValue);
-                }
-            };
+            int slot = identifier->address.slot;
+            Variable* variable = slot >= 0 ? target->lookupAt(slot) : lookupVariable(identifier, target);
+
+            LValue lvalue{variable != nullptr ? LValue::Kind::Variable : LValue::Kind::Undeclared};
+            lvalue.variable = variable;
+            lvalue.environment = target;
+            lvalue.identifier = identifier;
+            return lvalue;
         }
-        throwRuntimeErr(indexExpr->token, "Đối tượng không thể truy cập bằng chỉ số.");
-    }
 
-    if (auto propAccess = dynamic_cast<PropertyAccess*>(node)) {
-        Value objectValue = evaluate(propAccess->object.get());
-        Value key = Value(propAccess->property->name);
+        case NodeType::EXPR_INDEX: {
+            auto indexExpr = static_cast<IndexExpression*>(node);
+            Value left = evaluate(indexExpr->left.get());
 
-        return std::visit([&](auto&& arg) -> LValue {
-            using T = std::decay_t<decltype(arg)>;
+            if (toIndexable(left) == nullptr) {
+                throwRuntimeErr(indexExpr->token, "Đối tượng không thể truy cập bằng chỉ số.");
+            }
 
-            if constexpr (std::is_same_v<T, Instance>) {
-                Instance inst = arg;
-                return LValue {
-                    inst->fields->get(key),
-                    [inst, key](const Value& newValue) {
-                        inst->fields->set(key, newValue);
-                    }
-                };
+            LValue lvalue{LValue::Kind::Element};
+            lvalue.container = std::move(left);
+            lvalue.key = evaluate(indexExpr->index.get());
+            return lvalue;
+        }
+
+        case NodeType::EXPR_PROPERTY_ACCESS: {
+            auto propAccess = static_cast<PropertyAccess*>(node);
+            Value objectValue = evaluate(propAccess->object.get());
+
+            if (std::holds_alternative<Instance>(objectValue)) {
+                LValue lvalue{LValue::Kind::Field};
+                lvalue.container = std::move(objectValue);
+                lvalue.access = propAccess;
+                return lvalue;
             }
-            else if constexpr (std::is_same_v<T, Object> || std::is_same_v<T, Array>) {
-                if (Indexable* indexable = toIndexable(objectValue)) {
-                     return LValue {
-                        indexable->get(key),
-                        [indexable, key](const Value& newValue) {
-                            indexable->set(key, newValue);
-                        }
-                    };
-                }
+            if (std::holds_alternative<Object>(objectValue) || std::holds_alternative<Array>(objectValue)) {
+                LValue lvalue{LValue::Kind::Element};
+                lvalue.container = std::move(objectValue);
+                lvalue.key = Value(propAccess->key);
+                return lvalue;
             }
-            
+
             throwRuntimeErr(propAccess->token, "Không thể gán thuộc tính cho kiểu dữ liệu này.");
-            return LValue{};
+            break;
+        }
 
-        }, objectValue);
+        default:
+            break;
     }
 
     throwRuntimeErr(node->token, "Biểu thức không hợp lệ ở vế trái của phép gán.");
 
-    return LValue{};
+    return LValue(LValue::Kind::Undeclared);
+}
+
+Value TreeWalker::readLValue(const LValue& target) {
+    switch (target.kind) {
+        case LValue::Kind::Variable:
+            return target.variable->value;
+        case LValue::Kind::Undeclared:
+            return Value(Null{});
+        case LValue::Kind::Element:
+            return toIndexable(target.container)->get(target.key);
+        case LValue::Kind::Field:
+            return target.access->cache.getField(std::get<Instance>(target.container).get(), target.access->key);
+    }
+    return Value(Null{});
+}
+
+void TreeWalker::writeLValue(const LValue& target, const Value& value) {
+    switch (target.kind) {
+        case LValue::Kind::Variable:
+            Environment::assignVariable(*target.variable, target.identifier->name, value);
+            return;
+        case LValue::Kind::Undeclared:
+            if (int slot = target.identifier->address.slot; slot >= 0) {
+                target.environment->assignAt(slot, value);
+            } else {
+                target.environment->assign(target.identifier->name, value);
+            }
+            return;
+        case LValue::Kind::Element:
+            if (Value* storage = lvalueStorage(target)) {
+                *storage = value;
+            } else {
+                toIndexable(target.container)->set(target.key, value);
+            }
+            return;
+        case LValue::Kind::Field:
+            target.access->cache.setField(std::get<Instance>(target.container).get(), target.access->key, value);
+            return;
+    }
+}
+
+// Ô đang giữ giá trị của lvalue để đọc/ghi thẳng, nullptr nếu phải đi qua writeLValue
+// (hằng số, biến chưa khai báo, chỉ số ngoài phạm vi, key chưa có, __setitem__...)
+Value* TreeWalker::lvalueStorage(const LValue& target) {
+    switch (target.kind) {
+        case LValue::Kind::Variable:
+            return target.variable->isConstant ? nullptr : &target.variable->value;
+        case LValue::Kind::Undeclared:
+            return nullptr;
+        case LValue::Kind::Element:
+            if (auto array = std::get_if<Array>(&target.container)) {
+                if (auto index = std::get_if<Int>(&target.key)) {
+                    auto& elements = (*array)->elements;
+                    if (*index >= 0 && static_cast<size_t>(*index) < elements.size()) {
+                        return &elements[*index];
+                    }
+                }
+            } else if (auto object = std::get_if<Object>(&target.container)) {
+                if (isHashable(target.key)) {
+                    auto it = (*object)->pairs.find(HashKey{target.key});
+                    if (it != (*object)->pairs.end()) {
+                        return &it->second;
+                    }
+                }
+            }
+            return nullptr;
+        case LValue::Kind::Field:
+            return target.access->cache.fieldSlot(std::get<Instance>(target.container).get(), target.access->key);
+    }
+    return nullptr;
 }
@@ -0,0 +1,29 @@
+#include "vm/chunk.hpp"
+#include <array>
+
+namespace {
+    constexpr std::array<std::string_view, static_cast<size_t>(OpCode::_TOTAL_OPCODES)> opCodeNames = {
+        "PUSH_CONST", "PUSH_NULL", "PUSH_TRUE", "PUSH_FALSE", "POP", "DUP", "DUP2",
+        "LOAD_NAME", "STORE_NAME", "DEFINE_NAME", "LOAD_THIS",
+        "LOAD_SLOT", "STORE_SLOT", "DEFINE_SLOT",
+        "PUSH_SCOPE", "POP_SCOPE",
+        "BINARY", "UNARY", "COMPOUND", "CASE_EQ",
+        "JUMP", "JUMP_IF_FALSE", "JUMP_IF_TRUE", "JUMP_IF_FALSE_KEEP", "JUMP_IF_TRUE_KEEP", "JUMP_IF_NOT_NULL_KEEP",
+        "CALL", "CALL_ARRAY", "GET_METHOD", "CALL_METHOD", "RETURN",
+        "MAKE_ARRAY", "ARRAY_APPEND", "ARRAY_SPREAD", "MAKE_OBJECT", "MAKE_TEMPLATE", "CLOSURE",
+        "GET_INDEX", "SET_INDEX", "GET_PROP", "GET_FIELD", "SET_PROP",
+        "UPDATE_NAME", "UPDATE_SLOT", "UPDATE_INDEX", "UPDATE_PROP", "SUPER",
+        "GET_ITER", "FOR_ITER", "END_ITER",
+        "TRY_BEGIN", "TRY_END", "SET_CAUGHT", "CLEAR_CAUGHT", "THROW", "RETHROW", "THROW_BREAK", "THROW_CONTINUE",
+        "CLASS", "METHOD", "SET_STATIC", "IMPORT", "EXPORT_CHECK", "EXPORT_NAME",
+        "LOG", "RAISE", "HALT",
+    };
+}
+
+std::string_view opCodeName(OpCode op) {
+    size_t index = static_cast<size_t>(op);
+    if (index >= opCodeNames.size()) {
+        return "UNKNOWN";
+    }
+    return opCodeNames[index];
+}
@@ -0,0 +1,607 @@
+#include "vm/virtual_machine.hpp"
+#include "callable/function_callable.hpp"
+#include "diagnostics/meow_exceptions.hpp"
+#include "common/ast.hpp"
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Môi trường đích theo độ sâu Resolver đã ghi vào lệnh, 0 nghĩa là chưa phân giải
+    Environment* scopeAt(const std::shared_ptr<Environment>& env, uint16_t encodedDepth) {
+        if (encodedDepth == 0) {
+            return env.get();
+        }
+        return env->ancestor(encodedDepth - 1);
+    }
+
+    bool isCall(OpCode op) {
+        return op == OpCode::CALL || op == OpCode::CALL_ARRAY || op == OpCode::CALL_METHOD;
+    }
+
+    Value updatedValue(const Value& current, uint16_t flags, const Token& token) {
+        if (!std::holds_alternative<Int>(current)) {
+            throw Diagnostic::RuntimeErr("Toán tử ++/-- chỉ dùng cho số nguyên.", token);
+        }
+        return std::get<Int>(current) + ((flags & UPDATE_DECREMENT) ? -1 : 1);
+    }
+}
+
+Value VirtualMachine::run(const Chunk& chunk, std::shared_ptr<Environment> local, bool& returned) {
+    // Trạng thái của lần chạy này nằm trên các ngăn xếp dùng chung của VM,
+    // FrameGuard trả chúng về như cũ dù thoát bình thường hay do ngoại lệ
+    struct FrameGuard {
+        VirtualMachine* vm;
+        std::shared_ptr<Environment> prevEnv;
+        size_t stackBase, scopeBase, handlerBase, iteratorBase;
+
+        ~FrameGuard() {
+            vm->stack.resize(stackBase);
+            vm->scopes.resize(scopeBase);
+            vm->handlers.resize(handlerBase);
+            vm->iterators.resize(iteratorBase);
+            vm->env = std::move(prevEnv);
+        }
+    } guard{this, std::move(env), stack.size(), scopes.size(), handlers.size(), iterators.size()};
+
+    env = std::move(local);
+
+    const Instruction* code = chunk.code.data();
+    size_t pc = 0;
+
+    auto pop = [this]() {
+        Value value = std::move(stack.back());
+        stack.pop_back();
+        return value;
+    };
+
+    auto tokenAt = [&chunk](size_t at) -> const Token& {
+        return chunk.nodes[at]->token;
+    };
+
+    returned = false;
+
+    for (;;) {
+        try {
+            for (;;) {
+                const Instruction& ins = code[pc++];
+
+                switch (ins.op) {
+                    case OpCode::PUSH_CONST:
+                        stack.push_back(chunk.constants[ins.a]);
+                        break;
+                    case OpCode::PUSH_NULL:
+                        stack.emplace_back(Null{});
+                        break;
+                    case OpCode::PUSH_TRUE:
+                        stack.emplace_back(true);
+                        break;
+                    case OpCode::PUSH_FALSE:
+                        stack.emplace_back(false);
+                        break;
+                    case OpCode::POP:
+                        stack.pop_back();
+                        break;
+                    case OpCode::DUP: {
+                        Value top = stack.back();
+                        stack.push_back(std::move(top));
+                        break;
+                    }
+                    case OpCode::DUP2: {
+                        Value first = stack[stack.size() - 2];
+                        Value second = stack.back();
+                        stack.push_back(std::move(first));
+                        stack.push_back(std::move(second));
+                        break;
+                    }
+
+                    case OpCode::LOAD_NAME:
+                        stack.push_back(scopeAt(env, ins.b)->find(chunk.names[ins.a]));
+                        break;
+                    case OpCode::STORE_NAME:
+                        scopeAt(env, ins.b)->assign(chunk.names[ins.a], stack.back());
+                        break;
+                    case OpCode::DEFINE_NAME:
+                        env->define(chunk.names[ins.a], pop(), ins.b != 0);
+                        break;
+                    case OpCode::LOAD_THIS:
+                        stack.push_back(scopeAt(env, ins.b)->find("this"));
+                        break;
+
+                    case OpCode::LOAD_SLOT:
+                        stack.push_back(env->ancestor(ins.b)->findAt(ins.a));
+                        break;
+                    case OpCode::STORE_SLOT:
+                        env->ancestor(ins.b)->assignAt(ins.a, stack.back());
+                        break;
+                    case OpCode::DEFINE_SLOT:
+                        env->defineAt(ins.a, pop(), ins.b != 0);
+                        break;
+
+                    case OpCode::PUSH_SCOPE:
+                        scopes.push_back(env);
+                        env = std::make_shared<Environment>(env, chunk.layouts[ins.a]);
+                        break;
+                    case OpCode::POP_SCOPE:
+                        env = std::move(scopes.back());
+                        scopes.pop_back();
+                        break;
+
+                    case OpCode::BINARY:
+                    case OpCode::COMPOUND: {
+                        Value right = pop();
+                        Value left = pop();
+                        TokenType op = static_cast<TokenType>(ins.b);
+
+                        Value result;
+                        if (fastBinary(op, left, right, result)) {
+                            stack.push_back(std::move(result));
+                            break;
+                        }
+
+                        BinaryOpFunction opFunc = opDispatcher->find(op, left, right);
+                        if (opFunc == nullptr) {
+                            const Token& token = tokenAt(pc - 1);
+                            std::ostringstream os;
+                            if (ins.op == OpCode::COMPOUND) {
+                                os << "Không thể thực hiện phép toán gán kép '" << token.lexeme()
+                                   << "' với '" << left << "' và '" << right << "'.";
+                                throwRuntimeErr(token, os.str());
+                            }
+                            os << "Toán tử hai ngôi '" << token.lexeme() << "' không hợp lệ cho phép toán với vế trái: '" << left << "' và right: '" << right << "'\n";
+                            throwRuntimeErr(token, Diagnostic::RuntimeErr(os.str(), token).str());
+                        }
+                        stack.push_back(opFunc(left, right));
+                        break;
+                    }
+                    case OpCode::UNARY: {
+                        Value right = pop();
+
+                        UnaryOpFunction opFunc = opDispatcher->find(static_cast<TokenType>(ins.b), right);
+                        if (opFunc == nullptr) {
+                            const Token& token = tokenAt(pc - 1);
+                            std::ostringstream os;
+                            os << "Toán tử một ngôi '" << token.lexeme() << "' không hợp lệ cho phép toán này: '" << right << "'\n";
+                            throwRuntimeErr(token, Diagnostic::RuntimeErr(os.str(), token).str());
+                        }
+                        stack.push_back(opFunc(right));
+                        break;
+                    }
+                    case OpCode::CASE_EQ: {
+                        Value right = pop();
+                        Value left = pop();
+                        stack.emplace_back(left == right);
+                        break;
+                    }
+
+                    case OpCode::JUMP:
+                        pc = ins.a;
+                        break;
+                    case OpCode::JUMP_IF_FALSE:
+                        if (!isTruthy(pop())) pc = ins.a;
+                        break;
+                    case OpCode::JUMP_IF_TRUE:
+                        if (isTruthy(pop())) pc = ins.a;
+                        break;
+                    case OpCode::JUMP_IF_FALSE_KEEP:
+                        if (!isTruthy(stack.back())) pc = ins.a;
+                        else stack.pop_back();
+                        break;
+                    case OpCode::JUMP_IF_TRUE_KEEP:
+                        if (isTruthy(stack.back())) pc = ins.a;
+                        else stack.pop_back();
+                        break;
+                    case OpCode::JUMP_IF_NOT_NULL_KEEP:
+                        if (!std::holds_alternative<Null>(stack.back())) pc = ins.a;
+                        else stack.pop_back();
+                        break;
+
+                    case OpCode::CALL: {
+                        size_t argc = ins.a;
+                        ValueStack::Frame frame(valueStack, argc);
+                        for (auto it = stack.end() - argc; it != stack.end(); ++it) {
+                            frame.push(std::move(*it));
+                        }
+                        stack.resize(stack.size() - argc);
+                        Value callee = pop();
+
+                        stack.push_back(callFrame(callee, frame.arguments()));
+                        break;
+                    }
+                    case OpCode::CALL_ARRAY: {
+                        Value argArray = pop();
+                        Value callee = pop();
+
+                        stack.push_back(call(callee, std::get<Array>(argArray)->elements));
+                        break;
+                    }
+                    case OpCode::GET_METHOD: {
+                        Value receiver = pop();
+                        const Value& key = chunk.nameValues[ins.a];
+                        PropertyCache* cache = ins.b != NO_PROPERTY_CACHE ? &chunk.propertyCaches[ins.b] : nullptr;
+
+                        Function method = cache != nullptr ? cache->findMethod(receiver, std::get<String>(key)) : nullptr;
+                        if (method != nullptr) {
+                            stack.emplace_back(std::move(method));
+                            stack.push_back(std::move(receiver));
+                        } else {
+                            stack.push_back(getProperty(receiver, key, cache, tokenAt(pc - 1)));
+                            stack.emplace_back(Null{});
+                        }
+                        break;
+                    }
+                    case OpCode::CALL_METHOD: {
+                        size_t argc = ins.b;
+                        size_t base = stack.size() - argc - 2;
+                        Value callee = std::move(stack[base]);
+                        Value receiver = std::move(stack[base + 1]);
+
+                        // Hàm thư viện nhận receiver ở tham số đầu tiên
+                        bool passesReceiver = !std::holds_alternative<Null>(receiver) && !std::holds_alternative<Instance>(receiver);
+                        ValueStack::Frame frame(valueStack, argc + (passesReceiver ? 1 : 0));
+                        if (passesReceiver) {
+                            frame.push(receiver);
+                        }
+                        for (auto it = stack.begin() + base + 2; it != stack.end(); ++it) {
+                            frame.push(std::move(*it));
+                        }
+                        stack.resize(base);
+                        MutableArguments args = frame.arguments();
+
+                        if (std::holds_alternative<Null>(receiver)) {
+                            stack.push_back(callFrame(callee, args));
+                            break;
+                        }
+
+                        const Function& method = std::get<Function>(callee);
+                        Arity arity = passesReceiver ? method->arity().withoutReceiver() : method->arity();
+                        if (arity.accepts(static_cast<int>(argc))) {
+                            stack.push_back(callMethod(receiver, method, args));
+                            break;
+                        }
+
+                        // Sai số tham số: dựng lại bound method và đi đường thường để thông báo lỗi giữ nguyên như cũ
+                        if (passesReceiver) {
+                            args = args.subspan(1);
+                        }
+                        stack.push_back(call(getProperty(receiver, chunk.nameValues[ins.a], nullptr, tokenAt(pc - 1)), args));
+                        break;
+                    }
+                    case OpCode::RETURN:
+                        returned = true;
+                        return pop();
+
+                    case OpCode::MAKE_ARRAY: {
+                        auto data = makeRef<ArrayData>();
+                        size_t count = ins.a;
+                        data->elements.assign(std::make_move_iterator(stack.end() - count), std::make_move_iterator(stack.end()));
+                        stack.resize(stack.size() - count);
+                        stack.emplace_back(Array(data));
+                        break;
+                    }
+                    case OpCode::ARRAY_APPEND: {
+                        Value element = pop();
+                        std::get<Array>(stack.back())->elements.push_back(std::move(element));
+                        break;
+                    }
+                    case OpCode::ARRAY_SPREAD: {
+                        Value collection = pop();
+                        Iterable* iterable = toIterable(collection);
+                        if (iterable == nullptr) {
+                            throwRuntimeErr(tokenAt(pc - 1), "Toán tử '...' chỉ có thể dùng với các kiểu có thể duyệt qua (iterable).");
+                        }
+                        Array target = std::get<Array>(stack.back());
+                        auto iterator = iterable->makeIterator();
+                        while (iterator->hasNext()) {
+                            target->elements.push_back(iterator->next());
+                        }
+                        break;
+                    }
+                    case OpCode::MAKE_OBJECT: {
+                        auto obj = makeRef<ObjectData>();
+                        size_t base = stack.size() - 2 * ins.a;
+                        for (size_t i = base; i < stack.size(); i += 2) {
+                            obj->pairs[HashKey{stack[i]}] = stack[i + 1];
+                        }
+                        stack.resize(base);
+                        stack.emplace_back(Object(obj));
+                        break;
+                    }
+                    case OpCode::MAKE_TEMPLATE: {
+                        std::ostringstream os;
+                        size_t base = stack.size() - ins.a;
+                        for (size_t i = base; i < stack.size(); ++i) {
+                            os << toString(stack[i]);
+                        }
+                        stack.resize(base);
+                        stack.emplace_back(os.str());
+                        break;
+                    }
+                    case OpCode::CLOSURE: {
+                        Function function = makeRef<MeowScriptFunction>(static_cast<FunctionLiteral*>(chunk.children[ins.a]), env);
+                        stack.emplace_back(function);
+                        break;
+                    }
+
+                    case OpCode::GET_INDEX: {
+                        Value index = pop();
+                        Value left = pop();
+
+                        if (Indexable* indexable = toIndexable(left)) {
+                            stack.push_back(indexable->get(index));
+                            break;
+                        }
+
+                        const Token& token = tokenAt(pc - 1);
+                        std::ostringstream os;
+                        os << "Chỉ có thể truy cập phần tử của Mảng hoặc Object: '" << left << "' và index: '" << index << "'";
+                        throw Diagnostic::RuntimeErr(Diagnostic::RuntimeErr(os.str(), token).str(), token);
+                    }
+                    case OpCode::SET_INDEX: {
+                        Value value = pop();
+                        Value index = pop();
+                        Value left = pop();
+
+                        Indexable* indexable = toIndexable(left);
+                        if (indexable == nullptr) {
+                            throwRuntimeErr(tokenAt(pc - 1), "Đối tượng không thể truy cập bằng chỉ số.");
+                        }
+                        indexable->set(index, value);
+                        stack.push_back(std::move(value));
+                        break;
+                    }
+                    case OpCode::GET_PROP: {
+                        Value object = pop();
+                        PropertyCache* cache = ins.b != NO_PROPERTY_CACHE ? &chunk.propertyCaches[ins.b] : nullptr;
+                        stack.push_back(getProperty(object, chunk.nameValues[ins.a], cache, tokenAt(pc - 1)));
+                        break;
+                    }
+                    case OpCode::GET_FIELD: {
+                        Value object = pop();
+                        const Value& key = chunk.nameValues[ins.a];
+
+                        if (auto inst = std::get_if<Instance>(&object)) {
+                            if (ins.b != NO_PROPERTY_CACHE) {
+                                stack.push_back(chunk.propertyCaches[ins.b].getField(inst->get(), std::get<String>(key)));
+                            } else {
+                                stack.push_back((*inst)->getField(key));
+                            }
+                        } else if (std::holds_alternative<Object>(object) || std::holds_alternative<Array>(object)) {
+                            stack.push_back(toIndexable(object)->get(key));
+                        } else {
+                            throwRuntimeErr(tokenAt(pc - 1), "Không thể gán thuộc tính cho kiểu dữ liệu này.");
+                        }
+                        break;
+                    }
+                    case OpCode::SET_PROP: {
+                        Value value = pop();
+                        Value object = pop();
+                        const Value& key = chunk.nameValues[ins.a];
+
+                        if (auto inst = std::get_if<Instance>(&object)) {
+                            if (ins.b != NO_PROPERTY_CACHE) {
+                                chunk.propertyCaches[ins.b].setField(inst->get(), std::get<String>(key), value);
+                            } else {
+                                (*inst)->setField(key, value);
+                            }
+                        } else if (std::holds_alternative<Object>(object) || std::holds_alternative<Array>(object)) {
+                            toIndexable(object)->set(key, value);
+                        } else {
+                            throwRuntimeErr(tokenAt(pc - 1), "Không thể gán thuộc tính cho kiểu dữ liệu này.");
+                        }
+                        stack.push_back(std::move(value));
+                        break;
+                    }
+                    case OpCode::UPDATE_NAME: {
+                        const std::string& name = chunk.names[ins.a];
+                        Environment* target = scopeAt(env, ins.b >> UPDATE_DEPTH_SHIFT);
+                        Value current = target->find(name);
+                        Value newValue = updatedValue(current, ins.b, tokenAt(pc - 1));
+                        target->assign(name, newValue);
+                        stack.push_back((ins.b & UPDATE_POSTFIX) ? std::move(current) : std::move(newValue));
+                        break;
+                    }
+                    case OpCode::UPDATE_SLOT: {
+                        Environment* target = env->ancestor(ins.b >> UPDATE_DEPTH_SHIFT);
+                        Value current = target->findAt(ins.a);
+                        Value newValue = updatedValue(current, ins.b, tokenAt(pc - 1));
+                        target->assignAt(ins.a, newValue);
+                        stack.push_back((ins.b & UPDATE_POSTFIX) ? std::move(current) : std::move(newValue));
+                        break;
+                    }
+                    case OpCode::UPDATE_INDEX: {
+                        Value index = pop();
+                        Value left = pop();
+
+                        Indexable* indexable = toIndexable(left);
+                        if (indexable == nullptr) {
+                            throwRuntimeErr(tokenAt(pc - 1), "Đối tượng không thể truy cập bằng chỉ số.");
+                        }
+                        Value current = indexable->get(index);
+                        Value newValue = updatedValue(current, ins.b, tokenAt(pc - 1));
+                        indexable->set(index, newValue);
+                        stack.push_back((ins.b & UPDATE_POSTFIX) ? std::move(current) : std::move(newValue));
+                        break;
+                    }
+                    case OpCode::UPDATE_PROP: {
+                        Value object = pop();
+                        const Value& key = chunk.nameValues[ins.a];
+
+                        Value current;
+                        Value newValue;
+                        if (auto inst = std::get_if<Instance>(&object)) {
+                            current = (*inst)->getField(key);
+                            newValue = updatedValue(current, ins.b, tokenAt(pc - 1));
+                            (*inst)->setField(key, newValue);
+                        } else if (std::holds_alternative<Object>(object) || std::holds_alternative<Array>(object)) {
+                            Indexable* target = toIndexable(object);
+                            current = target->get(key);
+                            newValue = updatedValue(current, ins.b, tokenAt(pc - 1));
+                            target->set(key, newValue);
+                        } else {
+                            throwRuntimeErr(tokenAt(pc - 1), "Không thể gán thuộc tính cho kiểu dữ liệu này.");
+                        }
+                        stack.push_back((ins.b & UPDATE_POSTFIX) ? std::move(current) : std::move(newValue));
+                        break;
+                    }
+                    case OpCode::SUPER: {
+                        auto node = static_cast<SuperExpression*>(chunk.children[ins.a]);
+                        Instance object = std::get<Instance>(env->find("this"));
+
+                        MeowScriptClass* superklass = object->klass->superclass.get();
+                        if (superklass == nullptr) {
+                            throwRuntimeErr(node->token, "Không có lớp cha để gọi 'super'.");
+                        }
+
+                        Function method = nullptr;
+                        if (node->isCallable) {
+                            method = superklass->findMethod("init");
+                        } else if (node->method != nullptr) {
+                            method = superklass->findMethod(node->method->name);
+                        }
+                        if (method == nullptr) {
+                            throwRuntimeErr(node->token, "Không tìm thấy phương thức trên lớp cha.");
+                        }
+
+                        stack.emplace_back(makeRef<MeowScriptBoundMethod>(object, method));
+                        break;
+                    }
+
+                    case OpCode::GET_ITER: {
+                        Value collection = pop();
+                        Iterable* iterable = toIterable(collection);
+                        if (iterable == nullptr) {
+                            throwRuntimeErr(tokenAt(pc - 1), "Kiểu dữ liệu này không thể duyệt qua.");
+                        }
+                        auto iterator = iterable->makeIterator();
+                        iterators.push_back(IteratorState{std::move(collection), std::move(iterator)});
+                        break;
+                    }
+                    case OpCode::FOR_ITER: {
+                        Iterator* iterator = iterators.back().iterator.get();
+                        if (iterator->hasNext()) {
+                            stack.push_back(iterator->next());
+                        } else {
+                            pc = ins.a;
+                        }
+                        break;
+                    }
+                    case OpCode::END_ITER:
+                        iterators.pop_back();
+                        break;
+
+                    case OpCode::TRY_BEGIN:
+                        handlers.push_back(Handler{ins.a, stack.size(), scopes.size(), iterators.size()});
+                        break;
+                    case OpCode::TRY_END:
+                        handlers.pop_back();
+                        break;
+                    case OpCode::SET_CAUGHT:
+                        caughtException = pop();
+                        break;
+                    case OpCode::CLEAR_CAUGHT:
+                        caughtException.reset();
+                        break;
+                    case OpCode::THROW:
+                        throw MeowScriptException(pop());
+                    case OpCode::RETHROW:
+                        if (!caughtException.has_value()) {
+                            throwRuntimeErr(tokenAt(pc - 1), "Bạn dùng lệnh 'throw' ở đâu thế này, không ở trong khối 'catch' à?");
+                        }
+                        throw MeowScriptException(caughtException.value());
+                    case OpCode::THROW_BREAK:
+                        throw std::runtime_error("Break");
+                    case OpCode::THROW_CONTINUE:
+                        throw std::runtime_error("Continue");
+
+                    case OpCode::CLASS: {
+                        auto node = static_cast<ClassStatement*>(chunk.children[ins.a]);
+
+                        Class superklass = nullptr;
+                        if (ins.b != 0) {
+                            Value superVal = pop();
+                            if (auto cls = std::get_if<Class>(&superVal)) {
+                                superklass = *cls;
+                            } else {
+                                throwRuntimeErr(node->superclass->token, "Class cha không phải là một class.");
+                            }
+                        }
+
+                        Class klass = makeRef<MeowScriptClass>(node->name->name, superklass);
+                        defineIdentifier(node->name.get(), klass);
+                        stack.emplace_back(klass);
+                        break;
+                    }
+                    case OpCode::METHOD: {
+                        Function function = makeRef<MeowScriptFunction>(static_cast<FunctionLiteral*>(chunk.children[ins.a]), env);
+                        std::get<Class>(stack.back())->defineMethod(chunk.names[ins.b], function);
+                        break;
+                    }
+                    case OpCode::SET_STATIC: {
+                        Value value = pop();
+                        std::get<Class>(stack.back())->defineStatic(chunk.names[ins.a], value);
+                        break;
+                    }
+                    case OpCode::IMPORT:
+                        importModule(static_cast<ImportStatement*>(chunk.children[ins.a]), pop());
+                        break;
+                    case OpCode::EXPORT_CHECK:
+                        if (!isModuleContext) {
+                            throwRuntimeErr(tokenAt(pc - 1), "Không thể dùng 'export' trong file chính hoặc eval ngoài module.");
+                        }
+                        break;
+                    case OpCode::EXPORT_NAME:
+                        addToExports(chunk.names[ins.a], env->find(chunk.names[ins.a]));
+                        break;
+
+                    case OpCode::LOG:
+                        std::cout << pop();
+                        break;
+                    case OpCode::RAISE:
+                        throwRuntimeErr(tokenAt(pc - 1), std::get<String>(chunk.constants[ins.a])->str);
+                        break;
+                    case OpCode::HALT:
+                        return Value(Null{});
+
+                    default:
+                        throwRuntimeErr(tokenAt(pc - 1), "Lệnh bytecode không hợp lệ: " + std::string(opCodeName(ins.op)));
+                }
+            }
+        } catch (MeowScriptException& e) {
+            if (const ASTNode* site = chunk.errorSites[pc - 1]) {
+                throw Diagnostic::RuntimeErr(e.what(), site->token);
+            }
+            if (handlers.size() == guard.handlerBase) {
+                throw;
+            }
+
+            Handler handler = handlers.back();
+            handlers.pop_back();
+
+            stack.resize(handler.stackSize);
+            if (scopes.size() > handler.scopeDepth) {
+                env = scopes[handler.scopeDepth];
+                scopes.resize(handler.scopeDepth);
+            }
+            iterators.resize(handler.iteratorDepth);
+
+            stack.push_back(e.value);
+            pc = handler.target;
+        } catch (Diagnostic& e) {
+            const ASTNode* site = chunk.errorSites[pc - 1];
+            // Lời gọi nằm trong một phép gán thì phép gán đó bọc lại lỗi như mọi lệnh khác
+            if (isCall(code[pc - 1].op) && site == chunk.nodes[pc - 1]) {
+                throw e.withCallSite(tokenAt(pc - 1));
+            }
+            if (site != nullptr) {
+                throw Diagnostic::RuntimeErr(e.what(), site->token);
+            }
+            throw;
+        } catch (std::runtime_error& e) {
+            // FunctionException và lỗi từ hàm native: bọc tại node gần nhất như TreeWalker
+            if (const ASTNode* site = chunk.errorSites[pc - 1]) {
+                throw Diagnostic::RuntimeErr(e.what(), site->token);
+            }
+            throw;
+        }
+    }
+}
@@ -0,0 +1,215 @@
+#include "vm/virtual_machine.hpp"
+#include "visitor/bytecode_compiler.hpp"
+#include "callable/function_callable.hpp"
+#include "diagnostics/meow_exceptions.hpp"
+#include "common/ast.hpp"
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+
+VirtualMachine::VirtualMachine()
+    : env(std::make_shared<Environment>(nullptr)),
+        globalEnv(env),
+        ownedCache(std::make_unique<ChunkCache>()) {
+    cache = ownedCache.get();
+    initCommon();
+}
+
+VirtualMachine::VirtualMachine(ModuleManager* manager, SrcFilePtr sourceFile, Value* exp, const std::vector<std::string>& a, ChunkCache* sharedCache)
+    : env(std::make_shared<Environment>(nullptr)),
+        globalEnv(env),
+        moduleManager(manager),
+        currSrcFile(std::move(sourceFile)),
+        currModuleExports(exp),
+        argv(a),
+        cache(sharedCache) {
+    if (cache == nullptr) {
+        ownedCache = std::make_unique<ChunkCache>();
+        cache = ownedCache.get();
+    }
+    initCommon();
+}
+
+void VirtualMachine::loadLibrary(std::unique_ptr<NativeLibrary> library) {
+    for (const auto& pair : library->contents) {
+        env->define(pair.first, pair.second);
+    }
+}
+
+void VirtualMachine::initCommon() {
+    stack.reserve(256);
+    loadLibrary(std::make_unique<CoreLib>());
+}
+
+const Chunk& VirtualMachine::bodyChunk(ASTNode* body) {
+    auto& slot = cache->bodies[body];
+    if (!slot) {
+        slot = BytecodeCompiler().compileBody(body);
+    }
+    return *slot;
+}
+
+const Chunk& VirtualMachine::blockChunk(BlockStatement* block) {
+    auto& slot = cache->blocks[block];
+    if (!slot) {
+        slot = BytecodeCompiler().compileBlock(block);
+    }
+    return *slot;
+}
+
+Value VirtualMachine::runProgram(Program* program) {
+    auto chunk = BytecodeCompiler().compileProgram(program);
+
+    try {
+        bool returned = false;
+        return run(*chunk, env, returned);
+    } catch (Diagnostic& e) {
+        std::cerr << e.str() << "\n";
+    }
+
+    return Value(Null{});
+}
+
+Value VirtualMachine::exec(ASTNode* node, std::shared_ptr<Environment> local) {
+    if (node == nullptr) {
+        return Value(Null{});
+    }
+
+    bool returned = false;
+    Value result = run(bodyChunk(node), std::move(local), returned);
+
+    return returned ? result : Value(Null{});
+}
+
+Value VirtualMachine::execBlock(BlockStatement* block, std::shared_ptr<Environment> environment) {
+    bool returned = false;
+    Value result = run(blockChunk(block), std::move(environment), returned);
+
+    return returned ? result : Value(Null{});
+}
+
+// Chạy thân hàm trong môi trường đã dựng bằng MeowScriptFunction::makeFrame
+Value VirtualMachine::invoke(MeowScriptFunction* function, std::shared_ptr<Environment> frame) {
+    bool returned = false;
+    return run(bodyChunk(function->declaration->body.get()), std::move(frame), returned);
+}
+
+// Gọi phương thức do GET_METHOD tìm được; với hàm thư viện receiver đã nằm ở args[0]
+Value VirtualMachine::callMethod(const Value& receiver, const Function& method, MutableArguments args) {
+    if (std::holds_alternative<Instance>(receiver)) {
+        if (auto function = dynamic_cast<MeowScriptFunction*>(method.get())) {
+            return invoke(function, function->makeFrame(args, &receiver));
+        }
+    }
+    return method->call(this, args);
+}
+
+// Như call() nhưng tham số nằm trên valueStack của lời gọi này, hàm MeowScript nhận thẳng chúng vào slot
+Value VirtualMachine::callFrame(const Value& callee, MutableArguments args) {
+    if (auto callable = std::get_if<Function>(&callee)) {
+        if (auto function = dynamic_cast<MeowScriptFunction*>(callable->get())) {
+            checkArity(function->arity(), callee, args);
+            return invoke(function, function->makeFrame(args));
+        }
+    }
+    return call(callee, args);
+}
+
+Value VirtualMachine::getProperty(const Value& object, const Value& key, PropertyCache* cache, const Token& token) {
+    if (cache != nullptr) {
+        const String& name = std::get<String>(key);
+        if (auto inst = std::get_if<Instance>(&object)) {
+            return cache->get(inst->get(), name);
+        }
+        if (auto klass = std::get_if<Class>(&object)) {
+            return cache->get(klass->get(), name);
+        }
+    }
+
+    if (Indexable* indexable = toIndexable(object)) {
+        return indexable->get(key);
+    }
+
+    std::ostringstream os;
+    os << "Chỉ có thể truy cập thuộc tính của Object: '" << object << "'!";
+    throw Diagnostic::RuntimeErr(Diagnostic::RuntimeErr(os.str(), token).str(), token);
+}
+
+template <typename T>
+struct is_vm_callable_ptr : std::false_type {};
+
+template <typename U>
+struct is_vm_callable_ptr<Ref<U>> : std::is_base_of<Callable, U> {};
+
+Value VirtualMachine::call(const Value& callee, Arguments args) {
+    return std::visit([this, &callee, &args](auto&& arg) -> Value {
+        using T = std::decay_t<decltype(arg)>;
+
+        if constexpr (is_vm_callable_ptr<T>::value) {
+            Function callable = arg;
+            checkArity(callable->arity(), callee, args);
+
+            // Hàm viết bằng MeowScript chạy thẳng trong VM, không cần đi qua Callable::call
+            if constexpr (std::is_same_v<T, Function>) {
+                if (auto function = dynamic_cast<MeowScriptFunction*>(arg.get())) {
+                    return invoke(function, function->makeFrame(args));
+                }
+            } else if constexpr (std::is_same_v<T, BoundMethod>) {
+                if (auto function = dynamic_cast<MeowScriptFunction*>(arg->function.get())) {
+                    Value self = arg->instance;
+                    return invoke(function, function->makeFrame(args, &self));
+                }
+            }
+
+            return callable->call(this, args);
+        } else {
+            throwNotCallable(callee, args);
+        }
+    }, callee);
+}
+
+void VirtualMachine::importModule(ImportStatement* node, const Value& pathValue) {
+    if (!std::holds_alternative<String>(pathValue)) {
+        throwRuntimeErr(node->token, "Đường dẫn phải là chuỗi chứ bạn!");
+    }
+    std::string importPath = std::get<String>(pathValue)->str;
+    std::string currentPath = currSrcFile->name();
+
+    Value exportsValue = moduleManager->load(currentPath, importPath);
+    auto exportsObj = std::get<Object>(exportsValue);
+
+    if (node->namespaceImport) {
+        defineIdentifier(node->namespaceImport.get(), exportsValue);
+    } else if (!node->namedImports.empty()) {
+        for (const auto& specifier : node->namedImports) {
+            std::string name = specifier->name;
+            auto it = exportsObj->pairs.find(HashKey{Value(name)});
+            if (it == exportsObj->pairs.end()) {
+                throwRuntimeErr(specifier->token, "Module không export '" + name + "'.");
+            }
+            defineIdentifier(specifier.get(), it->second);
+        }
+    } else if (node->importAll) {
+        for (const auto& pair : exportsObj->pairs) {
+            if (std::holds_alternative<String>(pair.first.value)) {
+                std::string name = std::get<String>(pair.first.value)->str;
+                env->define(name, pair.second);
+            }
+        }
+    }
+}
+
+void VirtualMachine::defineIdentifier(Identifier* name, const Value& value, bool isConstant) {
+    if (name->address.slot >= 0) {
+        env->defineAt(name->address.slot, value, isConstant);
+        return;
+    }
+    env->define(name->name, value, isConstant);
+}
+
+void VirtualMachine::addToExports(const std::string& name, const Value& value) {
+    if (currModuleExports && std::holds_alternative<Object>(*currModuleExports)) {
+        auto exportsObj = std::get<Object>(*currModuleExports);
+        exportsObj->pairs[HashKey{Value(name)}] = value;
+    }
+}
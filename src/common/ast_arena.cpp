@@ -0,0 +1,20 @@
+#include "common/ast_arena.hpp"
+
+// Khối hiện tại hết chỗ: mở khối mới. Node lớn hơn cả một khối (hiếm) được cấp khối riêng vừa đủ,
+// khối đang dùng dở vẫn giữ làm khối hiện tại.
+void* AstArena::allocateSlow(size_t size, size_t alignment) {
+    size_t needed = size + alignment - 1;
+    if (needed > blockSize) {
+        blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(needed));
+        reserved += needed;
+        return alignUp(blocks.back().get(), alignment);
+    }
+    blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(blockSize));
+    reserved += blockSize;
+    cursor = blocks.back().get();
+    limit = cursor + blockSize;
+
+    std::byte* aligned = alignUp(cursor, alignment);
+    cursor = aligned + size;
+    return aligned;
+}
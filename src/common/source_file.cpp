@@ -1,10 +1,11 @@
 #include "common/source_file.hpp"
 #include "diagnostics/diagnostic.hpp"
+#include <algorithm>
 
 SourceFile::SourceFile(const std::string& path) : filename(path), offsets({0}) {
     std::ifstream fin(path, std::ios::binary);
     if (!fin) {
-        Token token(TokenType::END_OF_FILE, "", path, 0, 0, nullptr);
+        Token token(TokenType::END_OF_FILE, registerFile(std::make_shared<SourceFile>("", path)), Token::noPosition, 0);
         throw Diagnostic(DiagnosticType::General, Severity::FatalError, "Khét lẹt luôn, hông tìm thấy file code. Chịu rồi bạn!", token);
     }
     buffer.assign(std::istreambuf_iterator<char>(fin.rdbuf()), {});
@@ -37,4 +38,35 @@ const std::string& SourceFile::name() const {
 
 const std::string& SourceFile::getBuffer() const { 
     return buffer; 
-}
\ No newline at end of file
+}
+
+size_t SourceFile::lineOf(size_t offset) const {
+    return static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin());
+}
+
+size_t SourceFile::columnOf(size_t offset) const {
+    return offset - offsets[lineOf(offset) - 1] + 1;
+}
+
+uint32_t SourceFile::addSpelling(std::string text) {
+    spellings.push_back(std::move(text));
+    return static_cast<uint32_t>(spellings.size() - 1);
+}
+
+std::vector<SrcFilePtr>& SourceFile::registry() {
+    static std::vector<SrcFilePtr> files = [] {
+        auto unknown = std::make_shared<SourceFile>("", "[unknown file]");
+        unknown->id = 0;
+        return std::vector<SrcFilePtr>{unknown};
+    }();
+    return files;
+}
+
+uint32_t SourceFile::registerFile(const SrcFilePtr& file) {
+    if (file->id == unregistered) {
+        std::vector<SrcFilePtr>& files = registry();
+        file->id = static_cast<uint32_t>(files.size());
+        files.push_back(file);
+    }
+    return file->id;
+}
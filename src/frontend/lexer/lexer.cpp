@@ -1,55 +1,190 @@
 #include "lexer/lexer.hpp"
 #include "lexer/keywords.hpp"
 #include "lexer/symbols.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cctype>
+#include <iterator>
+#include <string_view>
 #include <unordered_map>
 #include <iostream>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using enum TokenType;
 
-Lexer::Lexer(SrcFilePtr sourceFile): 
-    srcFile(std::move(sourceFile)), 
-    src_(srcFile->getBuffer()), 
-    filename_(srcFile->name()),
-    pos_(0), 
-    curr_char_(srcFile->getBuffer().empty() ? '\0' : srcFile->getBuffer()[0]), 
-    line_(1), col_(1),
-    start_line_(1), start_col_(1)
+namespace {
+
+// Lớp của từng byte, thay cho std::isspace/std::isalnum (phụ thuộc locale và phải gọi hàm).
+// Byte >= 0x80 không thuộc lớp nào, đúng như locale "C"
+enum CharClass : uint8_t {
+    CHAR_SPACE = 1,
+    CHAR_DIGIT = 2,
+    // chữ cái và '_'
+    CHAR_ALPHA = 4,
+};
+
+constexpr std::array<uint8_t, 256> char_classes = [] {
+    std::array<uint8_t, 256> classes{};
+    for (unsigned char c : std::string_view(" \t\n\v\f\r")) {
+        classes[c] |= CHAR_SPACE;
+    }
+    for (int c = '0'; c <= '9'; ++c) {
+        classes[c] |= CHAR_DIGIT;
+    }
+    for (int c = 'a'; c <= 'z'; ++c) {
+        classes[c] |= CHAR_ALPHA;
+        classes[c - 'a' + 'A'] |= CHAR_ALPHA;
+    }
+    classes['_'] |= CHAR_ALPHA;
+    return classes;
+}();
+
+inline bool has_class(unsigned char c, uint8_t mask) {
+    return (char_classes[c] & mask) != 0;
+}
+
+// Mỗi lớp ký tự dưới đây có contains() xét một byte, và (khi có SSE2) mask() xét 16 byte một lúc,
+// trả về byte 0xFF ở những vị trí thuộc lớp.
+#if defined(__SSE2__)
+using Block = __m128i;
+constexpr size_t block_size = 16;
+
+inline Block equal_to(Block block, char c) {
+    return _mm_cmpeq_epi8(block, _mm_set1_epi8(c));
+}
+
+// Byte nằm trong [lo, hi], so như số không dấu: (b - lo) <= (hi - lo)
+inline Block in_range(Block block, unsigned char lo, unsigned char hi) {
+    Block shifted = _mm_sub_epi8(block, _mm_set1_epi8(static_cast<char>(lo)));
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(hi - lo))), shifted);
+}
+
+inline Block invert(Block block) {
+    return _mm_cmpeq_epi8(block, _mm_setzero_si128());
+}
+#endif
+
+struct Spaces {
+#if defined(__SSE2__)
+    Block mask(Block block) const {
+        return _mm_or_si128(equal_to(block, ' '), in_range(block, '\t', '\r'));
+    }
+#endif
+    bool contains(unsigned char c) const {
+        return has_class(c, CHAR_SPACE);
+    }
+};
+
+struct IdentifierChars {
+#if defined(__SSE2__)
+    Block mask(Block block) const {
+        Block letters = in_range(_mm_or_si128(block, _mm_set1_epi8(0x20)), 'a', 'z');
+        return _mm_or_si128(_mm_or_si128(letters, in_range(block, '0', '9')), equal_to(block, '_'));
+    }
+#endif
+    bool contains(unsigned char c) const {
+        return has_class(c, CHAR_ALPHA | CHAR_DIGIT);
+    }
+};
+
+// Chữ số thập phân và dấu phân cách '_'
+struct DigitChars {
+#if defined(__SSE2__)
+    Block mask(Block block) const {
+        return _mm_or_si128(in_range(block, '0', '9'), equal_to(block, '_'));
+    }
+#endif
+    bool contains(unsigned char c) const {
+        return has_class(c, CHAR_DIGIT) || c == '_';
+    }
+};
+
+// Mọi byte trừ những byte dừng (luôn gồm '\0', vì '\0' là điểm kết thúc mã nguồn với Lexer)
+template <size_t N>
+struct AllBut {
+    std::array<char, N> stops;
+
+#if defined(__SSE2__)
+    Block mask(Block block) const {
+        Block stopped = equal_to(block, '\0');
+        for (char stop : stops) {
+            stopped = _mm_or_si128(stopped, equal_to(block, stop));
+        }
+        return invert(stopped);
+    }
+#endif
+    bool contains(unsigned char c) const {
+        return c != '\0' && std::find(stops.begin(), stops.end(), static_cast<char>(c)) == stops.end();
+    }
+};
+
+// Vị trí đầu tiên từ pos trở đi có byte không thuộc lớp (hoặc src.size()).
+// Có SSE2 thì xét từng khối 16 byte, phần cuối buffer không đủ một khối thì xét từng byte
+template <typename Class>
+size_t skip_while(const std::string& src, size_t pos, const Class& chars) {
+#if defined(__SSE2__)
+    while (pos + block_size <= src.size()) {
+        Block block = _mm_loadu_si128(reinterpret_cast<const Block*>(src.data() + pos));
+        unsigned outside = ~static_cast<unsigned>(_mm_movemask_epi8(chars.mask(block))) & 0xFFFFu;
+        if (outside != 0) {
+            return pos + std::countr_zero(outside);
+        }
+        pos += block_size;
+    }
+#endif
+    while (pos < src.size() && chars.contains(static_cast<unsigned char>(src[pos]))) {
+        ++pos;
+    }
+    return pos;
+}
+
+}
+
+Lexer::Lexer(SrcFilePtr sourceFile):
+    srcFile(std::move(sourceFile)),
+    src_(srcFile->getBuffer()),
+    file_id_(SourceFile::registerFile(srcFile)),
+    pos_(0),
+    curr_char_(srcFile->getBuffer().empty() ? '\0' : srcFile->getBuffer()[0]),
+    start_pos_(0)
 {}
 
 void Lexer::advance() noexcept {
-    if (curr_char_ == '\n') {
-        ++line_;
-        col_ = 1;
-    } else {
-        ++col_;
-    }
     ++pos_;
     curr_char_ = pos_ < src_.size() ? src_[pos_] : '\0';
 }
 
+void Lexer::advance_to(size_t pos) noexcept {
+    pos_ = pos;
+    curr_char_ = pos_ < src_.size() ? src_[pos_] : '\0';
+}
+
 unsigned char Lexer::peek() const noexcept {
     size_t next = pos_ + 1;
     return next < src_.size() ? src_[next] : '\0';
 }
 
 void Lexer::skip_whitespace() noexcept {
-    while (std::isspace(curr_char_)) {
-        advance();
-    }
+    advance_to(skip_while(src_, pos_, Spaces{}));
 }
 
 void Lexer::skip_line_comment() noexcept {
     advance(); advance();
-    while (curr_char_ != '\n' && curr_char_ != '\0') {
-        advance();
-    }
+    advance_to(skip_while(src_, pos_, AllBut<1>{{'\n'}}));
 }
 
 void Lexer::skip_block_comment() noexcept {
     advance(); advance();
 
-    while (!(curr_char_ == '*' && peek() == '/') && curr_char_ != '\0') {
+    while (true) {
+        advance_to(skip_while(src_, pos_, AllBut<1>{{'*'}}));
+        if (curr_char_ == '\0' || peek() == '/') {
+            break;
+        }
         advance();
     }
 
@@ -58,94 +193,100 @@ void Lexer::skip_block_comment() noexcept {
     }
 }
 
-inline Token Lexer::make_token(TokenType type, const std::string &lex) noexcept {
-    return { type, lex, filename_, start_line_, start_col_, srcFile };
+inline Token Lexer::make_token(TokenType type) const noexcept {
+    return { type, file_id_, static_cast<uint32_t>(start_pos_), static_cast<uint32_t>(pos_ - start_pos_) };
 }
 
-Token Lexer::identifier() {
-    std::string lex = std::string(1, curr_char_);
-    advance();
-    while (std::isalnum(curr_char_) || curr_char_ == '_') {
-        lex += curr_char_;
-        advance();
-    }
-    
-    if (auto it = keywords.find(lex); it != keywords.end()) {
-        return make_token(it->second, lex);
+Token Lexer::make_token(TokenType type, size_t text_start, std::string lex) const {
+    if (src_.compare(std::min(text_start, src_.size()), lex.size(), lex) == 0) {
+        return { type, file_id_, static_cast<uint32_t>(start_pos_), static_cast<uint32_t>(lex.size()), static_cast<uint32_t>(text_start) };
     }
+    return { type, file_id_, static_cast<uint32_t>(start_pos_), std::move(lex) };
+}
 
-    return make_token(IDENTIFIER, lex);
+Token Lexer::identifier() {
+    advance_to(skip_while(src_, pos_ + 1, IdentifierChars{}));
+    return make_token(lookupKeyword(std::string_view(src_).substr(start_pos_, pos_ - start_pos_)));
 }
 
-Token Lexer::number() { 
+// Chữ của số là đoạn vừa quét, bỏ các dấu phân cách '_' (nếu có thì mới phải chép ra)
+Token Lexer::number_token(TokenType type) const {
+    std::string_view text = std::string_view(src_).substr(start_pos_, pos_ - start_pos_);
+    if (text.find('_') == std::string_view::npos) {
+        return make_token(type);
+    }
     std::string lex;
+    std::copy_if(text.begin(), text.end(), std::back_inserter(lex), [](char c) { return c != '_'; });
+    return make_token(type, start_pos_, std::move(lex));
+}
+
+Token Lexer::number() {
     bool isReal = false;
 
     if (curr_char_ == '0') {
-        lex += curr_char_;
         advance();
 
         if (curr_char_ == 'x' || curr_char_ == 'X') {
-            lex += curr_char_;
             advance();
             while (std::isxdigit(curr_char_) || curr_char_ == '_') {
-                if (curr_char_ != '_') lex += curr_char_;
                 advance();
             }
-            return make_token(INTEGER, lex);
+            return number_token(INTEGER);
         }
         else if (curr_char_ == 'b' || curr_char_ == 'B') {
-            lex += curr_char_;
             advance();
             while (curr_char_ == '0' || curr_char_ == '1' || curr_char_ == '_') {
-                if (curr_char_ != '_') lex += curr_char_;
                 advance();
             }
-            return make_token(INTEGER, lex);
+            return number_token(INTEGER);
         }
         else if (curr_char_ == 'o' || curr_char_ == 'O') {
-            lex += curr_char_;
             advance();
             while ((curr_char_ >= '0' && curr_char_ <= '7') || curr_char_ == '_') {
-                if (curr_char_ != '_') lex += curr_char_;
                 advance();
             }
-            return make_token(INTEGER, lex);
+            return number_token(INTEGER);
         }
     }
 
-    while (std::isdigit(curr_char_) || curr_char_ == '_' || curr_char_ == '.') {
-        if (curr_char_ == '.') {
-            if (isReal) break;
-            isReal = true;
-            if (!std::isdigit(peek())) break;
+    advance_to(skip_while(src_, pos_, DigitChars{}));
+    if (curr_char_ == '.') {
+        isReal = true;
+        if (has_class(peek(), CHAR_DIGIT)) {
+            advance();
+            advance_to(skip_while(src_, pos_, DigitChars{}));
         }
-
-        if (curr_char_ != '_') lex += curr_char_;
-        advance();
     }
 
     if (curr_char_ == 'e' || curr_char_ == 'E') {
         isReal = true;
-        lex += curr_char_;
         advance();
         if (curr_char_ == '+' || curr_char_ == '-') {
-            lex += curr_char_;
-            advance();
-        }
-        while (std::isdigit(curr_char_) || curr_char_ == '_') {
-            if (curr_char_ != '_') lex += curr_char_;
             advance();
         }
+        advance_to(skip_while(src_, pos_, DigitChars{}));
     }
 
-    return make_token(isReal ? REAL : INTEGER, lex);
+    return number_token(isReal ? REAL : INTEGER);
 }
 
 Token Lexer::string_literal(unsigned char delimiter) {
     advance();
 
-    std::string lex = "";
+    size_t content = pos_;
+    AllBut<2> body{{static_cast<char>(delimiter), '\\'}};
+    advance_to(skip_while(src_, pos_, body));
+
+    // Không có escape: chữ của token là đúng đoạn giữa hai dấu nháy
+    if (curr_char_ != '\\') {
+        size_t length = pos_ - content;
+        if (curr_char_ == delimiter) {
+            advance();
+        }
+        return { STRING, file_id_, static_cast<uint32_t>(start_pos_), static_cast<uint32_t>(length), static_cast<uint32_t>(content) };
+    }
+
+    std::string lex(src_, content, pos_ - content);
 
     while (curr_char_ != delimiter && curr_char_ != '\0') {
         if (curr_char_ == '\\') {
@@ -162,39 +303,54 @@ Token Lexer::string_literal(unsigned char delimiter) {
                     lex += '\\';
                     lex += curr_char_;
             }
+            advance();
         } else {
-            lex += curr_char_;
+            size_t end = skip_while(src_, pos_, body);
+            lex.append(src_, pos_, end - pos_);
+            advance_to(end);
         }
-
-        advance();
     }
 
     if (curr_char_ == delimiter) {
         advance();
     }
 
-    return make_token(STRING, lex);
+    return make_token(STRING, content, std::move(lex));
 }
 
 Token Lexer::punctuator() {
     for (int len = 3; len >= 1; --len) {
-        std::string lex = src_.substr(pos_, len);
+        std::string_view lex = std::string_view(src_).substr(pos_, len);
         auto it = symbols.find(lex);
 
         if (it != symbols.end()) {
             for (int i = 0; i < len; ++i) {
                 advance();
             }
-            return make_token(it->second, lex);
+            return make_token(it->second);
         }
     }
 
-    return make_token(UNKNOWN, "");
+    return make_token(UNKNOWN);
 }
 
 Token Lexer::template_string() {
-    std::string lex = "";
-    while (curr_char_ != '`' && curr_char_ != '\0' && !(curr_char_ == '%' && peek() == '{')) {
+    AllBut<3> body{{'`', '%', '\\'}};
+    auto at_end = [this] {
+        return curr_char_ == '`' || curr_char_ == '\0' || (curr_char_ == '%' && peek() == '{');
+    };
+
+    // '%' không đứng trước '{' chỉ là chữ thường
+    advance_to(skip_while(src_, pos_, body));
+    while (curr_char_ == '%' && peek() != '{') {
+        advance_to(skip_while(src_, pos_ + 1, body));
+    }
+    if (curr_char_ != '\\') {
+        return make_token(STRING);
+    }
+
+    std::string lex(src_, start_pos_, pos_ - start_pos_);
+    while (!at_end()) {
         if (curr_char_ == '\\') {
             advance();
             switch (curr_char_) {
@@ -208,71 +364,66 @@ Token Lexer::template_string() {
                     lex += '\\';
                     lex += curr_char_;
             }
+            advance();
         } else {
-            lex += curr_char_;
+            size_t end = skip_while(src_, pos_ + 1, body);
+            lex.append(src_, pos_, end - pos_);
+            advance_to(end);
         }
-
-        advance();
     }
-    return make_token(STRING, lex);
+    return make_token(STRING, start_pos_, std::move(lex));
 }
 
 Token Lexer::raw_string(unsigned char delimiter) {
-    std::string lex = "";
     advance();
-    while (curr_char_ != delimiter && curr_char_ != '\0') {
-        lex += curr_char_;
-        advance();
-    }
+    size_t content = pos_;
+    advance_to(skip_while(src_, pos_, AllBut<1>{{static_cast<char>(delimiter)}}));
+    size_t length = pos_ - content;
     if (curr_char_ == delimiter) {
         advance();
     }
-    return make_token(STRING, lex);
+    return { STRING, file_id_, static_cast<uint32_t>(start_pos_), static_cast<uint32_t>(length), static_cast<uint32_t>(content) };
 }
 
 Token Lexer::next_token() {
     if (!is_in_template_mode_) skip_whitespace();
-    start_line_ = line_; 
-    start_col_ = col_;
+    start_pos_ = pos_;
     if (is_in_expression_ && curr_char_ == '}') {
         is_in_template_mode_ = true;
         is_in_expression_ = false;
-        Token token = make_token(PUNCT_RBRACE, "}");
         advance();
-        return token;
+        return make_token(PUNCT_RBRACE);
     }
 
     if (is_in_template_mode_) {
         if (curr_char_ == '`') {
             is_in_template_mode_ = false;
-            Token token = make_token(PUNCT_BACKTICK, "`");
             advance();
-            return token;
+            return make_token(PUNCT_BACKTICK);
         } else if (curr_char_ == '%' && peek() == '{') {
             is_in_template_mode_ = false;
             is_in_expression_ = true;
             advance(); advance();
-            return make_token(PUNCT_PERCENT_LBRACE, "%{");
+            return make_token(PUNCT_PERCENT_LBRACE);
         }
 
         return template_string();
     } else {
         if (curr_char_ == '\0') {
-            return make_token(END_OF_FILE, "");
+            return make_token(END_OF_FILE);
         } else if ((curr_char_ == 'r' || curr_char_ == 'R') && (peek() == '"' || peek() == '\'')) {
             advance();
             return raw_string(curr_char_);
-        } else if (std::isalpha(curr_char_) || curr_char_ == '_') {
+        } else if (has_class(curr_char_, CHAR_ALPHA)) {
             return identifier();
-        } else if (std::isdigit(curr_char_)) {
+        } else if (has_class(curr_char_, CHAR_DIGIT)) {
             return number();
         } else {
             switch (curr_char_) {
                 case '`': {
                     is_in_template_mode_ = true;
-                    Token token = make_token(PUNCT_BACKTICK, "`");
                     advance();
-                    return token;
+                    return make_token(PUNCT_BACKTICK);
                 }
                 case '"':
                     return string_literal('"');
@@ -288,12 +439,16 @@ Token Lexer::next_token() {
                     }
                     return punctuator();
                 default:
-                    return punctuator();              
+                    return punctuator();
             }
         }
     }
 }
 
+Token Lexer::nextToken() {
+    return next_token();
+}
+
 std::vector<Token> Lexer::tokenize() {
     is_in_template_mode_ = false;
     is_in_expression_ = false;
@@ -308,4 +463,4 @@ std::vector<Token> Lexer::tokenize() {
     }
 
     return tokens;
-}
\ No newline at end of file
+}
@@ -0,0 +1,51 @@
+#include "lexer/token_stream.hpp"
+
+namespace {
+
+Token placeholderToken() {
+    return { TokenType::UNKNOWN, 0, Token::noPosition, 0 };
+}
+
+}
+
+TokenStream::TokenStream(SrcFilePtr sourceFile):
+    ring{ placeholderToken(), placeholderToken(), placeholderToken(), placeholderToken() }
+{
+    lexer.emplace(std::move(sourceFile));
+    fill();
+}
+
+TokenStream::TokenStream(const std::vector<Token>& tokens):
+    tokens(&tokens),
+    ring{ placeholderToken(), placeholderToken(), placeholderToken(), placeholderToken() }
+{
+    fill();
+}
+
+void TokenStream::advance() {
+    if (peek().type == TokenType::END_OF_FILE) return;
+    ++current;
+    fill();
+}
+
+Token TokenStream::pull() {
+    if (lexer) {
+        return lexer->nextToken();
+    }
+    if (pulled < tokens->size()) {
+        return (*tokens)[pulled];
+    }
+    // Vector không kết thúc bằng END_OF_FILE: coi như hết ngay sau token cuối
+    Token last = tokens->empty() ? placeholderToken() : tokens->back();
+    return { TokenType::END_OF_FILE, last.fileId, last.position, 0 };
+}
+
+// Bảo đảm peek() và next() đã nằm trong vòng đệm
+void TokenStream::fill() {
+    while (pulled <= current + 1) {
+        Token token = reachedEnd ? ring[(pulled - 1) & ringMask] : pull();
+        reachedEnd = reachedEnd || token.type == TokenType::END_OF_FILE;
+        ring[pulled & ringMask] = token;
+        ++pulled;
+    }
+}
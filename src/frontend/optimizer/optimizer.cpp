@@ -0,0 +1,446 @@
+#include "optimizer/optimizer.hpp"
+#include "runtime/intern.hpp"
+#include "runtime/operator_dispatcher.hpp"
+#include <optional>
+#include <sstream>
+
+namespace {
+
+// Giá trị của node nếu nó là literal mang giá trị nguyên thủy
+std::optional<Value> constantOf(const Expression* expression) {
+    switch (expression->type) {
+        case EXPR_LITERAL_INTEGER:
+            return Value(static_cast<const IntegerLiteral*>(expression)->value);
+        case EXPR_LITERAL_REAL:
+            return Value(static_cast<const RealLiteral*>(expression)->value);
+        case EXPR_LITERAL_STRING:
+            return Value(static_cast<const StringLiteral*>(expression)->atom);
+        case EXPR_LITERAL_BOOLEAN:
+            return Value(static_cast<const BooleanLiteral*>(expression)->value);
+        case EXPR_LITERAL_NULL:
+            return Value(Null{});
+        default:
+            return std::nullopt;
+    }
+}
+
+// Literal mang giá trị value, giữ vị trí của node bị thay để thông báo lỗi vẫn trỏ đúng chỗ.
+// Trả về nullptr nếu kiểu của value không có literal tương ứng.
+ExprPtr makeLiteral(AstArena& arena, const Value& value, Token token) {
+    if (auto number = std::get_if<Int>(&value)) {
+        token.respell(std::to_string(*number));
+        return arena.make<IntegerLiteral>(std::move(token), *number);
+    }
+    if (auto number = std::get_if<Real>(&value)) {
+        token.respell(toString(value));
+        return arena.make<RealLiteral>(std::move(token), *number);
+    }
+    if (auto flag = std::get_if<Bool>(&value)) {
+        token.respell(*flag ? "true" : "false");
+        return arena.make<BooleanLiteral>(std::move(token), *flag);
+    }
+    if (auto string = std::get_if<String>(&value)) {
+        token.respell((*string)->str);
+        return arena.make<StringLiteral>(std::move(token), intern((*string)->str));
+    }
+    if (std::holds_alternative<Null>(value)) {
+        token.respell("null");
+        return arena.make<NullLiteral>(std::move(token));
+    }
+    return nullptr;
+}
+
+std::optional<Value> foldBinary(TokenType op, const Value& left, const Value& right) {
+    // Nhân chuỗi có thể sinh chuỗi rất lớn ngay lúc biên dịch, kể cả ở nhánh không bao giờ chạy
+    if (op == TokenType::OP_MULTIPLY && (std::holds_alternative<String>(left) || std::holds_alternative<String>(right))) {
+        return std::nullopt;
+    }
+    auto opFunc = OperatorDispatcher::shared.find(op, left, right);
+    if (opFunc == nullptr) {
+        return std::nullopt;
+    }
+    try {
+        return opFunc(left, right);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+std::optional<Value> foldUnary(TokenType op, const Value& operand) {
+    auto opFunc = OperatorDispatcher::shared.find(op, operand);
+    if (opFunc == nullptr) {
+        return std::nullopt;
+    }
+    try {
+        return opFunc(operand);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+bool isDeclaration(const Statement* statement) {
+    switch (statement->type) {
+        case STMT_LET:
+        case STMT_CLASS:
+        case STMT_IMPORT:
+        case STMT_EXPORT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isTerminator(const Statement* statement) {
+    switch (statement->type) {
+        case STMT_RETURN:
+        case STMT_BREAK:
+        case STMT_CONTINUE:
+        case STMT_THROW:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}
+
+void AstPass::run(Program* program) {
+    arena = &program->arena;
+    walk(program->body);
+}
+
+void AstPass::walk(ExprPtr& expression) {
+    if (expression == nullptr) {
+        return;
+    }
+
+    switch (expression->type) {
+        case EXPR_BINARY: {
+            auto node = static_cast<BinaryExpression*>(expression.get());
+            walk(node->left);
+            walk(node->right);
+            break;
+        }
+        case EXPR_UNARY:
+            walk(static_cast<UnaryExpression*>(expression.get())->operand);
+            break;
+        case EXPR_CALL: {
+            auto node = static_cast<CallExpression*>(expression.get());
+            walk(node->callee);
+            for (auto& arg : node->args) {
+                walk(arg);
+            }
+            break;
+        }
+        case EXPR_INDEX: {
+            auto node = static_cast<IndexExpression*>(expression.get());
+            walk(node->left);
+            walk(node->index);
+            break;
+        }
+        case EXPR_ASSIGN: {
+            auto node = static_cast<AssignmentExpression*>(expression.get());
+            walk(node->target);
+            walk(node->value);
+            break;
+        }
+        case EXPR_TERNARY: {
+            auto node = static_cast<TernaryExpression*>(expression.get());
+            walk(node->condition);
+            walk(node->thenBranch);
+            walk(node->elseBranch);
+            break;
+        }
+        case EXPR_PROPERTY_ACCESS:
+            walk(static_cast<PropertyAccess*>(expression.get())->object);
+            break;
+        case EXPR_PROPERTY_ASSIGN: {
+            auto node = static_cast<PropertyAssignment*>(expression.get());
+            walk(node->targetObj);
+            walk(node->value);
+            break;
+        }
+        case EXPR_NEW:
+            walk(static_cast<NewExpression*>(expression.get())->expression);
+            break;
+        case EXPR_UPDATE_PREFIX:
+            walk(static_cast<PrefixUpdateExpression*>(expression.get())->operand);
+            break;
+        case EXPR_UPDATE_POSTFIX:
+            walk(static_cast<PostfixUpdateExpression*>(expression.get())->operand);
+            break;
+        case EXPR_SPREAD:
+            walk(static_cast<SpreadExpression*>(expression.get())->expression);
+            break;
+        case EXPR_LITERAL_ARRAY:
+            for (auto& element : static_cast<ArrayLiteral*>(expression.get())->elements) {
+                walk(element);
+            }
+            break;
+        case EXPR_LITERAL_OBJECT:
+            for (auto& property : static_cast<ObjectLiteral*>(expression.get())->properties) {
+                walk(property.first);
+                walk(property.second);
+            }
+            break;
+        case EXPR_LITERAL_FUNCTION:
+            walk(static_cast<FunctionLiteral*>(expression.get())->body);
+            break;
+        case EXPR_LITERAL_TEMPLATE:
+            for (auto& part : static_cast<TemplateLiteral*>(expression.get())->parts) {
+                walk(part);
+            }
+            break;
+        default:
+            break;
+    }
+
+    rewrite(expression);
+}
+
+void AstPass::walk(StmtPtr& statement) {
+    if (statement == nullptr) {
+        return;
+    }
+
+    switch (statement->type) {
+        case STMT_LET:
+            walk(static_cast<LetStatement*>(statement.get())->value);
+            break;
+        case STMT_RETURN:
+            walk(static_cast<ReturnStatement*>(statement.get())->value);
+            break;
+        case STMT_THROW:
+            walk(static_cast<ThrowStatement*>(statement.get())->argument);
+            break;
+        case STMT_IF: {
+            auto node = static_cast<IfStatement*>(statement.get());
+            walk(node->condition);
+            walk(node->thenBranch);
+            walk(node->elseBranch);
+            break;
+        }
+        case STMT_WHILE: {
+            auto node = static_cast<WhileStatement*>(statement.get());
+            walk(node->condition);
+            walk(node->body);
+            break;
+        }
+        case STMT_FOR: {
+            auto node = static_cast<ForStatement*>(statement.get());
+            walk(node->init);
+            walk(node->condition);
+            walk(node->update);
+            walk(node->body);
+            break;
+        }
+        case STMT_FOR_IN: {
+            auto node = static_cast<ForInStatement*>(statement.get());
+            walk(node->collection);
+            walk(node->body);
+            break;
+        }
+        case STMT_DO_WHILE: {
+            auto node = static_cast<DoWhileStatement*>(statement.get());
+            walk(node->body);
+            walk(node->condition);
+            break;
+        }
+        case STMT_BLOCK:
+            walk(static_cast<BlockStatement*>(statement.get())->statements);
+            break;
+        case STMT_CLASS: {
+            auto node = static_cast<ClassStatement*>(statement.get());
+            for (auto& method : node->methods) {
+                walk(method);
+            }
+            for (auto& field : node->static_fields) {
+                walk(field);
+            }
+            break;
+        }
+        case STMT_EXPORT:
+            walk(static_cast<ExportStatement*>(statement.get())->declaration);
+            break;
+        case STMT_TRY: {
+            auto node = static_cast<TryStatement*>(statement.get());
+            walk(node->tryBlock);
+            walk(node->catchBlock);
+            break;
+        }
+        case STMT_SWITCH: {
+            auto node = static_cast<SwitchStatement*>(statement.get());
+            walk(node->value);
+            for (auto& switchCase : node->cases) {
+                walk(switchCase->value);
+                walk(switchCase->statements);
+            }
+            break;
+        }
+        case STMT_EXPR:
+            walk(static_cast<ExpressionStatement*>(statement.get())->expression);
+            break;
+        case STMT_LOG:
+            walk(static_cast<LogStatement*>(statement.get())->expression);
+            break;
+        default:
+            break;
+    }
+
+    rewrite(statement);
+}
+
+void AstPass::walk(std::vector<StmtPtr>& statements) {
+    for (auto& statement : statements) {
+        walk(statement);
+    }
+    rewrite(statements);
+}
+
+void ConstantFolding::rewrite(ExprPtr& expression) {
+    ExprPtr folded;
+
+    switch (expression->type) {
+        case EXPR_BINARY: {
+            auto node = static_cast<BinaryExpression*>(expression.get());
+            auto left = constantOf(node->left.get());
+            if (!left) {
+                break;
+            }
+
+            // &&, || và ??: vế trái là hằng thì biết ngay vế nào là kết quả, vế phải không cần là hằng
+            switch (node->op) {
+                case TokenType::OP_LOGICAL_OR:
+                    folded = isTruthy(*left) ? std::move(node->left) : std::move(node->right);
+                    break;
+                case TokenType::OP_LOGICAL_AND:
+                    folded = isTruthy(*left) ? std::move(node->right) : std::move(node->left);
+                    break;
+                case TokenType::OP_NULLISH:
+                    folded = std::holds_alternative<Null>(*left) ? std::move(node->right) : std::move(node->left);
+                    break;
+                default:
+                    if (auto right = constantOf(node->right.get())) {
+                        if (auto result = foldBinary(node->op, *left, *right)) {
+                            folded = makeLiteral(*arena, *result, node->token);
+                        }
+                    }
+                    break;
+            }
+            break;
+        }
+        case EXPR_UNARY: {
+            auto node = static_cast<UnaryExpression*>(expression.get());
+            if (auto operand = constantOf(node->operand.get())) {
+                if (auto result = foldUnary(node->op, *operand)) {
+                    folded = makeLiteral(*arena, *result, node->token);
+                }
+            }
+            break;
+        }
+        case EXPR_LITERAL_TEMPLATE: {
+            auto node = static_cast<TemplateLiteral*>(expression.get());
+            std::ostringstream os;
+            for (const auto& part : node->parts) {
+                auto value = constantOf(part.get());
+                if (!value) {
+                    return;
+                }
+                os << toString(*value);
+            }
+            folded = makeLiteral(*arena, Value(os.str()), node->token);
+            break;
+        }
+        case EXPR_TERNARY: {
+            auto node = static_cast<TernaryExpression*>(expression.get());
+            if (auto condition = constantOf(node->condition.get())) {
+                folded = isTruthy(*condition) ? std::move(node->thenBranch) : std::move(node->elseBranch);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (folded != nullptr) {
+        expression = std::move(folded);
+        ++stats.rewrites;
+    }
+}
+
+void DeadCodeElimination::rewrite(StmtPtr& statement) {
+    switch (statement->type) {
+        case STMT_IF: {
+            auto node = static_cast<IfStatement*>(statement.get());
+            auto condition = constantOf(node->condition.get());
+            if (!condition) {
+                return;
+            }
+            StmtPtr& taken = isTruthy(*condition) ? node->thenBranch : node->elseBranch;
+            if (taken == nullptr) {
+                statement = arena->make<BlockStatement>(node->token);
+            } else if (taken->type == STMT_BLOCK) {
+                // Block có scope riêng nên đưa thẳng ra ngoài vẫn giữ nguyên phạm vi của các khai báo bên trong
+                statement = std::move(taken);
+            } else {
+                return;
+            }
+            ++stats.rewrites;
+            break;
+        }
+        case STMT_WHILE: {
+            auto node = static_cast<WhileStatement*>(statement.get());
+            auto condition = constantOf(node->condition.get());
+            if (condition && !isTruthy(*condition)) {
+                statement = arena->make<BlockStatement>(node->token);
+                ++stats.rewrites;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void DeadCodeElimination::rewrite(std::vector<StmtPtr>& statements) {
+    bool isReachable = true;
+    size_t kept = 0;
+
+    for (auto& statement : statements) {
+        bool isEmptyBlock = statement->type == STMT_BLOCK
+            && static_cast<BlockStatement*>(statement.get())->statements.empty();
+
+        if ((isReachable || isDeclaration(statement.get())) && !isEmptyBlock) {
+            if (isTerminator(statement.get())) {
+                isReachable = false;
+            }
+            statements[kept++] = std::move(statement);
+        } else {
+            ++stats.rewrites;
+        }
+    }
+    statements.resize(kept);
+}
+
+Optimizer::Optimizer(OptimizationLevel level) {
+    if (level >= OptimizationLevel::O1) {
+        passes.push_back(std::make_unique<ConstantFolding>());
+    }
+    if (level >= OptimizationLevel::O2) {
+        passes.push_back(std::make_unique<DeadCodeElimination>());
+    }
+}
+
+void Optimizer::optimize(Program* program) {
+    for (const auto& pass : passes) {
+        pass->run(program);
+    }
+}
+
+std::vector<PassStats> Optimizer::statistics() const {
+    std::vector<PassStats> result;
+    for (const auto& pass : passes) {
+        result.push_back(pass->statistics());
+    }
+    return result;
+}
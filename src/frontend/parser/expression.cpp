@@ -1,4 +1,5 @@
 #include "parser/parser.hpp"
+#include "runtime/intern.hpp"
 
 using enum TokenType;
 using enum NodeType;
@@ -8,15 +9,15 @@ ExprPtr Parser::literal(Parser* parser) {
 
     switch (prevToken.type) {
         case INTEGER:
-            return std::make_unique<IntegerLiteral>(prevToken, std::stoll(prevToken.lexeme, nullptr, 0));
+            return parser->make<IntegerLiteral>(prevToken, std::stoll(std::string(prevToken.lexeme()), nullptr, 0));
         case REAL:
-            return std::make_unique<RealLiteral>(prevToken, std::stod(prevToken.lexeme));
+            return parser->make<RealLiteral>(prevToken, std::stod(std::string(prevToken.lexeme())));
         case STRING:
-            return std::make_unique<StringLiteral>(prevToken);
+            return parser->make<StringLiteral>(prevToken, intern(std::string(prevToken.lexeme())));
         case BOOLEAN:
-            return std::make_unique<BooleanLiteral>(prevToken, prevToken.lexeme == "true");
+            return parser->make<BooleanLiteral>(prevToken, prevToken.lexeme() == "true");
         case KEYWORD_NULL:
-            return std::make_unique<NullLiteral>(prevToken);
+            return parser->make<NullLiteral>(prevToken);
         default:
             throw Diagnostic::ParseErr("Tôi chưa định nghĩa kiểu dữ liệu này, hay là bạn tự thêm nó à?", prevToken);
     }
@@ -29,7 +30,7 @@ ExprPtr Parser::arrayLiteral(Parser* parser) {
         do {
             if (parser->match({OP_ELLIPSIS})) {
                 Token spreadToken = parser->previous();
-                elements.push_back(std::make_unique<SpreadExpression>(spreadToken, parser->expression()));
+                elements.push_back(parser->make<SpreadExpression>(spreadToken, parser->expression()));
             } else {
                 elements.push_back(parser->expression());
             }
@@ -38,7 +39,7 @@ ExprPtr Parser::arrayLiteral(Parser* parser) {
 
     parser->consume(PUNCT_RBRACKET, "Cần một dấu ngoặc vuông phải ']'");
 
-    return std::make_unique<ArrayLiteral>(token, std::move(elements));
+    return parser->make<ArrayLiteral>(token, std::move(elements));
 }
 
 ExprPtr Parser::functionLiteral(Parser *parser) {
@@ -60,11 +61,11 @@ ExprPtr Parser::objectLiteral(Parser* parser) {
         } else {
             Token keyToken = parser->peek();
             if (parser->match({IDENTIFIER, STRING})) {
-                key = std::make_unique<StringLiteral>(keyToken);
+                key = parser->make<StringLiteral>(keyToken, intern(std::string(keyToken.lexeme())));
             } else if (parser->match({INTEGER})) {
-                key = std::make_unique<IntegerLiteral>(keyToken, std::stoll(keyToken.lexeme));
+                key = parser->make<IntegerLiteral>(keyToken, std::stoll(std::string(keyToken.lexeme())));
             } else if (parser->match({BOOLEAN})) {
-                key = std::make_unique<BooleanLiteral>(keyToken, keyToken.lexeme == "true");
+                key = parser->make<BooleanLiteral>(keyToken, keyToken.lexeme() == "true");
             } else {
                 throw Diagnostic::ParseErr("Key của object không hợp lệ..", keyToken);
             }
@@ -82,7 +83,7 @@ ExprPtr Parser::objectLiteral(Parser* parser) {
 
     parser->consume(PUNCT_RBRACE, "Cần dấu ngoặc nhọn '}' trước khi kết thúc định nghĩa một object đấy!");
 
-    return std::make_unique<ObjectLiteral>(token, std::move(properties));
+    return parser->make<ObjectLiteral>(token, std::move(properties));
 }
 
 ExprPtr Parser::templateLiteral(Parser* parser) {
@@ -91,18 +92,18 @@ ExprPtr Parser::templateLiteral(Parser* parser) {
 
     while (!parser->check(PUNCT_BACKTICK) && !parser->isAtEnd()) {
         if (parser->match({STRING})) {
-            parts.push_back(std::make_unique<StringLiteral>(parser->previous()));
+            parts.push_back(parser->make<StringLiteral>(parser->previous(), intern(std::string(parser->previous().lexeme()))));
         } else if (parser->match({PUNCT_PERCENT_LBRACE})) {
             parts.push_back(parser->expression());
             parser->consume(PUNCT_RBRACE, "Cần dấu ngoặc nhọn đòng '}' sau biểu thức này");
         }
     }
     parser->consume(PUNCT_BACKTICK, "Cần dấu backtick đóng '`' cho template");
-    return std::make_unique<TemplateLiteral>(token, std::move(parts));
+    return parser->make<TemplateLiteral>(token, std::move(parts));
 }
 
 ExprPtr Parser::identifier(Parser* parser) {
-    return std::make_unique<Identifier>(std::move(parser->previous()));
+    return parser->make<Identifier>(std::move(parser->previous()));
 }
 
 ExprPtr Parser::binary(Parser* parser, ExprPtr left) {
@@ -110,7 +111,7 @@ ExprPtr Parser::binary(Parser* parser, ExprPtr left) {
 
     auto right = parser->parsePrecedence(parser->rules[op.type].precedence);
 
-    return make_unique<BinaryExpression>(op, std::move(left), std::move(right));
+    return parser->make<BinaryExpression>(op, std::move(left), std::move(right));
 }
 
 ExprPtr Parser::unary(Parser* parser) {
@@ -118,7 +119,7 @@ ExprPtr Parser::unary(Parser* parser) {
 
     ExprPtr operand = parser->parsePrecedence(Precedence::UNARY);
 
-    return make_unique<UnaryExpression>(op, std::move(operand));
+    return parser->make<UnaryExpression>(op, std::move(operand));
 }
 
 ExprPtr Parser::grouping(Parser* parser) {
@@ -128,21 +129,21 @@ ExprPtr Parser::grouping(Parser* parser) {
 }
 
 ExprPtr Parser::thisExpr(Parser* parser) {
-    return std::make_unique<ThisExpression>(parser->previous());
+    return parser->make<ThisExpression>(parser->previous());
 }
 
 ExprPtr Parser::superExpr(Parser* parser) {
     const Token& token = parser->previous();
     if (parser->check(PUNCT_LPAREN)) {
-        return std::make_unique<SuperExpression>(token, true, nullptr);
+        return parser->make<SuperExpression>(token, true, nullptr);
     }
     parser->consume(PUNCT_DOT, "Sau super phải là một dấu chấm cho thuộc tính");
 
     const Token& propertyToken = parser->consume(IDENTIFIER, "Cần tên thuộc tính sau dấu chấm '.'");
 
-    auto property = std::make_unique<Identifier>(propertyToken);
+    auto property = parser->make<Identifier>(propertyToken);
 
-    return std::make_unique<SuperExpression>(token, false, std::move(property));
+    return parser->make<SuperExpression>(token, false, std::move(property));
 }
 
 ExprPtr Parser::newExpr(Parser* parser) {
@@ -150,12 +151,12 @@ ExprPtr Parser::newExpr(Parser* parser) {
     const Token& identToken = parser->consume(IDENTIFIER, "Cần tên hàm để gọi sau 'new'");
 
     if (!parser->check(PUNCT_LPAREN)) {
-        auto callExpr = std::make_unique<CallExpression>(identToken, std::make_unique<Identifier>(identToken), std::vector<ExprPtr>{});
-        return std::make_unique<NewExpression>(token, std::move(callExpr));
+        auto callExpr = parser->make<CallExpression>(identToken, parser->make<Identifier>(identToken), std::vector<ExprPtr>{});
+        return parser->make<NewExpression>(token, std::move(callExpr));
     } else {
         parser->consume(PUNCT_LPAREN, "Cần '(' sau tên class");
-        auto callExpr = Parser::call(parser, std::make_unique<Identifier>(identToken));
-        return std::make_unique<NewExpression>(token, std::move(callExpr));
+        auto callExpr = Parser::call(parser, parser->make<Identifier>(identToken));
+        return parser->make<NewExpression>(token, std::move(callExpr));
     }
 
     throw Diagnostic::ParseErr("Không dùng cái này sau 'new' được", token);
@@ -166,13 +167,13 @@ ExprPtr Parser::spreadExpr(Parser* parser) {
 
     ExprPtr expr = parser->expression();
 
-    return std::make_unique<SpreadExpression>(token, std::move(expr));
+    return parser->make<SpreadExpression>(token, std::move(expr));
 }
 
 ExprPtr Parser::prefixUpdate(Parser* parser) {
     const Token &token = parser->previous();
     ExprPtr expr = parser->expression();
-    return std::make_unique<PrefixUpdateExpression>(token, std::move(expr));
+    return parser->make<PrefixUpdateExpression>(token, std::move(expr));
 }
 
 ExprPtr Parser::assignment(Parser* parser, ExprPtr left) {
@@ -180,7 +181,7 @@ ExprPtr Parser::assignment(Parser* parser, ExprPtr left) {
     ExprPtr value = parser->parsePrecedence((Precedence)(static_cast<int>(Precedence::ASSIGN) - 1));
 
     if (left->type == EXPR_IDENTIFIER || left->type == EXPR_INDEX || left->type == EXPR_PROPERTY_ACCESS) {
-        return std::make_unique<AssignmentExpression>(op, std::move(left), std::move(value));
+        return parser->make<AssignmentExpression>(op, std::move(left), std::move(value));
     }
 
     throw Diagnostic::ParseErr("Đối tượng được gán không hợp lệ!", op);
@@ -193,7 +194,7 @@ ExprPtr Parser::call(Parser* parser, ExprPtr left) {
         do {
             if (parser->match({OP_ELLIPSIS})) {
                 Token spreadToken = parser->previous();
-                args.push_back(std::make_unique<SpreadExpression>(spreadToken, parser->expression()));
+                args.push_back(parser->make<SpreadExpression>(spreadToken, parser->expression()));
             } else {
                 args.push_back(parser->expression());
             }
@@ -202,23 +203,24 @@ ExprPtr Parser::call(Parser* parser, ExprPtr left) {
 
     const Token& closingParen = parser->consume(PUNCT_RPAREN, "Yo, gọi hàm mà quên dấu ngoặc đơn ')' à?");
 
-    return std::make_unique<CallExpression>(closingParen, std::move(left), std::move(args));
+    return parser->make<CallExpression>(closingParen, std::move(left), std::move(args));
 }
 
 ExprPtr Parser::index(Parser* parser, ExprPtr left) {
     ExprPtr expr = parser->expression();
     const Token& closingBracket = parser->consume(PUNCT_RBRACKET, "Thiếu luôn dấu ngoặc vuông ']' khi kết thúc truy cập. Hay thật!");
 
-    return std::make_unique<IndexExpression>(closingBracket, std::move(left), std::move(expr));
+    return parser->make<IndexExpression>(closingBracket, std::move(left), std::move(expr));
 }
 
 ExprPtr Parser::access(Parser* parser, ExprPtr left) {
     const Token& token = parser->previous();
     const Token& propertyToken = parser->consume(IDENTIFIER, "Cần tên thuộc tính sau dấu chấm '.'");
 
-    auto property = std::make_unique<Identifier>(propertyToken);
+    auto property = parser->make<Identifier>(propertyToken);
+    String key = intern(property->name);
 
-    return std::make_unique<PropertyAccess>(token, std::move(left), std::move(property));
+    return parser->make<PropertyAccess>(token, std::move(left), std::move(property), std::move(key));
 }
 
 ExprPtr Parser::ternary(Parser* parser, ExprPtr left) {
@@ -229,26 +231,26 @@ ExprPtr Parser::ternary(Parser* parser, ExprPtr left) {
 
     ExprPtr elseBranch = parser->parsePrecedence((Precedence)(static_cast<int>(Precedence::TERNARY) - 1));
 
-    return std::make_unique<TernaryExpression>(token, std::move(left), std::move(thenBranch), std::move(elseBranch));
+    return parser->make<TernaryExpression>(token, std::move(left), std::move(thenBranch), std::move(elseBranch));
 }
 
 ExprPtr Parser::postfixUpdate(Parser* parser, ExprPtr left) {
-    return std::make_unique<PostfixUpdateExpression>(parser->previous(), std::move(left));
+    return parser->make<PostfixUpdateExpression>(parser->previous(), std::move(left));
 }
 
 ExprPtr Parser::parseFunctionTail(Token token) {
     consume(PUNCT_LPAREN, "Này này, bạn quên dấu ngoặc đơn '(' để bắt đầu cho những tham số đấy nhá!");
 
-    std::vector<std::unique_ptr<Identifier>> params;
+    std::vector<IdenPtr> params;
     IdenPtr restParam = nullptr;
 
     if (!check(PUNCT_RPAREN) && !isAtEnd()) {
         do {
             if (match({OP_ELLIPSIS})) {
-                restParam = std::make_unique<Identifier>(consume(IDENTIFIER, "Sau '...' phải là một tên biến!"));
+                restParam = make<Identifier>(consume(IDENTIFIER, "Sau '...' phải là một tên biến!"));
                 break;
             }
-            params.push_back(std::make_unique<Identifier>(consume(IDENTIFIER, "Đây phải là tên tham số mà bạn!")));
+            params.push_back(make<Identifier>(consume(IDENTIFIER, "Đây phải là tên tham số mà bạn!")));
         } while (match({PUNCT_COMMA}));
     }
 
@@ -256,5 +258,5 @@ ExprPtr Parser::parseFunctionTail(Token token) {
 
     StmtPtr body = declaration();
 
-    return std::make_unique<FunctionLiteral>(std::move(token), std::move(params), std::move(body), std::move(restParam));
+    return make<FunctionLiteral>(std::move(token), std::move(params), std::move(body), std::move(restParam));
 }
\ No newline at end of file
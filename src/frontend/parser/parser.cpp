@@ -3,12 +3,17 @@
 
 using enum TokenType;
 
-Parser::Parser(const std::vector<Token> &tokens): tokens(tokens), current(0) {
+Parser::Parser(SrcFilePtr sourceFile): tokens(std::move(sourceFile)) {
+    initRules();
+}
+
+Parser::Parser(const std::vector<Token> &tokens): tokens(tokens) {
     initRules();
 }
 
 std::unique_ptr<Program> Parser::parseProgram() {
     std::unique_ptr<Program> program = std::make_unique<Program>();
+    arena = &program->arena;
     while (!isAtEnd()) {
         try {
             auto decl = declaration();
@@ -27,22 +32,20 @@ bool Parser::isAtEnd() const {
     return peek().type == TokenType::END_OF_FILE;
 }
 
-const Token& Parser::peek() const {
-    return tokens[current];
+Token Parser::peek() const {
+    return tokens.peek();
 }
 
-const Token& Parser::previous() const {
-    return tokens[current - 1];
+Token Parser::previous() const {
+    return tokens.previous();
 }
 
-const Token& Parser::next() const {
-    size_t next = current + 1;
-    if (!isAtEnd()) return tokens[next];
-    return peek();
+Token Parser::next() const {
+    return tokens.next();
 }
 
-const Token& Parser::advance() {
-    if (!isAtEnd()) current++;
+Token Parser::advance() {
+    tokens.advance();
     return previous();
 }
 
@@ -61,7 +64,7 @@ bool Parser::match(std::initializer_list<TokenType> types) {
     return false;
 }
 
-const Token& Parser::consume(TokenType type, const std::string &errMsg) {
+Token Parser::consume(TokenType type, const std::string &errMsg) {
     if (check(type)) return advance();
 
     throw Diagnostic::ParseErr(errMsg, peek());
@@ -4,7 +4,7 @@ using enum TokenType;
 using enum NodeType;
 
 StmtPtr Parser::letDeclaration(Token token, bool isConstant = false) {
-    auto identifier = std::make_unique<Identifier>(consume(IDENTIFIER, "Expected identifier"));
+    auto identifier = make<Identifier>(consume(IDENTIFIER, "Expected identifier"));
     ExprPtr value = nullptr;
     if (match({OP_ASSIGN})) {
         value = expression();
@@ -12,23 +12,23 @@ StmtPtr Parser::letDeclaration(Token token, bool isConstant = false) {
 
     consume(PUNCT_SEMICOLON, "Thiếu dấu phẩy ';' sau một câu định nghĩa let!");
 
-    return std::make_unique<LetStatement>(token, std::move(identifier), std::move(value), isConstant);
+    return make<LetStatement>(token, std::move(identifier), std::move(value), isConstant);
 }
 
 StmtPtr Parser::functionDeclaration(Token token) {
-    auto identifier = std::make_unique<Identifier>(consume(IDENTIFIER, "Cần một cái tên cho hàm. Bạn quên rồi à?"));
+    auto identifier = make<Identifier>(consume(IDENTIFIER, "Cần một cái tên cho hàm. Bạn quên rồi à?"));
 
     ExprPtr literal = parseFunctionTail(token);
 
-    return std::make_unique<LetStatement>(token, std::move(identifier), std::move(literal));
+    return make<LetStatement>(token, std::move(identifier), std::move(literal));
 }
 
 StmtPtr Parser::classDeclaration(Token token) {
-    IdenPtr name = std::make_unique<Identifier>(consume(IDENTIFIER, "Khi định nghĩa class thì chắc chắn là cần một cái tên!"));
+    IdenPtr name = make<Identifier>(consume(IDENTIFIER, "Khi định nghĩa class thì chắc chắn là cần một cái tên!"));
     IdenPtr superclass = nullptr;
 
     if (match({PUNCT_COLON})) {
-        superclass = std::make_unique<Identifier>(consume(IDENTIFIER, "Bạn dùng dấu hai chấm ':' nhưng lại không ghi tên class cha ngay sau đấy!"));
+        superclass = make<Identifier>(consume(IDENTIFIER, "Bạn dùng dấu hai chấm ':' nhưng lại không ghi tên class cha ngay sau đấy!"));
     }
 
     consume(PUNCT_LBRACE, "Class thì không phải if/else hay while đâu nên thêm dấu ngoặc nhọn '{' cho thân class đi!");
@@ -49,7 +49,7 @@ StmtPtr Parser::classDeclaration(Token token) {
     }
     consume(PUNCT_RBRACE, "Chịu rồi bạn, thiếu '}' sau class");
 
-    return make_unique<ClassStatement>(token, std::move(name), std::move(superclass), std::move(methods), std::move(static_fields));
+    return make<ClassStatement>(token, std::move(name), std::move(superclass), std::move(methods), std::move(static_fields));
 }
 
 StmtPtr Parser::ifStatement(Token token) {
@@ -62,14 +62,14 @@ StmtPtr Parser::ifStatement(Token token) {
     if (match({KEYWORD_ELSE})) {
         elseBranch = statement();
     }
-    return std::make_unique<IfStatement>(token, std::move(condition), std::move(thenBranch), std::move(elseBranch));
+    return make<IfStatement>(token, std::move(condition), std::move(thenBranch), std::move(elseBranch));
 }
 
 StmtPtr Parser::whileStatement(Token token) {
     auto condition = expression();
     StmtPtr body = statement();
 
-    return std::make_unique<WhileStatement>(token, std::move(condition), std::move(body));
+    return make<WhileStatement>(token, std::move(condition), std::move(body));
 }
 
 StmtPtr Parser::forStatement(Token token) {
@@ -78,7 +78,7 @@ StmtPtr Parser::forStatement(Token token) {
     bool isForIn = (peek().type == IDENTIFIER && (next().type == KEYWORD_IN || next().type == PUNCT_COLON));
 
     if (isForIn) {
-        IdenPtr variable = std::make_unique<Identifier>(advance());
+        IdenPtr variable = make<Identifier>(advance());
         if (!match({KEYWORD_IN, PUNCT_COLON})) {
             throw Diagnostic::ParseErr("Thiếu 'in' hoặc ':' khi lặp qua", peek());
         }
@@ -89,7 +89,7 @@ StmtPtr Parser::forStatement(Token token) {
             match({PUNCT_RPAREN});
         }
         StmtPtr body = statement();
-        return std::make_unique<ForInStatement>(token, std::move(variable), std::move(collection), std::move(body));
+        return make<ForInStatement>(token, std::move(variable), std::move(collection), std::move(body));
     }
 
     StmtPtr init = nullptr;
@@ -111,7 +111,7 @@ StmtPtr Parser::forStatement(Token token) {
         match({PUNCT_RPAREN});
     }
     StmtPtr body = statement();
-    return std::make_unique<ForStatement>(token,std::move(init), std::move(condition), std::move(update), std::move(body));
+    return make<ForStatement>(token,std::move(init), std::move(condition), std::move(update), std::move(body));
 }
 
 StmtPtr Parser::returnStatement(Token token) {
@@ -123,21 +123,21 @@ StmtPtr Parser::returnStatement(Token token) {
 
     consume(PUNCT_SEMICOLON, "Cần một dấu chấm phẩy ';' ở đây nhá bạn!");
 
-    return std::make_unique<ReturnStatement>(token, std::move(value));
+    return make<ReturnStatement>(token, std::move(value));
 }
 
 StmtPtr Parser::breakStatement(Token token) {
     consume(PUNCT_SEMICOLON, "Cần một dấu chấm phẩy ';' ở đây nhá bạn!");
-    return std::make_unique<BreakStatement>(token);
+    return make<BreakStatement>(token);
 }
 
 StmtPtr Parser::continueStatement(Token token) {
     consume(PUNCT_SEMICOLON, "Cần một dấu chấm phẩy ';' ở đây nhá bạn!");
-    return std::make_unique<ContinueStatement>(token);
+    return make<ContinueStatement>(token);
 }
 
 StmtPtr Parser::blockStatement(Token token) {
-    auto block = std::make_unique<BlockStatement>(token);
+    auto block = make<BlockStatement>(token);
 
     while (!check(PUNCT_RBRACE) && !isAtEnd()) {
         auto decl = declaration();
@@ -158,7 +158,7 @@ StmtPtr Parser::throwStatement(Token token) {
 
     consume(PUNCT_SEMICOLON, "Cần một dấu chấm phẩy ';' ở đây nhá bạn!");
 
-    return std::make_unique<ThrowStatement>(token, std::move(args));
+    return make<ThrowStatement>(token, std::move(args));
 }
 
 StmtPtr Parser::tryStatement(Token token) {
@@ -166,12 +166,12 @@ StmtPtr Parser::tryStatement(Token token) {
 
     consume(KEYWORD_CATCH, "Có 'try' mà không có 'catch'?");
     consume(PUNCT_LPAREN, "Thiếu dấu ngoặc đơn trái '(' rồi");
-    IdenPtr catchVar = std::make_unique<Identifier>(consume(IDENTIFIER, "Bạn cần bắt thứ gì? Tên nó là gì?"));
+    IdenPtr catchVar = make<Identifier>(consume(IDENTIFIER, "Bạn cần bắt thứ gì? Tên nó là gì?"));
     consume(PUNCT_RPAREN, "Thiếu dầu ngoặc đơn phải ')'.");
 
     StmtPtr catchBlock = statement();
 
-    return make_unique<TryStatement>(token, std::move(tryBlock), std::move(catchVar), std::move(catchBlock));
+    return make<TryStatement>(token, std::move(tryBlock), std::move(catchVar), std::move(catchBlock));
 }
 
 StmtPtr Parser::importStatement(Token token) {
@@ -183,7 +183,7 @@ StmtPtr Parser::importStatement(Token token) {
     if (match({PUNCT_LBRACE})) {
         while (!check(PUNCT_RBRACE) && !isAtEnd()) {
             do {
-                namedImports.push_back(std::make_unique<Identifier>(consume(IDENTIFIER, "Cần tên định danh trong danh sách import.")));
+                namedImports.push_back(make<Identifier>(consume(IDENTIFIER, "Cần tên định danh trong danh sách import.")));
             } while (match({PUNCT_COMMA}));
         }
         consume(PUNCT_RBRACE, "Thiếu ngoặc nhọn '}' để đóng danh sách import.");
@@ -192,12 +192,12 @@ StmtPtr Parser::importStatement(Token token) {
 
     } else if (match({OP_MULTIPLY})) {
         consume(KEYWORD_AS, "Thiếu từ khóa 'as' sau '*'.");
-        namespaceImport = std::make_unique<Identifier>(consume(IDENTIFIER, "Cần một tên namespace sau 'as'."));
+        namespaceImport = make<Identifier>(consume(IDENTIFIER, "Cần một tên namespace sau 'as'."));
         consume(KEYWORD_FROM, "Thiếu từ khóa 'from' sau tên namespace.");
         path = expression();
 
         if (match({KEYWORD_AS})) {
-            namespaceImport = std::make_unique<Identifier>(consume(IDENTIFIER, "Cần một tên namespace sau 'as'."));
+            namespaceImport = make<Identifier>(consume(IDENTIFIER, "Cần một tên namespace sau 'as'."));
             consume(KEYWORD_FROM, "Thiếu từ khóa 'from' sau tên namespace.");
             path = expression();
         } else if (match({KEYWORD_FROM})) {
@@ -212,26 +212,26 @@ StmtPtr Parser::importStatement(Token token) {
 
     consume(PUNCT_SEMICOLON, "Thiếu dấu ';' cuối câu lệnh import.");
     
-    return std::make_unique<ImportStatement>(token, std::move(path), std::move(namedImports), std::move(namespaceImport), importAll);
+    return make<ImportStatement>(token, std::move(path), std::move(namedImports), std::move(namespaceImport), importAll);
 }
 
 StmtPtr Parser::exportStatement(Token token) {
     StmtPtr decl;
     if (check(KEYWORD_LET) || check(KEYWORD_CONST) || check(KEYWORD_FUNCTION) || check(KEYWORD_CLASS)) {
         decl = declaration();
-        return std::make_unique<ExportStatement>(token, std::move(decl), std::vector<IdenPtr>{});
+        return make<ExportStatement>(token, std::move(decl), std::vector<IdenPtr>{});
     } else if (match({PUNCT_LBRACE})) {
         std::vector<IdenPtr> specifiers;
 
         while (!check(PUNCT_RBRACE) && !isAtEnd()) {
             do {
-                specifiers.push_back(std::make_unique<Identifier>(consume(IDENTIFIER, "Cần tên biến trong danh sách export")));
+                specifiers.push_back(make<Identifier>(consume(IDENTIFIER, "Cần tên biến trong danh sách export")));
             } while (match({PUNCT_COMMA}));
         }
         consume(PUNCT_RBRACE, "Thiếu dấu ngoặc nhọn '}' sau danh sách export");
         consume(PUNCT_SEMICOLON, "Thiếu dấu chấm phẩy ';' sau câu lệnh.");
 
-        return std::make_unique<ExportStatement>(token, nullptr, std::move(specifiers));
+        return make<ExportStatement>(token, nullptr, std::move(specifiers));
     }
 
     throw Diagnostic::ParseErr("Đây không phải cú pháp 'export' hợp lệ...", peek());
@@ -240,20 +240,20 @@ StmtPtr Parser::exportStatement(Token token) {
 StmtPtr Parser::expressionStatement(Token token) {
     ExprPtr expr = expression();
     consume(PUNCT_SEMICOLON, "Cần một dấu chấm phẩy ';' ở đây nhá bạn!");
-    return std::make_unique<ExpressionStatement>(token, std::move(expr));
+    return make<ExpressionStatement>(token, std::move(expr));
 }
 
 StmtPtr Parser::logStatement(Token token) {
     ExprPtr expr = expression();
     consume(PUNCT_SEMICOLON, "Cần một dấu chấm phẩy ';' ở đây nhá bạn!");
-    return std::make_unique<LogStatement>(token, std::move(expr));
+    return make<LogStatement>(token, std::move(expr));
 }
 
 StmtPtr Parser::switchStatement(Token token) {
     ExprPtr valueToSwitch = expression();
     consume(PUNCT_LBRACE, "Cần một khối lệnh ngoặc nhọn '{' cho switch.");
 
-    std::vector<std::unique_ptr<SwitchCase>> cases;
+    std::vector<AstPtr<SwitchCase>> cases;
 
     while (!check(PUNCT_RBRACE) && !isAtEnd()) {
         ExprPtr caseValue = nullptr;
@@ -272,12 +272,12 @@ StmtPtr Parser::switchStatement(Token token) {
             statements.push_back(statement());
         }
         
-        cases.push_back(std::make_unique<SwitchCase>(caseToken, std::move(caseValue), std::move(statements)));
+        cases.push_back(make<SwitchCase>(caseToken, std::move(caseValue), std::move(statements)));
     }
 
     consume(PUNCT_RBRACE, "Thiếu '}' để đóng khối lệnh switch.");
 
-    return std::make_unique<SwitchStatement>(token, std::move(valueToSwitch), std::move(cases));
+    return make<SwitchStatement>(token, std::move(valueToSwitch), std::move(cases));
 }
 
 StmtPtr Parser::doWhileStatement(Token token) {
@@ -289,5 +289,5 @@ StmtPtr Parser::doWhileStatement(Token token) {
 
     consume(PUNCT_SEMICOLON, "Thiếu dấu ';' sau câu lệnh do-while.");
 
-    return std::make_unique<DoWhileStatement>(token, std::move(body), std::move(condition));
+    return make<DoWhileStatement>(token, std::move(body), std::move(condition));
 }
\ No newline at end of file
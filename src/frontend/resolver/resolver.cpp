@@ -0,0 +1,372 @@
+#include "resolver/resolver.hpp"
+#include "common/ast.hpp"
+#include <utility>
+
+namespace {
+    const std::string THIS_NAME = "this";
+}
+
+void Resolver::resolve(Program* program) {
+    scopes.clear();
+    references.clear();
+    current = nullptr;
+
+    beginScope(nullptr);
+    resolveStatements(program->body);
+    bindReferences();
+    endScope();
+}
+
+Value Resolver::visit(Program* node) {
+    resolveStatements(node->body);
+    return Value(Null{});
+}
+
+void Resolver::beginScope(ScopeLayout* layout, bool isElidable) {
+    if (layout != nullptr) {
+        layout->names.clear();
+    }
+    scopes.push_back(std::make_unique<Scope>(current, layout));
+    scopes.back()->isElidable = isElidable;
+    current = scopes.back().get();
+}
+
+void Resolver::endScope() {
+    current = current->parent;
+}
+
+void Resolver::resolve(ASTNode* node) {
+    if (node != nullptr) {
+        node->accept(this);
+    }
+}
+
+void Resolver::resolveStatements(const std::vector<StmtPtr>& statements) {
+    for (const auto& stmt : statements) {
+        resolve(stmt.get());
+    }
+}
+
+void Resolver::resolveFunction(FunctionLiteral* function, bool isMethod) {
+    // Môi trường của lời gọi hàm: 'this' (nếu là method), tham số, rest param.
+    // Thân hàm là một câu lệnh riêng nên block của nó sẽ mở thêm một scope nữa.
+    beginScope(&function->scope);
+
+    bool wasInFunction = std::exchange(isInFunction, true);
+    int enclosingTryDepth = std::exchange(tryDepth, 0);
+
+    if (isMethod) {
+        declare(THIS_NAME, nullptr);
+    }
+    for (const auto& param : function->parameters) {
+        declare(param.get());
+    }
+    if (function->restParam) {
+        declare(function->restParam.get());
+    }
+
+    resolve(function->body.get());
+
+    isInFunction = wasInFunction;
+    tryDepth = enclosingTryDepth;
+    endScope();
+}
+
+void Resolver::declare(Identifier* name) {
+    declare(name->name, &name->address);
+}
+
+void Resolver::declare(const std::string& name, LexicalAddress* address) {
+    auto it = current->slots.find(name);
+
+    if (it == current->slots.end()) {
+        int slot = -1;
+        if (current->layout != nullptr) {
+            slot = static_cast<int>(current->layout->size());
+            current->layout->names.push_back(name);
+        }
+        it = current->slots.emplace(name, slot).first;
+    }
+
+    if (address != nullptr) {
+        address->depth = 0;
+        address->slot = it->second;
+    }
+}
+
+void Resolver::reference(const std::string& name, LexicalAddress* address) {
+    references.push_back(Reference{current, &name, address});
+}
+
+void Resolver::bindReferences() {
+    for (const auto& scope : scopes) {
+        if (scope->layout != nullptr) {
+            scope->layout->isElided = scope->isElidable && scope->slots.empty() && !scope->isDynamic;
+        }
+    }
+
+    for (const auto& ref : references) {
+        int depth = 0;
+        Scope* scope = ref.scope;
+
+        while (true) {
+            auto it = scope->slots.find(*ref.name);
+            if (it != scope->slots.end()) {
+                *ref.address = LexicalAddress{depth, it->second};
+                break;
+            }
+            // Scope có import * hoặc scope gốc: tìm theo tên bắt đầu từ đây là đủ,
+            // vì các scope bên dưới chắc chắn không khai báo tên này
+            if (scope->isDynamic || scope->parent == nullptr) {
+                *ref.address = LexicalAddress{depth, -1};
+                break;
+            }
+            if (!scope->layout->isElided) {
+                ++depth;
+            }
+            scope = scope->parent;
+        }
+    }
+}
+
+Value Resolver::visit(IntegerLiteral*) {
+    return Value(Null{});
+}
+Value Resolver::visit(RealLiteral*) {
+    return Value(Null{});
+}
+Value Resolver::visit(StringLiteral*) {
+    return Value(Null{});
+}
+Value Resolver::visit(BooleanLiteral*) {
+    return Value(Null{});
+}
+Value Resolver::visit(NullLiteral*) {
+    return Value(Null{});
+}
+Value Resolver::visit(ArrayLiteral* node) {
+    for (const auto& element : node->elements) {
+        resolve(element.get());
+    }
+    return Value(Null{});
+}
+Value Resolver::visit(ObjectLiteral* node) {
+    for (const auto& pair : node->properties) {
+        resolve(pair.first.get());
+        resolve(pair.second.get());
+    }
+    return Value(Null{});
+}
+Value Resolver::visit(FunctionLiteral* node) {
+    resolveFunction(node, false);
+    return Value(Null{});
+}
+Value Resolver::visit(TemplateLiteral* node) {
+    for (const auto& part : node->parts) {
+        resolve(part.get());
+    }
+    return Value(Null{});
+}
+
+Value Resolver::visit(Identifier* node) {
+    reference(node->name, &node->address);
+    return Value(Null{});
+}
+Value Resolver::visit(BinaryExpression* node) {
+    resolve(node->left.get());
+    resolve(node->right.get());
+    return Value(Null{});
+}
+Value Resolver::visit(UnaryExpression* node) {
+    resolve(node->operand.get());
+    return Value(Null{});
+}
+Value Resolver::visit(CallExpression* node) {
+    resolve(node->callee.get());
+    for (const auto& arg : node->args) {
+        resolve(arg.get());
+    }
+    return Value(Null{});
+}
+Value Resolver::visit(IndexExpression* node) {
+    resolve(node->left.get());
+    resolve(node->index.get());
+    return Value(Null{});
+}
+Value Resolver::visit(AssignmentExpression* node) {
+    resolve(node->target.get());
+    resolve(node->value.get());
+    return Value(Null{});
+}
+Value Resolver::visit(TernaryExpression* node) {
+    resolve(node->condition.get());
+    resolve(node->thenBranch.get());
+    resolve(node->elseBranch.get());
+    return Value(Null{});
+}
+Value Resolver::visit(PropertyAccess* node) {
+    resolve(node->object.get());
+    return Value(Null{});
+}
+Value Resolver::visit(PropertyAssignment* node) {
+    resolve(node->targetObj.get());
+    resolve(node->value.get());
+    return Value(Null{});
+}
+Value Resolver::visit(ThisExpression* node) {
+    reference(THIS_NAME, &node->address);
+    return Value(Null{});
+}
+Value Resolver::visit(SuperExpression*) {
+    return Value(Null{});
+}
+Value Resolver::visit(NewExpression* node) {
+    resolve(node->expression.get());
+    return Value(Null{});
+}
+Value Resolver::visit(PrefixUpdateExpression* node) {
+    resolve(node->operand.get());
+    return Value(Null{});
+}
+Value Resolver::visit(PostfixUpdateExpression* node) {
+    resolve(node->operand.get());
+    return Value(Null{});
+}
+Value Resolver::visit(SpreadExpression* node) {
+    resolve(node->expression.get());
+    return Value(Null{});
+}
+
+Value Resolver::visit(LetStatement* node) {
+    resolve(node->value.get());
+    declare(node->name.get());
+    return Value(Null{});
+}
+Value Resolver::visit(ReturnStatement* node) {
+    // Lời gọi trong try phải chạy xong trước khi rời try để catch còn bắt được lỗi của nó
+    if (node->value != nullptr && node->value->type == EXPR_CALL && isInFunction && tryDepth == 0) {
+        static_cast<CallExpression*>(node->value.get())->isTailCall = true;
+    }
+    resolve(node->value.get());
+    return Value(Null{});
+}
+Value Resolver::visit(BreakStatement*) {
+    return Value(Null{});
+}
+Value Resolver::visit(ContinueStatement*) {
+    return Value(Null{});
+}
+Value Resolver::visit(ThrowStatement* node) {
+    resolve(node->argument.get());
+    return Value(Null{});
+}
+Value Resolver::visit(IfStatement* node) {
+    beginScope(&node->scope, true);
+    resolve(node->condition.get());
+    resolve(node->thenBranch.get());
+    resolve(node->elseBranch.get());
+    endScope();
+    return Value(Null{});
+}
+Value Resolver::visit(WhileStatement* node) {
+    beginScope(&node->scope, true);
+    resolve(node->condition.get());
+    resolve(node->body.get());
+    endScope();
+    return Value(Null{});
+}
+Value Resolver::visit(ForStatement* node) {
+    beginScope(&node->scope, true);
+    resolve(node->init.get());
+    resolve(node->condition.get());
+    resolve(node->body.get());
+    resolve(node->update.get());
+    endScope();
+    return Value(Null{});
+}
+Value Resolver::visit(ForInStatement* node) {
+    beginScope(&node->scope, true);
+    resolve(node->collection.get());
+    declare(node->variable.get());
+    resolve(node->body.get());
+    endScope();
+    return Value(Null{});
+}
+Value Resolver::visit(BlockStatement* node) {
+    beginScope(&node->scope, true);
+    resolveStatements(node->statements);
+    endScope();
+    return Value(Null{});
+}
+Value Resolver::visit(ClassStatement* node) {
+    declare(node->name.get());
+
+    // Method không được khai báo vào scope hiện tại, chúng chỉ đóng gói scope này làm closure
+    for (const auto& methodStmt : node->methods) {
+        auto letStmt = static_cast<LetStatement*>(methodStmt.get());
+        resolveFunction(static_cast<FunctionLiteral*>(letStmt->value.get()), true);
+    }
+
+    for (const auto& field : node->static_fields) {
+        if (auto letStmt = dynamic_cast<LetStatement*>(field.get())) {
+            resolve(letStmt->value.get());
+        } else {
+            resolve(field.get());
+        }
+    }
+    return Value(Null{});
+}
+Value Resolver::visit(ImportStatement* node) {
+    resolve(node->path.get());
+
+    if (node->namespaceImport) {
+        declare(node->namespaceImport.get());
+    } else if (!node->namedImports.empty()) {
+        for (const auto& specifier : node->namedImports) {
+            declare(specifier.get());
+        }
+    } else if (node->importAll) {
+        current->isDynamic = true;
+    }
+    return Value(Null{});
+}
+Value Resolver::visit(ExportStatement* node) {
+    resolve(node->declaration.get());
+    return Value(Null{});
+}
+Value Resolver::visit(TryStatement* node) {
+    ++tryDepth;
+    resolve(node->tryBlock.get());
+
+    beginScope(&node->catchScope);
+    declare(node->catchVariable.get());
+    resolve(node->catchBlock.get());
+    endScope();
+    --tryDepth;
+    return Value(Null{});
+}
+Value Resolver::visit(ExpressionStatement* node) {
+    resolve(node->expression.get());
+    return Value(Null{});
+}
+Value Resolver::visit(LogStatement* node) {
+    resolve(node->expression.get());
+    return Value(Null{});
+}
+Value Resolver::visit(SwitchCase* node) {
+    resolve(node->value.get());
+    resolveStatements(node->statements);
+    return Value(Null{});
+}
+Value Resolver::visit(SwitchStatement* node) {
+    resolve(node->value.get());
+    for (const auto& switchCase : node->cases) {
+        resolve(switchCase.get());
+    }
+    return Value(Null{});
+}
+Value Resolver::visit(DoWhileStatement* node) {
+    resolve(node->body.get());
+    resolve(node->condition.get());
+    return Value(Null{});
+}
@@ -5,6 +5,7 @@
 #include "module/module_manager.hpp"
 #include <memory>
 #include <iostream>
+#include <string>
 
 int main(int argc, char* argv[]) {
     setConsoleOutput();
@@ -13,13 +14,33 @@ int main(int argc, char* argv[]) {
         std::cerr << "Cần ít nhất 2 tham số!";
         return 1;
     }
+    // File script là tham số đầu tiên không phải tùy chọn (-I path, --backend=vm, ...)
+    std::string scriptPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-I" || arg == "--include") {
+            ++i;
+            continue;
+        }
+        if (arg.rfind("-", 0) == 0) {
+            continue;
+        }
+        scriptPath = arg;
+        break;
+    }
+
+    if (scriptPath.empty()) {
+        std::cerr << "Cần đường dẫn tới file script!";
+        return 1;
+    }
+
     ModuleManager manager(argc, argv);
     
     try {
-        manager.load("", argv[1]);
+        manager.load("", scriptPath);
     } catch (const Diagnostic& e) {
         std::cerr << e.str() << "\n";
     } catch (const std::runtime_error& e) {
         std::cerr << "Lỗi runtime không xác định: " << e.what() << "\n";
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
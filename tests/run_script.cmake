@@ -0,0 +1,29 @@
+# Chạy một script bằng meow-alpha rồi so output với file kết quả mong đợi, khác một chữ là test hỏng.
+# meow-alpha luôn thoát với mã 0 kể cả khi script lỗi, nên chỉ output mới cho biết script chạy đúng hay sai.
+#   cmake -DMEOW=<meow-alpha> -DSCRIPT=<file .meow> -DEXPECTED=<file> -DFLAGS="<cờ> <cờ>" -P run_script.cmake
+# Output gồm stdout rồi tới stderr, bỏ mã màu ANSI và thư mục gốc của repo để file kết quả không phụ thuộc máy,
+# bỏ cả dòng [DEBUG] mà tree walker in ra khi lỗi đi qua lời gọi hàm.
+
+separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+cmake_path(GET SCRIPT PARENT_PATH scriptDirectory)
+cmake_path(GET scriptDirectory PARENT_PATH sourceDirectory)
+cmake_path(RELATIVE_PATH SCRIPT BASE_DIRECTORY "${sourceDirectory}" OUTPUT_VARIABLE relativeScript)
+
+execute_process(
+    COMMAND "${MEOW}" ${flags} "${relativeScript}"
+    WORKING_DIRECTORY "${sourceDirectory}"
+    OUTPUT_VARIABLE stdout
+    ERROR_VARIABLE stderr
+    RESULT_VARIABLE exitCode
+)
+
+string(ASCII 27 escape)
+set(actual "${stdout}${stderr}")
+string(REGEX REPLACE "${escape}\\[[0-9;]*m" "" actual "${actual}")
+string(REPLACE "${sourceDirectory}/" "" actual "${actual}")
+string(REGEX REPLACE "\\[DEBUG\\][^\n]*\n" "" actual "${actual}")
+
+file(READ "${EXPECTED}" expected)
+if (NOT exitCode EQUAL 0 OR NOT actual STREQUAL expected)
+    message(FATAL_ERROR "meow-alpha ${FLAGS} ${relativeScript} (mã thoát ${exitCode}) in ra:\n${actual}\nnhưng ${EXPECTED} là:\n${expected}")
+endif()